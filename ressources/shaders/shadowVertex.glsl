@@ -1,10 +1,33 @@
 #version 460 core
-layout (location = 0) in vec3 aPos;
+// Chunk mesh quads, as in vertex.glsl
+layout (std430, binding = 0) readonly buffer ChunkQuads
+{
+    uvec4 quads[];
+};
+
+// World position of each drawn mesh's chunk, one per indirect command
+layout (std430, binding = 1) readonly buffer ChunkOrigins
+{
+    vec4 origins[];
+};
 
 uniform mat4 lightSpaceMatrix;
-uniform mat4 model;
 
 void main()
 {
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    uvec4 quad = quads[uint(gl_VertexID) >> 2];
+    uint corner = uint(gl_VertexID) & 3u;
+    uint normalIdx = (quad.x >> 19) & 0x7u;
+    if ((normalIdx & 1u) == 1u && (corner & 1u) == 1u)
+        corner ^= 2u;
+
+    int d = int(normalIdx >> 1);
+    int u = (d + 1) % 3;
+    int v = (d + 2) % 3;
+    vec3 localPos = vec3(float(quad.x & 0x1Fu), float((quad.x >> 5) & 0x1FFu), float((quad.x >> 14) & 0x1Fu));
+    if (corner == 1u || corner == 2u)
+        localPos[u] += float(((quad.y >> 16) & 0xFFu) + 1u);
+    if (corner >= 2u)
+        localPos[v] += float((quad.y >> 24) + 1u);
+    gl_Position = lightSpaceMatrix * vec4(origins[gl_DrawID].xyz + localPos, 1.0);
 }
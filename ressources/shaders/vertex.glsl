@@ -1,8 +1,20 @@
 #version 460 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in uint aPackedData;
-layout (location = 2) in vec2 aTexCoord;
-layout (location = 3) in uint aPackedBiomeColor;
+// Every chunk mesh quad (ChunkQuad) in the MeshArena, expanded here: vertex
+// gl_VertexID (the draw's base vertex included) is corner gl_VertexID % 4 of
+// quad gl_VertexID / 4
+// x: 0-4 x, 5-13 y, 14-18 z of corner 0, 19-21 normal, 22-29 AO of corners 0-3
+// y: 0-7 textureIndex, 8 useBiomeColor, 16-23 size along U - 1, 24-31 size along V - 1
+// z, w: biome colors (RGB565) of corners 0 and 1, then 2 and 3
+layout (std430, binding = 0) readonly buffer ChunkQuads
+{
+    uvec4 quads[];
+};
+
+// World position of each drawn mesh's chunk, one per indirect command
+layout (std430, binding = 1) readonly buffer ChunkOrigins
+{
+    vec4 origins[];
+};
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -13,7 +25,6 @@ out vec3 BiomeColor;
 out float AO;
 out vec4 FragPosLightSpace;
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 uniform mat4 lightSpaceMatrix;
@@ -29,28 +40,53 @@ const vec3 NORMALS[6] = vec3[](
 
 void main()
 {
-    FragPos = aPos;
-    
+    uvec4 quad = quads[uint(gl_VertexID) >> 2];
+    uint corner = uint(gl_VertexID) & 3u;
+
     // Unpack normal
-    uint normalIdx = aPackedData & 0x7u;
+    uint normalIdx = (quad.x >> 19) & 0x7u;
     Normal = NORMALS[normalIdx];
-    
+
+    // Every quad shares the index pattern 0, 1, 2, 0, 2, 3: negative faces
+    // swap corners 1 and 3 to wind the other way
+    if ((normalIdx & 1u) == 1u && (corner & 1u) == 1u)
+        corner ^= 2u;
+
+    // Corner position: start, + U, + U + V, + V along the face's axes
+    int d = int(normalIdx >> 1);
+    int u = (d + 1) % 3;
+    int v = (d + 2) % 3;
+    vec3 localPos = vec3(float(quad.x & 0x1Fu), float((quad.x >> 5) & 0x1FFu), float((quad.x >> 14) & 0x1Fu));
+    if (corner == 1u || corner == 2u)
+        localPos[u] += float(((quad.y >> 16) & 0xFFu) + 1u);
+    if (corner >= 2u)
+        localPos[v] += float((quad.y >> 24) + 1u);
+    FragPos = origins[gl_DrawID].xyz + localPos;
+
     // Unpack texture index
-    TextureIndex = float((aPackedData >> 3) & 0xFFu);
-    
+    TextureIndex = float(quad.y & 0xFFu);
+
     // Unpack biome flag
-    UseBiomeColor = float((aPackedData >> 11) & 0x1u);
+    UseBiomeColor = float((quad.y >> 8) & 0x1u);
 
     // Unpack AO
-    AO = float((aPackedData >> 12) & 0x3u) / 3.0;
-    
+    AO = float((quad.x >> (22u + 2u * corner)) & 0x3u) / 3.0;
+
     // Unpack biome color
-    float r = float(aPackedBiomeColor & 0xFFu) / 255.0;
-    float g = float((aPackedBiomeColor >> 8) & 0xFFu) / 255.0;
-    float b = float((aPackedBiomeColor >> 16) & 0xFFu) / 255.0;
+    uint color = ((corner < 2u ? quad.z : quad.w) >> (16u * (corner & 1u))) & 0xFFFFu;
+    float r = float((color >> 11) & 0x1Fu) / 31.0;
+    float g = float((color >> 5) & 0x3Fu) / 63.0;
+    float b = float(color & 0x1Fu) / 31.0;
     BiomeColor = vec3(r, g, b);
 
-    TexCoord = aTexCoord;
+    // Texture coordinates follow the face's axes: Z then Y on X faces, X then Z
+    // on Y faces, X then Y on Z faces. They tile across merged quads (GL_REPEAT)
+    if (normalIdx < 2u)
+        TexCoord = localPos.zy;
+    else if (normalIdx < 4u)
+        TexCoord = localPos.xz;
+    else
+        TexCoord = localPos.xy;
 
     FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
     gl_Position = projection * view * vec4(FragPos, 1.0);
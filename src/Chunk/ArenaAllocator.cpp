@@ -0,0 +1,73 @@
+#include "ArenaAllocator.hpp"
+
+#include <iterator>
+
+ArenaAllocator::ArenaAllocator(uint32_t capacity)
+{
+	grow(capacity);
+}
+
+uint32_t ArenaAllocator::allocate(uint32_t size)
+{
+	if (size == 0)
+		return INVALID;
+	auto fit = m_bySize.lower_bound({size, 0});
+	if (fit == m_bySize.end())
+		return INVALID;
+
+	const auto [blockSize, offset] = *fit;
+	eraseFree(m_byOffset.find(offset));
+	if (blockSize > size)
+		insertFree(offset + size, blockSize - size);
+	m_used += size;
+	return offset;
+}
+
+void ArenaAllocator::free(uint32_t offset, uint32_t size)
+{
+	if (size == 0)
+		return;
+	m_used -= size;
+
+	auto next = m_byOffset.lower_bound(offset);
+	if (next != m_byOffset.begin())
+	{
+		auto prev = std::prev(next);
+		if (prev->first + prev->second == offset)
+		{
+			offset = prev->first;
+			size += prev->second;
+			eraseFree(prev);
+		}
+	}
+	if (next != m_byOffset.end() && offset + size == next->first)
+	{
+		size += next->second;
+		eraseFree(next);
+	}
+	insertFree(offset, size);
+}
+
+void ArenaAllocator::grow(uint32_t newCapacity)
+{
+	if (newCapacity <= m_capacity)
+		return;
+	const uint32_t added = newCapacity - m_capacity;
+	const uint32_t offset = m_capacity;
+	m_capacity = newCapacity;
+	// The new units go through free() to merge with a free block at the old end
+	m_used += added;
+	free(offset, added);
+}
+
+void ArenaAllocator::insertFree(uint32_t offset, uint32_t size)
+{
+	m_byOffset.emplace(offset, size);
+	m_bySize.emplace(size, offset);
+}
+
+void ArenaAllocator::eraseFree(std::map<uint32_t, uint32_t>::iterator it)
+{
+	m_bySize.erase({it->second, it->first});
+	m_byOffset.erase(it);
+}
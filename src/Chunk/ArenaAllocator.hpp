@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+
+/// Free-list sub-allocator over the units [0, capacity) of one buffer. It
+/// only does the bookkeeping; MeshArena owns the GPU buffer it describes.
+///
+/// Free blocks are kept twice, by offset (to merge a freed block with its
+/// neighbours) and by size (best fit: the smallest block that is large
+/// enough, lowest offset first, so long runs stay whole).
+class ArenaAllocator
+{
+public:
+	static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+	explicit ArenaAllocator(uint32_t capacity = 0);
+
+	/// Offset of `size` (> 0) free units, or INVALID if no free block is that large
+	uint32_t allocate(uint32_t size);
+	/// Returns a block from allocate(); it merges with adjacent free blocks
+	void free(uint32_t offset, uint32_t size);
+	/// Extends the arena to newCapacity units; the new units are free
+	void grow(uint32_t newCapacity);
+
+	uint32_t capacity() const { return m_capacity; }
+	uint32_t used() const { return m_used; }
+	size_t freeBlockCount() const { return m_byOffset.size(); }
+	uint32_t largestFreeBlock() const { return m_bySize.empty() ? 0 : m_bySize.rbegin()->first; }
+
+private:
+	void insertFree(uint32_t offset, uint32_t size);
+	void eraseFree(std::map<uint32_t, uint32_t>::iterator it);
+
+	uint32_t m_capacity = 0;
+	uint32_t m_used = 0;
+	std::map<uint32_t, uint32_t> m_byOffset;		  // Free blocks: offset -> size
+	std::set<std::pair<uint32_t, uint32_t>> m_bySize; // Free blocks: (size, offset)
+};
@@ -0,0 +1,59 @@
+#include "BiomeAtlas.hpp"
+#include <algorithm>
+
+// 1 MB of tiles, i.e. a 4096 x 4096 block area: enough for the biome map at
+// its widest zoom plus the player's surroundings.
+static constexpr size_t DEFAULT_CAPACITY = 256;
+
+BiomeAtlas::BiomeAtlas(size_t capacity)
+	: m_capacity(std::max<size_t>(1, capacity))
+{
+}
+
+BiomeAtlas &BiomeAtlas::instance()
+{
+	static BiomeAtlas atlas(DEFAULT_CAPACITY);
+	return atlas;
+}
+
+std::shared_ptr<const BiomeAtlas::Tile> BiomeAtlas::find(int seed, int tileX, int tileZ)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_entries.find(Key{seed, tileX, tileZ});
+	if (it == m_entries.end())
+		return nullptr;
+
+	m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+	return it->second.tile;
+}
+
+void BiomeAtlas::store(int seed, int tileX, int tileZ, std::shared_ptr<const Tile> tile)
+{
+	const Key key{seed, tileX, tileZ};
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_entries.count(key))
+		return;
+
+	m_lru.push_front(key);
+	m_entries.emplace(key, Entry{std::move(tile), m_lru.begin()});
+
+	while (m_entries.size() > m_capacity)
+	{
+		m_entries.erase(m_lru.back());
+		m_lru.pop_back();
+	}
+}
+
+void BiomeAtlas::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_lru.clear();
+}
+
+size_t BiomeAtlas::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
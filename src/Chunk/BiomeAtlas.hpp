@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <utils.hpp>
+
+/// Quarter-resolution biome map, filled lazily one tile at a time.
+///
+/// getBiomeAt() and the UI biome map used to evaluate all eight climate/terrain
+/// noise layers for every query. The atlas samples them once per
+/// CELL_SIZE x CELL_SIZE block cell, TILE_CELLS x TILE_CELLS cells per tile, and
+/// keeps the most recently used tiles. Queries resolve to the nearest cell.
+///
+/// A chunk's biomes do not come from it: they come from the chunk's own
+/// full-resolution, eroded noise, which the atlas only approximates. Chunk
+/// generation only reads it where an approximation is enough, such as the
+/// blurred grass and foliage colours (BiomeColorGrid).
+class BiomeAtlas
+{
+public:
+	static constexpr int CELL_SIZE = 4;	  // World blocks per cell side
+	static constexpr int TILE_CELLS = 64; // Cells per tile side
+	static constexpr int TILE_BLOCKS = CELL_SIZE * TILE_CELLS;
+
+	/// BiomeType per cell, row-major (z, then x)
+	using Tile = std::array<uint8_t, TILE_CELLS * TILE_CELLS>;
+
+	/// @param capacity Maximum number of tiles kept (4 KB each).
+	explicit BiomeAtlas(size_t capacity);
+
+	// Non-copyable, non-movable
+	BiomeAtlas(const BiomeAtlas &) = delete;
+	BiomeAtlas &operator=(const BiomeAtlas &) = delete;
+
+	/// Process-wide atlas shared by every TerrainGenerator (keyed by seed).
+	static BiomeAtlas &instance();
+
+	/// Marks the tile as most recently used. Null if it was never stored or got evicted.
+	std::shared_ptr<const Tile> find(int seed, int tileX, int tileZ);
+	/// Keeps an existing entry if another thread stored the same tile first.
+	void store(int seed, int tileX, int tileZ, std::shared_ptr<const Tile> tile);
+
+	void clear();
+
+	size_t size() const;
+	size_t capacity() const { return m_capacity; }
+
+private:
+	struct Key
+	{
+		int seed;
+		int tileX;
+		int tileZ;
+
+		bool operator==(const Key &other) const
+		{
+			return seed == other.seed && tileX == other.tileX && tileZ == other.tileZ;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key &key) const
+		{
+			size_t h = std::hash<int>()(key.seed);
+			hash_combine(h, static_cast<uint32_t>(key.tileX));
+			hash_combine(h, static_cast<uint32_t>(key.tileZ));
+			return h;
+		}
+	};
+
+	struct Entry
+	{
+		std::shared_ptr<const Tile> tile;
+		std::list<Key>::iterator lruIt;
+	};
+
+	size_t m_capacity;
+	mutable std::mutex m_mutex;
+	std::unordered_map<Key, Entry, KeyHash> m_entries;
+	std::list<Key> m_lru; // Front is the most recently used
+};
@@ -0,0 +1,144 @@
+#include "BiomeColorField.hpp"
+#include "TerrainGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+uint16_t BiomeColorField::fromRGB(float r, float g, float b)
+{
+	auto channel = [](float value, int maxValue)
+	{
+		return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * maxValue));
+	};
+	return static_cast<uint16_t>((channel(r, 31) << 11) | (channel(g, 63) << 5) | channel(b, 31));
+}
+
+static int floorDivCells(int world)
+{
+	return world >= 0 ? world / BiomeAtlas::CELL_SIZE : -((-world + BiomeAtlas::CELL_SIZE - 1) / BiomeAtlas::CELL_SIZE);
+}
+
+int BiomeColorGrid::inputOrigin(int chunkWorld)
+{
+	return floorDivCells(chunkWorld) - BLUR_RADIUS;
+}
+
+void BiomeColorGrid::build(int seed, int worldX, int worldZ, int chunks, const uint8_t *biomes)
+{
+	// Per-biome colours as planes, so the lookup below is one gather per plane
+	static const std::array<std::array<float, BIOME_COUNT>, PLANES> palette = []
+	{
+		std::array<std::array<float, BIOME_COUNT>, PLANES> table{};
+		for (int b = 0; b < BIOME_COUNT; ++b)
+		{
+			const BiomeConfig &cfg = TerrainGenerator::getBiomeConfig(static_cast<BiomeType>(b));
+			for (int c = 0; c < 3; ++c)
+			{
+				table[c][b] = cfg.grassColor[c];
+				table[3 + c][b] = cfg.foliageColor[c];
+			}
+		}
+		return table;
+	}();
+
+	m_seed = seed;
+	m_worldX = worldX;
+	m_worldZ = worldZ;
+	m_chunks = chunks;
+	m_cellX = floorDivCells(worldX);
+	m_cellZ = floorDivCells(worldZ);
+	// Corners run from the chunks' first column to one past their last, i.e.
+	// up to cell chunks * CELLS_PER_CHUNK, and sample() reads the next cell
+	// too (with a weight of zero for that last corner)
+	m_size = chunks * CELLS_PER_CHUNK + 2;
+
+	const int inSize = inputSize(chunks);
+	const int taps = 2 * BLUR_RADIUS + 1;
+	const float scale = 1.0f / static_cast<float>(taps * taps);
+	m_input.resize(static_cast<size_t>(inSize) * inSize);
+	m_rows.resize(static_cast<size_t>(inSize) * m_size);
+	m_blurred.resize(static_cast<size_t>(PLANES) * m_size * m_size);
+
+	for (int plane = 0; plane < PLANES; ++plane)
+	{
+		const std::array<float, BIOME_COUNT> &colors = palette[plane];
+		for (int i = 0; i < inSize * inSize; ++i)
+			m_input[i] = colors[biomes[i] < BIOME_COUNT ? biomes[i] : 0];
+
+		// Along X: every input row, m_size outputs, one pass per tap
+		for (int z = 0; z < inSize; ++z)
+		{
+			const float *src = m_input.data() + z * inSize;
+			float *dst = m_rows.data() + z * m_size;
+			std::copy_n(src, m_size, dst);
+			for (int k = 1; k < taps; ++k)
+				for (int x = 0; x < m_size; ++x)
+					dst[x] += src[x + k];
+		}
+
+		// Along Z, same tap order
+		float *out = m_blurred.data() + static_cast<size_t>(plane) * m_size * m_size;
+		for (int z = 0; z < m_size; ++z)
+		{
+			float *dst = out + z * m_size;
+			std::copy_n(m_rows.data() + z * m_size, m_size, dst);
+			for (int k = 1; k < taps; ++k)
+			{
+				const float *src = m_rows.data() + (z + k) * m_size;
+				for (int x = 0; x < m_size; ++x)
+					dst[x] += src[x];
+			}
+			for (int x = 0; x < m_size; ++x)
+				dst[x] *= scale;
+		}
+	}
+	m_built = true;
+}
+
+bool BiomeColorGrid::covers(int seed, int worldX, int worldZ) const
+{
+	return m_built && seed == m_seed &&
+		   worldX >= m_worldX && worldX < m_worldX + m_chunks * CHUNK_SIZE &&
+		   worldZ >= m_worldZ && worldZ < m_worldZ + m_chunks * CHUNK_SIZE;
+}
+
+void BiomeColorGrid::sample(int worldX, int worldZ, BiomeColorField &out) const
+{
+	constexpr int SIZE = BiomeColorField::SIZE;
+	constexpr float INV_CELL = 1.0f / BiomeAtlas::CELL_SIZE;
+
+	// Atlas cell c holds the biome at world block c * CELL_SIZE: a corner at
+	// world w mixes cells floor(w / CELL_SIZE) and the next one
+	std::array<int, SIZE> cellX;
+	std::array<int, SIZE> cellZ;
+	std::array<float, SIZE> weightX;
+	std::array<float, SIZE> weightZ;
+	for (int i = 0; i < SIZE; ++i)
+	{
+		const int relX = worldX + i - m_cellX * BiomeAtlas::CELL_SIZE;
+		const int relZ = worldZ + i - m_cellZ * BiomeAtlas::CELL_SIZE;
+		cellX[i] = relX / BiomeAtlas::CELL_SIZE;
+		cellZ[i] = relZ / BiomeAtlas::CELL_SIZE;
+		weightX[i] = static_cast<float>(relX % BiomeAtlas::CELL_SIZE) * INV_CELL;
+		weightZ[i] = static_cast<float>(relZ % BiomeAtlas::CELL_SIZE) * INV_CELL;
+	}
+
+	const size_t planeSize = static_cast<size_t>(m_size) * m_size;
+	for (int z = 0; z < SIZE; ++z)
+	{
+		for (int x = 0; x < SIZE; ++x)
+		{
+			const size_t i00 = static_cast<size_t>(cellZ[z]) * m_size + cellX[x];
+			float rgb[PLANES];
+			for (int plane = 0; plane < PLANES; ++plane)
+			{
+				const float *p = m_blurred.data() + plane * planeSize;
+				const float a = p[i00] + (p[i00 + 1] - p[i00]) * weightX[x];
+				const float b = p[i00 + m_size] + (p[i00 + m_size + 1] - p[i00 + m_size]) * weightX[x];
+				rgb[plane] = a + (b - a) * weightZ[z];
+			}
+			out.grass[z * SIZE + x] = BiomeColorField::fromRGB(rgb[0], rgb[1], rgb[2]);
+			out.foliage[z * SIZE + x] = BiomeColorField::fromRGB(rgb[3], rgb[4], rgb[5]);
+		}
+	}
+}
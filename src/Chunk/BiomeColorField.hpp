@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <Chunk/BiomeAtlas.hpp>
+#include <utils.hpp>
+
+/// Blended grass and foliage colours of one chunk, at its (CHUNK_SIZE + 1)^2
+/// column corners, as RGB565.
+///
+/// Mesh vertices sit on column corners, so each one reads its own colour and
+/// the rasteriser blends across faces. Corners on a chunk edge hold the same
+/// value in both chunks (see BiomeColorGrid), so the blend has no seams.
+struct BiomeColorField
+{
+	static constexpr int SIZE = CHUNK_SIZE + 1;
+
+	std::array<uint16_t, SIZE * SIZE> grass{};
+	std::array<uint16_t, SIZE * SIZE> foliage{};
+
+	/// Corner (x, z), both in [0, CHUNK_SIZE], as packed RGBA8 (alpha = 255)
+	uint32_t grassAt(int x, int z) const { return toRGBA8(grass[z * SIZE + x]); }
+	uint32_t foliageAt(int x, int z) const { return toRGBA8(foliage[z * SIZE + x]); }
+
+	static uint16_t fromRGB(float r, float g, float b);
+	static uint32_t toRGBA8(uint16_t color)
+	{
+		const uint32_t r = (color >> 11) & 0x1F;
+		const uint32_t g = (color >> 5) & 0x3F;
+		const uint32_t b = color & 0x1F;
+		return ((r << 3) | (r >> 2)) | (((g << 2) | (g >> 4)) << 8) | (((b << 3) | (b >> 2)) << 16) | (255u << 24);
+	}
+
+	bool operator==(const BiomeColorField &other) const = default;
+};
+
+/// Biome colours box-blurred over a window of BiomeAtlas cells.
+///
+/// Built once for a block of chunks (one generateRegion() call, or a single
+/// chunk) from the atlas biomes around it, then sampled per chunk. The blur is
+/// separable and runs on float planes, one plain loop per tap, so it
+/// vectorises. A cell's blurred value is summed in the same order whatever the
+/// window, and a corner is a bilinear mix of the cells around its world
+/// position, so chunks agree on their shared corners bit for bit.
+class BiomeColorGrid
+{
+public:
+	static constexpr int BLUR_RADIUS = 2; // Cells averaged on each side, i.e. a 20-block box
+	static constexpr int CELLS_PER_CHUNK = CHUNK_SIZE / BiomeAtlas::CELL_SIZE;
+	static_assert(CHUNK_SIZE % BiomeAtlas::CELL_SIZE == 0, "A chunk must hold whole BiomeAtlas cells");
+
+	/// build() reads the biomes of a square of inputSize(chunks) cells whose
+	/// first cell is (inputOrigin(worldX), inputOrigin(worldZ)), row-major
+	static int inputOrigin(int chunkWorld);
+	static int inputSize(int chunks) { return chunks * CELLS_PER_CHUNK + 2 + 2 * BLUR_RADIUS; }
+
+	/// For chunks x chunks chunks starting at world block (worldX, worldZ)
+	void build(int seed, int worldX, int worldZ, int chunks, const uint8_t *biomes);
+	/// Whether the chunk at world block (worldX, worldZ) of this seed is in the last build()
+	bool covers(int seed, int worldX, int worldZ) const;
+	void sample(int worldX, int worldZ, BiomeColorField &out) const;
+
+private:
+	static constexpr int PLANES = 6; // Grass R, G, B then foliage R, G, B
+
+	bool m_built = false;
+	int m_seed = 0;
+	int m_worldX = 0;
+	int m_worldZ = 0;
+	int m_chunks = 0;
+	int m_cellX = 0; // First blurred cell
+	int m_cellZ = 0;
+	int m_size = 0; // Blurred cells per side
+
+	std::vector<float> m_blurred; // PLANES planes of m_size x m_size
+	std::vector<float> m_input;	  // Scratch: unblurred planes, then one plane blurred along X
+	std::vector<float> m_rows;
+};
@@ -1,143 +1,81 @@
 #include "Chunk.hpp"
+#include "ChunkMesher.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <glm/gtx/hash.hpp>
 #include <utils.hpp>
 #include <vector>
 
-// Packed ABGR water tint colour shared by the full mesh and LOD mesh generators.
-static constexpr uint32_t WATER_COLOR = 0xFF'E6804D;
-
-struct MeshWorkspace
-{
-  std::vector<uint8_t> mask;
-  // I: vertexMap removed — greedy quads never share vertices; direct push is cheaper
-
-  MeshWorkspace()
-  {
-    mask.reserve(CHUNK_HEIGHT * CHUNK_SIZE);
-  }
-};
-
-static thread_local MeshWorkspace s_meshWorkspace;
-
 Chunk::Chunk(const glm::vec3 &position, ChunkState state)
-    : position(position), visible(false), state(state), VAO(0), VBO(0), EBO(0),
-      waterVAO(0), waterVBO(0), waterEBO(0),
-      opaqueIndexCount(0), waterIndexCount(0),
-      voxels(CHUNK_VOLUME),
+    : position(position), visible(false), state(state), meshArena(nullptr),
       neighborShellVoxels(18 * (CHUNK_HEIGHT + 2) * 18,
                           static_cast<uint8_t>(AIR)),
       meshNeedsUpdate(true) {}
 
 Chunk::Chunk(Chunk &&other) noexcept
     : position(std::move(other.position)), visible(other.visible),
-      state(other.state.load()), voxels(std::move(other.voxels)), VAO(other.VAO),
-      VBO(other.VBO), EBO(other.EBO),
-      waterVAO(other.waterVAO), waterVBO(other.waterVBO), waterEBO(other.waterEBO),
-      opaqueIndexCount(other.opaqueIndexCount), waterIndexCount(other.waterIndexCount),
-      meshNeedsUpdate(other.meshNeedsUpdate.load()),
-      activeVoxels(std::move(other.activeVoxels)),
+      state(other.state.load()),
+      meshArena(other.meshArena), opaqueMeshes(other.opaqueMeshes), waterMeshes(other.waterMeshes),
+      waterPlanes(std::move(other.waterPlanes)),
+      sectionMeshes(std::move(other.sectionMeshes)),
+      m_meshedSections(other.m_meshedSections),
+      m_firstVisibleLayer(other.m_firstVisibleLayer),
+      m_lastVisibleLayer(other.m_lastVisibleLayer),
+      m_dirtySections(other.m_dirtySections.load()),
+      sections(std::move(other.sections)),
       neighborShellVoxels(std::move(other.neighborShellVoxels)),
-      biomeGrassColors(other.biomeGrassColors),
-      biomeFoliageColors(other.biomeFoliageColors),
-      vertices(std::move(other.vertices)), indices(std::move(other.indices)),
-      waterVertices(std::move(other.waterVertices)), waterIndices(std::move(other.waterIndices)),
-      m_isLODMesh(other.m_isLODMesh)
+      biomeColors(other.biomeColors),
+      meshNeedsUpdate(other.meshNeedsUpdate.load()),
+      m_isLODMesh(other.m_isLODMesh),
+      m_pendingTerrain(std::move(other.m_pendingTerrain)),
+      m_surface(std::move(other.m_surface)),
+      m_surfaceOnly(other.m_surfaceOnly.load()),
+      m_editQueue(std::move(other.m_editQueue)),
+      m_receivedEdits(std::move(other.m_receivedEdits))
 {
-  other.VAO = 0;
-  other.VBO = 0;
-  other.EBO = 0;
-  other.waterVAO = 0;
-  other.waterVBO = 0;
-  other.waterEBO = 0;
-  other.opaqueIndexCount = 0;
-  other.waterIndexCount = 0;
+  other.meshArena = nullptr;
+  other.opaqueMeshes = {};
+  other.waterMeshes = {};
 }
 Chunk &Chunk::operator=(Chunk &&other) noexcept
 {
   if (this != &other)
   {
-    if (VAO != 0)
-      glDeleteVertexArrays(1, &VAO);
-    if (VBO != 0)
-      glDeleteBuffers(1, &VBO);
-    if (EBO != 0)
-      glDeleteBuffers(1, &EBO);
-    if (waterVAO != 0)
-      glDeleteVertexArrays(1, &waterVAO);
-    if (waterVBO != 0)
-      glDeleteBuffers(1, &waterVBO);
-    if (waterEBO != 0)
-      glDeleteBuffers(1, &waterEBO);
+    releaseMesh();
 
     position = std::move(other.position);
     visible = other.visible;
     state.store(other.state.load());
-    voxels = std::move(other.voxels);
-    activeVoxels = std::move(other.activeVoxels);
+    sections = std::move(other.sections);
     neighborShellVoxels = std::move(other.neighborShellVoxels);
-    biomeGrassColors = other.biomeGrassColors;
-    biomeFoliageColors = other.biomeFoliageColors;
-    vertices = std::move(other.vertices);
-    indices = std::move(other.indices);
-    waterVertices = std::move(other.waterVertices);
-    waterIndices = std::move(other.waterIndices);
-    VAO = other.VAO;
-    VBO = other.VBO;
-    EBO = other.EBO;
-    waterVAO = other.waterVAO;
-    waterVBO = other.waterVBO;
-    waterEBO = other.waterEBO;
-    opaqueIndexCount = other.opaqueIndexCount;
-    waterIndexCount = other.waterIndexCount;
+    biomeColors = other.biomeColors;
+    sectionMeshes = std::move(other.sectionMeshes);
+    m_meshedSections = other.m_meshedSections;
+    m_firstVisibleLayer = other.m_firstVisibleLayer;
+    m_lastVisibleLayer = other.m_lastVisibleLayer;
+    m_dirtySections.store(other.m_dirtySections.load());
+    meshArena = other.meshArena;
+    opaqueMeshes = other.opaqueMeshes;
+    waterMeshes = other.waterMeshes;
+    waterPlanes = std::move(other.waterPlanes);
     meshNeedsUpdate.store(other.meshNeedsUpdate.load());
     m_isLODMesh = other.m_isLODMesh;
-
-    other.VAO = 0;
-    other.VBO = 0;
-    other.EBO = 0;
-    other.waterVAO = 0;
-    other.waterVBO = 0;
-    other.waterEBO = 0;
+    m_pendingTerrain = std::move(other.m_pendingTerrain);
+    m_surface = std::move(other.m_surface);
+    m_surfaceOnly.store(other.m_surfaceOnly.load());
+    m_editQueue = std::move(other.m_editQueue);
+    m_receivedEdits = std::move(other.m_receivedEdits);
+
+    other.meshArena = nullptr;
+    other.opaqueMeshes = {};
+    other.waterMeshes = {};
   }
   return *this;
 }
 
-Chunk::~Chunk()
-{
-  if (VAO != 0)
-  {
-    glDeleteVertexArrays(1, &VAO);
-  }
-  if (VBO != 0)
-  {
-    glDeleteBuffers(1, &VBO);
-  }
-  if (EBO != 0)
-  {
-    glDeleteBuffers(1, &EBO);
-  }
-  if (waterVAO != 0)
-  {
-    glDeleteVertexArrays(1, &waterVAO);
-  }
-  if (waterVBO != 0)
-  {
-    glDeleteBuffers(1, &waterVBO);
-  }
-  if (waterEBO != 0)
-  {
-    glDeleteBuffers(1, &waterEBO);
-  }
-}
-
 const glm::vec3 &Chunk::getPosition() const { return position; }
 
-size_t Chunk::getIndex(uint32_t x, uint32_t y, uint32_t z) const
-{
-  return y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x;
-}
-
 bool Chunk::isVisible() const { return visible; }
 
 void Chunk::setVisible(bool visible) { this->visible = visible; }
@@ -147,20 +85,16 @@ void Chunk::setState(ChunkState state)
   if (state == ChunkState::GENERATED || state == ChunkState::UNLOADED)
   {
     meshNeedsUpdate = true;
+    m_dirtySections = ALL_SECTIONS;
   }
   this->state = state;
 }
 
 ChunkState Chunk::getState() const { return state; }
 
-Voxel &Chunk::getVoxel(uint32_t x, uint32_t y, uint32_t z)
+Voxel Chunk::getVoxel(uint32_t x, uint32_t y, uint32_t z) const
 {
-  return voxels[getIndex(x, y, z)];
-}
-
-const Voxel &Chunk::getVoxel(uint32_t x, uint32_t y, uint32_t z) const
-{
-  return voxels[getIndex(x, y, z)];
+  return Voxel{sections[y / SECTION_SIZE].get(x, y % SECTION_SIZE, z)};
 }
 
 void Chunk::setVoxel(int x, int y, int z, TextureType type)
@@ -168,16 +102,7 @@ void Chunk::setVoxel(int x, int y, int z, TextureType type)
   if (static_cast<uint32_t>(x) < CHUNK_SIZE && static_cast<uint32_t>(y) < CHUNK_HEIGHT &&
       static_cast<uint32_t>(z) < CHUNK_SIZE)
   {
-    size_t index = getIndex(x, y, z);
-    voxels[index].type = static_cast<uint8_t>(type);
-    if (type != AIR)
-    {
-      activeVoxels.set(index);
-    }
-    else
-    {
-      activeVoxels.reset(index);
-    }
+    sections[y / SECTION_SIZE].set(x, y % SECTION_SIZE, z, static_cast<uint8_t>(type));
   }
   else if (x >= -1 && x <= CHUNK_SIZE && y >= -1 && y <= CHUNK_HEIGHT &&
            z >= -1 && z <= CHUNK_SIZE)
@@ -193,7 +118,7 @@ void Chunk::setVoxel(int x, int y, int z, TextureType type)
 
 void Chunk::setVoxels(const std::vector<Voxel> &voxels)
 {
-  this->voxels = voxels;
+  assignSections(sections, voxels.data());
 }
 
 bool Chunk::deleteVoxel(const glm::vec3 &position)
@@ -206,11 +131,10 @@ bool Chunk::deleteVoxel(const glm::vec3 &position)
   if (z < 0)
     z += CHUNK_SIZE;
 
-  if (isVoxelActive(x, y, z))
+  if (!m_surfaceOnly.load() && isVoxelActive(x, y, z))
   {
     setVoxel(x, y, z, AIR);
-    meshNeedsUpdate = true;
-    state = ChunkState::GENERATED;
+    markVoxelDirty(y);
     return true;
   }
   return false;
@@ -226,23 +150,29 @@ bool Chunk::placeVoxel(const glm::vec3 &position, TextureType type)
   if (z < 0)
     z += CHUNK_SIZE;
 
-  if (!isVoxelActive(x, y, z))
+  if (!m_surfaceOnly.load() && !isVoxelActive(x, y, z))
   {
     setVoxel(x, y, z, type);
-    meshNeedsUpdate = true;
-    state = ChunkState::GENERATED;
+    markVoxelDirty(y);
     return true;
   }
   return false;
 }
 
+void Chunk::markVoxelDirty(int y)
+{
+  m_dirtySections.fetch_or(sectionsTouchedBy(y));
+  meshNeedsUpdate = true;
+  if (state.load() == ChunkState::MESHED)
+    state = ChunkState::GENERATED;
+}
+
 bool Chunk::isVoxelActive(int x, int y, int z) const
 {
   if (static_cast<uint32_t>(x) < CHUNK_SIZE && static_cast<uint32_t>(y) < CHUNK_HEIGHT &&
       static_cast<uint32_t>(z) < CHUNK_SIZE)
   {
-    size_t index = getIndex(x, y, z);
-    return activeVoxels.test(index);
+    return getVoxel(x, y, z).type != AIR;
   }
   else if (x >= -1 && x <= CHUNK_SIZE && y >= -1 && y <= CHUNK_HEIGHT &&
            z >= -1 && z <= CHUNK_SIZE)
@@ -258,508 +188,123 @@ bool Chunk::isVoxelActive(int x, int y, int z) const
 
 void Chunk::generateTerrain(TerrainGenerator &generator)
 {
-  if (state.load() != ChunkState::UNLOADED)
+  if (state.load() != ChunkState::UNLOADED && !m_surfaceOnly.load())
     return;
 
-  std::fill(neighborShellVoxels.begin(), neighborShellVoxels.end(),
-            static_cast<uint8_t>(AIR));
-
   // Ensure we use integer coordinates aligned with world grid
   int genX = static_cast<int>(std::round(position.x));
   int genZ = static_cast<int>(std::round(position.z));
 
-  auto chunkData = generator.generateChunk(genX, genZ);
-  setVoxels(chunkData.voxels);
-
-  neighborShellVoxels = chunkData.borderVoxels;
-  biomeGrassColors = chunkData.grassColors;
-  biomeFoliageColors = chunkData.foliageColors;
-
-  // Update bitset for active voxels
-  activeVoxels.reset(); // Clear all bits first
-  for (int i = 0; i < CHUNK_VOLUME; ++i)
-  {
-    if (this->voxels[i].type !=
-        TextureType::AIR)
-    { // Or your equivalent of an air block
-      activeVoxels.set(i);
-    }
-  }
-
-  state = ChunkState::GENERATED;
-  meshNeedsUpdate = true;
+  setPendingTerrain(generator.generateTerrain(genX, genZ));
 }
 
-void Chunk::generateMesh()
+void Chunk::setPendingTerrain(ChunkData &&chunkData)
 {
-  m_isLODMesh = false; // K: mark as full-quality mesh
-  vertices.clear();
-  indices.clear();
-  waterVertices.clear();
-  waterIndices.clear();
-
-  auto &workspace = s_meshWorkspace;
-  uint32_t indexCounter = 0;
-  uint32_t waterIndexCounter = 0;
-
-  // New helper for greedy meshing that checks local voxels and the precomputed
-  // neighbor shell
-  auto getVoxelDataForMeshing = [&](int lx, int ly, int lz) -> TextureType
-  {
-    if (static_cast<uint32_t>(lx) < CHUNK_SIZE && static_cast<uint32_t>(ly) < CHUNK_HEIGHT &&
-        static_cast<uint32_t>(lz) < CHUNK_SIZE)
-    {
-      return static_cast<TextureType>(getVoxel(lx, ly, lz).type);
-    }
-    // Check the neighbor shell for out-of-bounds coordinates relevant to
-    // meshing.
-    if (lx >= -1 && lx <= CHUNK_SIZE && ly >= -1 && ly <= CHUNK_HEIGHT &&
-        lz >= -1 && lz <= CHUNK_SIZE)
-    {
-      if (neighborShellVoxels.empty())
-        return AIR; // shell freed after upload; treat as AIR
-      size_t shellIndex = (ly + 1) * 18 * 18 + (lz + 1) * 18 + (lx + 1);
-      return static_cast<TextureType>(neighborShellVoxels[shellIndex]);
-    }
-    return AIR; // Default to AIR if not in chunk and not in precomputed shell
-  };
-
-  const int dims[] = {CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE};
-
-  // Iterate over dimensions (X, Y, Z)
-  for (int d = 0; d < 3; ++d)
-  {
-    int u = (d + 1) % 3; // First axis in the plane of the face
-    int v = (d + 2) % 3; // Second axis in the plane of the face
+  if (state.load() != ChunkState::UNLOADED && !m_surfaceOnly.load())
+    return;
 
-    glm::ivec3 x = {0, 0, 0}; // Current voxel coordinate during slice iteration
-    glm::ivec3 q = {0, 0,
-                    0}; // Normal direction for the face (points from x to x+q)
-    q[d] = 1;
+  m_pendingTerrain = std::make_unique<ChunkData>(std::move(chunkData));
+  state = ChunkState::TERRAIN;
 
-    // Ensure mask is large enough for the current slice
-    if (workspace.mask.size() < static_cast<size_t>(dims[u] * dims[v]))
-    {
-      workspace.mask.resize(dims[u] * dims[v]);
-    }
+  // Upgrading a surface-only chunk: only once it has left GENERATED, so
+  // nothing takes it for a chunk with voxels in between
+  m_surface.reset();
+  m_surfaceOnly = false;
+}
 
-    // Iterate over each slice of the chunk along dimension 'd'
-    // x[d] ranges from -1 (representing boundary before chunk) to dims[d]-1
-    // (last voxel layer) A face exists between slice x[d] and slice x[d]+1
-    for (x[d] = -1; x[d] < dims[d]; ++x[d])
-    {
-      std::fill(workspace.mask.begin(), workspace.mask.begin() + (dims[u] * dims[v]), 0); // Reset mask for each slice
+void Chunk::generateSurface(TerrainGenerator &generator)
+{
+  if (state.load() != ChunkState::UNLOADED)
+    return;
 
-      // Iterate over the plane (u, v)
-      for (x[u] = 0; x[u] < dims[u]; ++x[u])
-      {
-        for (x[v] = 0; x[v] < dims[v]; ++x[v])
-        {
+  int genX = static_cast<int>(std::round(position.x));
+  int genZ = static_cast<int>(std::round(position.z));
 
-          if (workspace.mask[x[u] * dims[v] + x[v]])
-          {
-            continue; // Already processed this part of the slice
-          }
+  m_surface = std::make_unique<SurfaceData>(generator.generateSurface(genX, genZ));
+  biomeColors = m_surface->colors;
 
-          // Get types of voxels on either side of the potential face
-          // Voxel at x is on one side, voxel at x+q is on the other.
-          // Use the new helper function that checks the neighbor shell
-          TextureType type1 = getVoxelDataForMeshing(x[0], x[1], x[2]);
-          TextureType type2 =
-              getVoxelDataForMeshing(x[0] + q[0], x[1] + q[1], x[2] + q[2]);
-
-          TextureType quad_type = AIR;
-          glm::ivec3 quad_normal_dir = {0, 0, 0};
-          glm::ivec3 quad_origin_voxel_coord = {
-              0, 0, 0}; // Min corner of the voxel this quad's face belongs to
-
-          // Only generate faces for voxels that are inside this chunk.
-          // Border/shell voxels are used solely for occlusion checks — the
-          // neighboring chunk is responsible for rendering its own faces.
-          bool type1InChunk = (x[0] >= 0 && x[0] < CHUNK_SIZE &&
-                               x[1] >= 0 && x[1] < CHUNK_HEIGHT &&
-                               x[2] >= 0 && x[2] < CHUNK_SIZE);
-          glm::ivec3 xq = x + q;
-          bool type2InChunk = (xq[0] >= 0 && xq[0] < CHUNK_SIZE &&
-                               xq[1] >= 0 && xq[1] < CHUNK_HEIGHT &&
-                               xq[2] >= 0 && xq[2] < CHUNK_SIZE);
-
-          if (type1 != AIR && type1InChunk &&
-              (type2 == AIR ||
-               (TextureManager::isTransparent(type2) && type1 != type2)))
-          {
-            // Face belongs to type1, pointing towards type2
-            quad_type = type1;
-            quad_normal_dir = q;
-            quad_origin_voxel_coord = x;
-          }
-          else if (type2 != AIR && type2InChunk &&
-                   (type1 == AIR || (TextureManager::isTransparent(type1) &&
-                                     type1 != type2)))
-          {
-            // Face belongs to type2, pointing towards type1
-            quad_type = type2;
-            quad_normal_dir = {-q[0], -q[1], -q[2]};
-            quad_origin_voxel_coord = xq;
-          }
-          else
-          {
-            continue; // No visible face here, or types are the same opaque.
-          }
+  // Nothing reads voxels or the shell of a surface-only chunk
+  for (ChunkSection &section : sections)
+    section.fill(AIR);
+  std::vector<uint8_t>().swap(neighborShellVoxels);
 
-          if (quad_type == AIR)
-            continue;
+  m_surfaceOnly = true;
+  setState(ChunkState::GENERATED);
+}
 
-          // Check if this block type needs biome color — used to prevent
-          // greedy merging across biome color boundaries
-          bool isBiomeColoredType =
-              (quad_type == GRASS_TOP || quad_type == GRASS_SIDE ||
-               quad_type == OAK_LEAVES);
+std::vector<SpillVoxel> Chunk::decorate(TerrainGenerator &generator)
+{
+  if (state.load() != ChunkState::TERRAIN || !m_pendingTerrain)
+    return {};
 
-          // Precompute the origin quad's biome color for merge comparisons
-          // (water uses a constant color, so it never splits)
-          uint32_t originBiomeColor = 0;
-          if (isBiomeColoredType)
-          {
-            int originColIdx = quad_origin_voxel_coord[2] * CHUNK_SIZE + quad_origin_voxel_coord[0];
-            originBiomeColor = (quad_type == OAK_LEAVES)
-                                   ? biomeFoliageColors[originColIdx]
-                                   : biomeGrassColors[originColIdx];
-          }
+  int genX = static_cast<int>(std::round(position.x));
+  int genZ = static_cast<int>(std::round(position.z));
 
-          // Helper: get the packed biome color for a candidate voxel coordinate
-          auto getCandidateBiomeColor = [&](const glm::ivec3 &coord) -> uint32_t
-          {
-            int colIdx = coord[2] * CHUNK_SIZE + coord[0];
-            return (quad_type == OAK_LEAVES)
-                       ? biomeFoliageColors[colIdx]
-                       : biomeGrassColors[colIdx];
-          };
-
-          // Calculate width (w) of the quad along dimension u
-          int w;
-          for (w = 1; x[u] + w < dims[u]; ++w)
-          {
-            if (workspace.mask[(x[u] + w) * dims[v] + x[v]])
-              break;
-
-            glm::ivec3 next_pos_u_slice = x;
-            next_pos_u_slice[u] +=
-                w; // Next voxel in u-direction in current slice
-
-            // Use the new helper function
-            TextureType check_type1 = getVoxelDataForMeshing(
-                next_pos_u_slice[0], next_pos_u_slice[1], next_pos_u_slice[2]);
-            TextureType check_type2 = getVoxelDataForMeshing(
-                next_pos_u_slice[0] + q[0], next_pos_u_slice[1] + q[1],
-                next_pos_u_slice[2] + q[2]);
-
-            if (quad_normal_dir == q)
-            { // Face is for a block like type1
-              if (check_type1 != quad_type ||
-                  !(check_type2 == AIR ||
-                    (TextureManager::isTransparent(check_type2) &&
-                     check_type1 != check_type2)))
-                break;
-            }
-            else
-            { // Face is for a block like type2
-              if (check_type2 != quad_type ||
-                  !(check_type1 == AIR ||
-                    (TextureManager::isTransparent(check_type1) &&
-                     check_type2 != check_type1)))
-                break;
-            }
-
-            // Prevent merging across biome color boundaries
-            if (isBiomeColoredType)
-            {
-              glm::ivec3 candidateVoxel = (quad_normal_dir == q)
-                                              ? next_pos_u_slice
-                                              : next_pos_u_slice + q;
-              if (getCandidateBiomeColor(candidateVoxel) != originBiomeColor)
-                break;
-            }
-          }
+  generator.decorateChunk(*m_pendingTerrain, genX, genZ);
+  std::vector<SpillVoxel> spill = std::move(m_pendingTerrain->spill);
+  applyTerrain(*m_pendingTerrain);
+  m_pendingTerrain.reset();
+  return spill;
+}
 
-          // Calculate height (h) of the quad along dimension v
-          int h;
-          bool h_break = false;
-          for (h = 1; x[v] + h < dims[v]; ++h)
-          {
-            for (int k = 0; k < w;
-                 ++k)
-            { // Check all cells in the current row of width w
-              if (workspace.mask[(x[u] + k) * dims[v] + (x[v] + h)])
-              {
-                h_break = true;
-                break;
-              }
-
-              glm::ivec3 next_pos_v_slice = x;
-              next_pos_v_slice[u] += k;
-              next_pos_v_slice[v] += h;
-
-              // Use the new helper function
-              TextureType check_type1 = getVoxelDataForMeshing(
-                  next_pos_v_slice[0], next_pos_v_slice[1],
-                  next_pos_v_slice[2]);
-              TextureType check_type2 = getVoxelDataForMeshing(
-                  next_pos_v_slice[0] + q[0], next_pos_v_slice[1] + q[1],
-                  next_pos_v_slice[2] + q[2]);
-
-              if (quad_normal_dir == q)
-              {
-                if (check_type1 != quad_type ||
-                    !(check_type2 == AIR ||
-                      (TextureManager::isTransparent(check_type2) &&
-                       check_type1 != check_type2)))
-                {
-                  h_break = true;
-                  break;
-                }
-              }
-              else
-              {
-                if (check_type2 != quad_type ||
-                    !(check_type1 == AIR ||
-                      (TextureManager::isTransparent(check_type1) &&
-                       check_type2 != check_type1)))
-                {
-                  h_break = true;
-                  break;
-                }
-              }
-
-              // Prevent merging across biome color boundaries
-              if (isBiomeColoredType)
-              {
-                glm::ivec3 candidateVoxel = (quad_normal_dir == q)
-                                                ? next_pos_v_slice
-                                                : next_pos_v_slice + q;
-                if (getCandidateBiomeColor(candidateVoxel) != originBiomeColor)
-                {
-                  h_break = true;
-                  break;
-                }
-              }
-            }
-            if (h_break)
-              break;
-          }
+bool Chunk::applyQueuedEdits()
+{
+  if (state.load() < ChunkState::GENERATED || m_surfaceOnly.load())
+    return false;
 
-          // Add quad to mesh
-          glm::vec3
-              s_coord_float; // Min corner of the quad in local chunk grid space
-          s_coord_float[d] = static_cast<float>(
-              x[d] + 1.0f); // Corrected: Face is always at x[d]+1
-          s_coord_float[u] = static_cast<float>(x[u]);
-          s_coord_float[v] = static_cast<float>(x[v]);
-
-          glm::vec3 quad_width_vec = {0, 0, 0};
-          quad_width_vec[u] = static_cast<float>(w);
-          glm::vec3 quad_height_vec = {0, 0, 0};
-          quad_height_vec[v] = static_cast<float>(h);
-
-          glm::vec3 v0_local = s_coord_float;
-          glm::vec3 v1_local = s_coord_float + quad_width_vec;
-          glm::vec3 v2_local = s_coord_float + quad_width_vec + quad_height_vec;
-          glm::vec3 v3_local = s_coord_float + quad_height_vec;
-
-          // Texture coordinates for tiling
-          // The greedy mesher uses u=(d+1)%3, v=(d+2)%3.
-          // We need consistent texture orientation regardless of face:
-          //   d=0 (±X faces): u=Y, v=Z → swap so tex_u=Z(h), tex_v=Y(w)
-          //   d=1 (±Y faces): u=Z, v=X → swap so tex_u=X(h), tex_v=Z(w)
-          //   d=2 (±Z faces): u=X, v=Y → already correct
-          glm::vec2 tc[4];
-          float tex_w = static_cast<float>(w);
-          float tex_h = static_cast<float>(h);
-
-          bool swapUV = (d == 0 || d == 1);
-          float tc_u = swapUV ? tex_h : tex_w;
-          float tc_v = swapUV ? tex_w : tex_h;
-
-          if (swapUV)
-          {
-            // After swap: vertex 0→(0,0), 1→(0,tc_v), 2→(tc_u,tc_v), 3→(tc_u,0)
-            tc[0] = {0.0f, 0.0f};
-            tc[1] = {0.0f, tc_v};
-            tc[2] = {tc_u, tc_v};
-            tc[3] = {tc_u, 0.0f};
-          }
-          else
-          {
-            tc[0] = {0.0f, 0.0f};
-            tc[1] = {tc_u, 0.0f};
-            tc[2] = {tc_u, tc_v};
-            tc[3] = {0.0f, tc_v};
-          }
+  const size_t first = m_receivedEdits.size();
+  m_editQueue.take(m_receivedEdits);
 
-          // Determine if this block type needs biome-specific coloring
-          bool needsBiomeColoring =
-              (quad_type == GRASS_TOP || quad_type == GRASS_SIDE ||
-               quad_type == OAK_LEAVES || quad_type == WATER);
+  bool changed = false;
+  for (size_t i = first; i < m_receivedEdits.size(); ++i)
+  {
+    const VoxelEdit &edit = m_receivedEdits[i];
+    if (!TerrainGenerator::spillReplaces(getVoxel(edit.x, edit.y, edit.z).type, edit.type))
+      continue;
+    setVoxel(edit.x, edit.y, edit.z, static_cast<TextureType>(edit.type));
+    markVoxelDirty(edit.y);
+    changed = true;
+  }
 
-          float texture_idx_val = static_cast<float>(quad_type);
-          if (quad_type == GRASS_SIDE)
-          {
-            if (quad_normal_dir.y > 0.9f)
-              texture_idx_val = static_cast<float>(GRASS_TOP);
-            else if (quad_normal_dir.y < -0.9f)
-              texture_idx_val = static_cast<float>(DIRT);
-            // else remains GRASS_SIDE
-          }
-          else if (quad_type == OAK_LOG)
-          {
-            if (std::abs(quad_normal_dir.y) > 0.9f)
-              texture_idx_val = static_cast<float>(OAK_LOG_TOP);
-            // else remains OAK_LOG
-          }
+  return changed;
+}
 
-          uint32_t vert_indices[4];
-          glm::vec3 quad_vertices_world[4] = {
-              this->position + v0_local, this->position + v1_local,
-              this->position + v2_local, this->position + v3_local};
-
-          int normalIdx = 0;
-          if (quad_normal_dir.x > 0)
-            normalIdx = 0;
-          else if (quad_normal_dir.x < 0)
-            normalIdx = 1;
-          else if (quad_normal_dir.y > 0)
-            normalIdx = 2;
-          else if (quad_normal_dir.y < 0)
-            normalIdx = 3;
-          else if (quad_normal_dir.z > 0)
-            normalIdx = 4;
-          else if (quad_normal_dir.z < 0)
-            normalIdx = 5;
-
-          uint32_t packedData = (normalIdx & 0x7) |
-                                ((static_cast<uint32_t>(texture_idx_val) & 0xFF) << 3) |
-                                (needsBiomeColoring ? (1 << 11) : 0);
-
-          // Look up precomputed biome color from per-column arrays
-          uint32_t packedColor = 0;
-          if (needsBiomeColoring)
-          {
-            int colIdx = quad_origin_voxel_coord[2] * CHUNK_SIZE + quad_origin_voxel_coord[0];
-            if (quad_type == GRASS_TOP || quad_type == GRASS_SIDE)
-              packedColor = biomeGrassColors[colIdx];
-            else if (quad_type == OAK_LEAVES)
-              packedColor = biomeFoliageColors[colIdx];
-            else if (quad_type == WATER)
-              packedColor = WATER_COLOR;
-          }
+std::vector<VoxelEdit> Chunk::takeReceivedEdits()
+{
+  std::vector<VoxelEdit> edits = std::move(m_receivedEdits);
+  m_receivedEdits.clear();
+  m_editQueue.take(edits);
+  return edits;
+}
 
-          auto calculateAO = [&](const glm::vec3 &localPos, int cornerIdx) -> uint32_t
-          {
-            int pd = (int)std::round(localPos[d]);
-            int pu = (int)std::round(localPos[u]);
-            int pv = (int)std::round(localPos[v]);
-
-            int layerD = (quad_normal_dir[d] > 0) ? pd : pd - 1;
-
-            auto isSolid = [&](int du, int dv)
-            {
-              return !TextureManager::isTransparent(getVoxelDataForMeshing(
-                  (d == 0 ? layerD : (u == 0 ? pu + du : pv + du)),
-                  (d == 1 ? layerD : (u == 1 ? pu + du : pv + du)),
-                  (d == 2 ? layerD : (u == 2 ? pu + du : pv + du))));
-            };
-
-            bool q1 = isSolid(0, 0);
-            bool q2 = isSolid(-1, 0);
-            bool q3 = isSolid(-1, -1);
-            bool q4 = isSolid(0, -1);
-
-            bool s1, s2, c;
-            if (cornerIdx == 0)
-            {
-              s1 = q2;
-              s2 = q4;
-              c = q3;
-            }
-            else if (cornerIdx == 1)
-            {
-              s1 = q1;
-              s2 = q3;
-              c = q4;
-            }
-            else if (cornerIdx == 2)
-            {
-              s1 = q2;
-              s2 = q4;
-              c = q1;
-            }
-            else
-            {
-              s1 = q1;
-              s2 = q3;
-              c = q2;
-            }
-
-            if (s1 && s2)
-              return 0;
-            return 3 - (s1 + s2 + c);
-          };
-
-          // Determine which mesh buffer this quad goes to
-          bool isWater = (quad_type == WATER);
-          auto &targetVertices = isWater ? waterVertices : vertices;
-          auto &targetIndices = isWater ? waterIndices : indices;
-          auto &targetIndexCounter = isWater ? waterIndexCounter : indexCounter;
-
-          for (int i = 0; i < 4; ++i)
-          {
-            Vertex vert;
-            vert.position = quad_vertices_world[i];
+void Chunk::applyTerrain(const ChunkData &chunkData)
+{
+  if (state.load() > ChunkState::TERRAIN)
+    return;
 
-            glm::vec3 localPos = vert.position - this->position;
-            uint32_t ao = calculateAO(localPos, i);
+  setVoxels(chunkData.voxels);
 
-            vert.packedData = packedData | (ao << 12);
-            vert.texCoord = tc[i];
-            vert.packedBiomeColor = packedColor;
+  neighborShellVoxels = chunkData.borderVoxels;
+  biomeColors = chunkData.colors;
 
-            // I: Direct push for both water and opaque — greedy quads never share vertices
-            targetVertices.push_back(vert);
-            vert_indices[i] = targetIndexCounter++;
-          }
+  state = ChunkState::GENERATED;
+  meshNeedsUpdate = true;
+  m_dirtySections = ALL_SECTIONS;
+}
 
-          // Winding order based on normal direction along the main axis 'd'
-          if (quad_normal_dir[d] > 0)
-          {
-            targetIndices.push_back(vert_indices[0]);
-            targetIndices.push_back(vert_indices[1]);
-            targetIndices.push_back(vert_indices[2]);
-            targetIndices.push_back(vert_indices[0]);
-            targetIndices.push_back(vert_indices[2]);
-            targetIndices.push_back(vert_indices[3]);
-          }
-          else
-          {
-            targetIndices.push_back(vert_indices[0]);
-            targetIndices.push_back(vert_indices[2]);
-            targetIndices.push_back(vert_indices[1]);
-            targetIndices.push_back(vert_indices[0]);
-            targetIndices.push_back(vert_indices[3]);
-            targetIndices.push_back(vert_indices[2]);
-          }
+void Chunk::generateMesh()
+{
+  uint32_t dirty = m_dirtySections.exchange(0);
+  if (m_isLODMesh)
+    dirty = ALL_SECTIONS; // Every section holds LOD quads
+  m_isLODMesh = false; // K: mark as full-quality mesh
 
-          // Mark processed cells in the mask
-          for (int iw = 0; iw < w; ++iw)
-          {
-            for (int ih = 0; ih < h; ++ih)
-            {
-              workspace.mask[(x[u] + iw) * dims[v] + (x[v] + ih)] = 1;
-            }
-          }
-        }
-      }
-    }
-  }
+  ChunkMeshInput input{};
+  input.sections = &sections;
+  input.shell = neighborShellVoxels.empty() ? nullptr : neighborShellVoxels.data(); // Freed after upload: all air
+  input.colors = &biomeColors;
+  buildSectionMeshes(input, dirty, sectionMeshes);
+  m_meshedSections |= dirty; // Along with any section still waiting for upload
 
   meshNeedsUpdate = true; // Flag for GPU upload
   state = ChunkState::MESHED;
@@ -770,13 +315,11 @@ void Chunk::generateMesh()
 void Chunk::generateLODMesh()
 {
   m_isLODMesh = true;
-  vertices.clear();
-  indices.clear();
-  waterVertices.clear();
-  waterIndices.clear();
-
-  uint32_t indexCounter = 0;
-  uint32_t waterIndexCounter = 0;
+  for (SectionMesh &mesh : sectionMeshes)
+  {
+    mesh.quads.clear();
+    mesh.waterQuads.clear();
+  }
 
   for (int cx = 0; cx < CHUNK_SIZE; ++cx)
   {
@@ -785,14 +328,25 @@ void Chunk::generateLODMesh()
       // Find topmost non-AIR voxel in this column
       int topY = -1;
       TextureType topType = AIR;
-      for (int cy = CHUNK_HEIGHT - 1; cy >= 0; --cy)
+      if (m_surface)
+      {
+        topY = m_surface->topY[cz * CHUNK_SIZE + cx];
+        topType = static_cast<TextureType>(m_surface->topType[cz * CHUNK_SIZE + cx]);
+      }
+      for (int sy = SECTION_COUNT - 1; !m_surface && topY < 0 && sy >= 0; --sy)
       {
-        TextureType t = static_cast<TextureType>(getVoxel(cx, cy, cz).type);
-        if (t != AIR)
+        const ChunkSection &section = sections[sy];
+        if (section.isEmpty())
+          continue;
+        for (int ly = SECTION_SIZE - 1; ly >= 0; --ly)
         {
-          topY = cy;
-          topType = t;
-          break;
+          TextureType t = static_cast<TextureType>(section.get(cx, ly, cz));
+          if (t != AIR)
+          {
+            topY = sy * SECTION_SIZE + ly;
+            topType = t;
+            break;
+          }
         }
       }
       if (topY < 0)
@@ -809,180 +363,115 @@ void Chunk::generateLODMesh()
 
       bool needsBiomeColoring = (topType == GRASS_TOP || topType == GRASS_SIDE ||
                                  topType == OAK_LEAVES || topType == WATER);
-      int colIdx = cz * CHUNK_SIZE + cx;
-      uint32_t packedColor = 0;
-      if (needsBiomeColoring)
+      const bool leaves = (topType == OAK_LEAVES);
+      const std::array<uint16_t, BiomeColorField::SIZE * BiomeColorField::SIZE> &colors =
+          leaves ? biomeColors.foliage : biomeColors.grass;
+
+      // Top face, corners (cx, cz), (cx, cz + 1), (cx + 1, cz + 1), (cx + 1, cz)
+      // normalIdx=2 (+Y), ao=3 (no occlusion — skip expensive AO for LOD)
+      const int cornerX[4] = {cx, cx, cx + 1, cx + 1};
+      const int cornerZ[4] = {cz, cz + 1, cz + 1, cz};
+      const uint32_t ao[4] = {3, 3, 3, 3};
+      uint16_t cornerColors[4] = {0, 0, 0, 0};
+      for (int i = 0; i < 4; ++i)
       {
-        if (topType == GRASS_TOP || topType == GRASS_SIDE)
-          packedColor = biomeGrassColors[colIdx];
-        else if (topType == OAK_LEAVES)
-          packedColor = biomeFoliageColors[colIdx];
-        else
-          packedColor = WATER_COLOR;
+        if (isWater)
+          cornerColors[i] = WATER_COLOR;
+        else if (needsBiomeColoring)
+          cornerColors[i] = colors[cornerZ[i] * BiomeColorField::SIZE + cornerX[i]];
       }
 
-      // normalIdx=2 (+Y), ao=3 (no occlusion — skip expensive AO for LOD)
-      uint32_t packedData = (2u & 0x7u) |
-                            ((static_cast<uint32_t>(texType) & 0xFFu) << 3) |
-                            (needsBiomeColoring ? (1u << 11) : 0u) |
-                            (3u << 12);
-
-      // Top face vertices in world space; axis mapping: d=1(Y), u=2(Z), v=0(X)
-      float fy = float(topY + 1);
-      float fx = float(cx);
-      float fz = float(cz);
-
-      Vertex v0, v1, v2, v3;
-      v0.position = this->position + glm::vec3(fx, fy, fz);
-      v1.position = this->position + glm::vec3(fx, fy, fz + 1.f);
-      v2.position = this->position + glm::vec3(fx + 1.f, fy, fz + 1.f);
-      v3.position = this->position + glm::vec3(fx + 1.f, fy, fz);
-
-      // swapUV=true (d=1), w=1, h=1 -> tc_u=1, tc_v=1
-      v0.texCoord = {0.f, 0.f};
-      v1.texCoord = {0.f, 1.f};
-      v2.texCoord = {1.f, 1.f};
-      v3.texCoord = {1.f, 0.f};
-
-      v0.packedData = v1.packedData = v2.packedData = v3.packedData = packedData;
-      v0.packedBiomeColor = v1.packedBiomeColor =
-          v2.packedBiomeColor = v3.packedBiomeColor = packedColor;
-
-      auto &tVerts = isWater ? waterVertices : vertices;
-      auto &tIndices = isWater ? waterIndices : indices;
-      auto &cnt = isWater ? waterIndexCounter : indexCounter;
-
-      uint32_t base = cnt;
-      tVerts.push_back(v0);
-      tVerts.push_back(v1);
-      tVerts.push_back(v2);
-      tVerts.push_back(v3);
-      cnt += 4;
-
-      // Winding for +Y normal (quad_normal_dir[d] > 0)
-      tIndices.push_back(base + 0);
-      tIndices.push_back(base + 1);
-      tIndices.push_back(base + 2);
-      tIndices.push_back(base + 0);
-      tIndices.push_back(base + 2);
-      tIndices.push_back(base + 3);
+      // In the section of the layer the quad sits on, so every section is replaced by a later full mesh
+      SectionMesh &mesh = sectionMeshes[std::min(topY + 1, CHUNK_HEIGHT - 1) / SECTION_SIZE];
+      (isWater ? mesh.waterQuads : mesh.quads)
+          .push_back(ChunkQuad::pack(glm::ivec3(cx, topY + 1, cz), 2, ao, 1, 1, texType, needsBiomeColoring, cornerColors));
     }
   }
+  for (SectionMesh &mesh : sectionMeshes)
+    sortWaterQuads(mesh.waterQuads, mesh.waterPlanes);
 
+  m_meshedSections = ALL_SECTIONS;
+  m_dirtySections = 0; // A full mesh replaces it, whatever was edited
   meshNeedsUpdate = true;
   state = ChunkState::MESHED;
 }
 
-// P5: Shared vertex attribute layout — avoids copy-paste divergence
-static void configureVertexAttributes()
+bool Chunk::hasWaterMesh() const
+{
+  return std::any_of(waterMeshes.begin(), waterMeshes.end(),
+                     [](const MeshArena::Range &mesh) { return mesh.count > 0; });
+}
+
+uint32_t Chunk::getMaxQuadCount() const
 {
-  // Position (location = 0)
-  glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                        (void *)offsetof(Vertex, position));
-  // Packed Data (location = 1)
-  glEnableVertexAttribArray(1);
-  glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(Vertex),
-                         (void *)offsetof(Vertex, packedData));
-  // Texture coordinates (location = 2)
-  glEnableVertexAttribArray(2);
-  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                        (void *)offsetof(Vertex, texCoord));
-  // Packed Biome Color (location = 3)
-  glEnableVertexAttribArray(3);
-  glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(Vertex),
-                         (void *)offsetof(Vertex, packedBiomeColor));
+  uint32_t count = 0;
+  for (int section = 0; section < SECTION_COUNT; ++section)
+    count = std::max({count, opaqueMeshes[section].count, waterMeshes[section].count});
+  return count;
 }
 
-void Chunk::uploadToGPU()
+std::pair<int, int> Chunk::getVisibleLayers() const
 {
-  // --- Opaque mesh ---
-  if (VAO == 0)
-    glGenVertexArrays(1, &VAO);
-  if (VBO == 0)
-    glGenBuffers(1, &VBO);
-  if (EBO == 0)
-    glGenBuffers(1, &EBO);
-
-  opaqueIndexCount = static_cast<uint32_t>(indices.size());
-
-  glBindVertexArray(VAO);
-  glBindBuffer(GL_ARRAY_BUFFER, VBO);
-  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex),
-               vertices.data(), GL_STATIC_DRAW);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t),
-               indices.data(), GL_STATIC_DRAW);
-  configureVertexAttributes();
-  glBindVertexArray(0);
-
-  // P2: Free CPU-side data after GPU upload
-  vertices = {};
-  indices = {};
-
-  // --- Water mesh ---
-  waterIndexCount = static_cast<uint32_t>(waterIndices.size());
-
-  if (waterIndexCount > 0)
+  if (state.load() != ChunkState::MESHED || meshNeedsUpdate.load())
+    return {0, CHUNK_HEIGHT};
+  return {m_firstVisibleLayer, m_lastVisibleLayer};
+}
+
+void Chunk::uploadToGPU(MeshArena &arena)
+{
+  meshArena = &arena;
+  for (uint32_t rest = m_meshedSections; rest != 0; rest &= rest - 1)
   {
-    if (waterVAO == 0)
-      glGenVertexArrays(1, &waterVAO);
-    if (waterVBO == 0)
-      glGenBuffers(1, &waterVBO);
-    if (waterEBO == 0)
-      glGenBuffers(1, &waterEBO);
-
-    glBindVertexArray(waterVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, waterVBO);
-    glBufferData(GL_ARRAY_BUFFER, waterVertices.size() * sizeof(Vertex),
-                 waterVertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, waterEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, waterIndices.size() * sizeof(uint32_t),
-                 waterIndices.data(), GL_STATIC_DRAW);
-    configureVertexAttributes();
-    glBindVertexArray(0);
+    const int section = std::countr_zero(rest);
+    SectionMesh &mesh = sectionMeshes[section];
+    arena.release(opaqueMeshes[section]);
+    arena.release(waterMeshes[section]);
+    opaqueMeshes[section] = arena.upload(mesh.quads);
+    waterMeshes[section] = arena.upload(mesh.waterQuads);
+    waterPlanes[section] = std::move(mesh.waterPlanes);
+
+    // P2: Free CPU-side data after GPU upload
+    mesh = {};
   }
+  m_meshedSections = 0;
 
-  // P2: Free CPU-side water data after GPU upload
-  waterVertices = {};
-  waterIndices = {};
+  // A section's quads lie between its bottom layer and the top of its last
+  // layer (a LOD top face is bucketed in the section it sits on)
+  m_firstVisibleLayer = CHUNK_HEIGHT;
+  m_lastVisibleLayer = 0;
+  for (int section = 0; section < SECTION_COUNT; ++section)
+  {
+    if (opaqueMeshes[section].count == 0 && waterMeshes[section].count == 0)
+      continue;
+    m_firstVisibleLayer = std::min(m_firstVisibleLayer, section * SECTION_SIZE);
+    m_lastVisibleLayer = (section + 1) * SECTION_SIZE;
+  }
+
+  // No mesh task reads the voxels while the chunk waits for upload
+  for (ChunkSection &section : sections)
+    section.releaseRetired();
 
   // E: Release neighbor shell memory — only needed during meshing.
   // Lazily reconstructed by ChunkManager before any subsequent remesh.
   freeShellVoxels();
   meshNeedsUpdate = false;
-}
 
-// P1: draw() is now minimal — all shared uniforms set once in drawVisibleChunks
-uint32_t Chunk::draw()
-{
-  if (opaqueIndexCount == 0)
-    return 0;
-
-  glBindVertexArray(VAO);
-  glDrawElements(GL_TRIANGLES, opaqueIndexCount, GL_UNSIGNED_INT, 0);
-
-  return opaqueIndexCount;
-}
-
-uint32_t Chunk::drawWater()
-{
-  if (waterIndexCount == 0)
-    return 0;
-
-  glBindVertexArray(waterVAO);
-  glDrawElements(GL_TRIANGLES, waterIndexCount, GL_UNSIGNED_INT, 0);
-
-  return waterIndexCount;
+  // Edited while the mesh task ran: the new dirty sections are meshed next
+  if (m_dirtySections.load() != 0)
+    state = ChunkState::GENERATED;
 }
 
-void Chunk::drawShadow() const
+void Chunk::releaseMesh()
 {
-  if (opaqueIndexCount == 0 || meshNeedsUpdate.load())
+  if (!meshArena)
     return;
-
-  glBindVertexArray(VAO);
-  glDrawElements(GL_TRIANGLES, opaqueIndexCount, GL_UNSIGNED_INT, 0);
+  for (int section = 0; section < SECTION_COUNT; ++section)
+  {
+    meshArena->release(opaqueMeshes[section]);
+    meshArena->release(waterMeshes[section]);
+    waterPlanes[section].clear();
+  }
+  meshArena = nullptr;
 }
 
 void Chunk::freeShellVoxels()
@@ -991,6 +480,30 @@ void Chunk::freeShellVoxels()
   neighborShellVoxels.shrink_to_fit();
 }
 
+namespace
+{
+  // Copies one face of a neighbour into the shell. `column(section, y, i)`
+  // reads the i-th voxel of the face at layer y of a mixed section; empty
+  // sections are left to the shell's default air and uniform ones are filled.
+  template <typename Column>
+  void copyShellFace(std::vector<uint8_t> &shell, const ChunkSections &sections,
+                     size_t first, size_t stride, Column column)
+  {
+    for (int s = 0; s < SECTION_COUNT; ++s)
+    {
+      const ChunkSection &section = sections[s];
+      if (section.isEmpty())
+        continue;
+      for (int ly = 0; ly < SECTION_SIZE; ++ly)
+      {
+        size_t index = (s * SECTION_SIZE + ly + 1) * 18 * 18 + first;
+        for (int i = 0; i < CHUNK_SIZE; ++i, index += stride)
+          shell[index] = section.isUniform() ? section.fillType() : column(section, ly, i);
+      }
+    }
+  }
+}
+
 void Chunk::rebuildShellFromNeighbors(const Chunk *west, const Chunk *east,
                                       const Chunk *south, const Chunk *north)
 {
@@ -998,39 +511,75 @@ void Chunk::rebuildShellFromNeighbors(const Chunk *west, const Chunk *east,
 
   // West face  (local x = -1,  shell column x = 0):  neighbor's x = CHUNK_SIZE-1
   if (west)
-    for (uint32_t y = 0; y < CHUNK_HEIGHT; ++y)
-      for (uint32_t z = 0; z < CHUNK_SIZE; ++z)
-        neighborShellVoxels[(y + 1) * 18 * 18 + (z + 1) * 18 + 0] =
-            west->getVoxel(CHUNK_SIZE - 1, y, z).type;
+    copyShellFace(neighborShellVoxels, west->sections, 1 * 18 + 0, 18,
+                  [](const ChunkSection &s, int y, int z) { return s.get(CHUNK_SIZE - 1, y, z); });
 
   // East face  (local x = CHUNK_SIZE, shell column x = 17): neighbor's x = 0
   if (east)
-    for (uint32_t y = 0; y < CHUNK_HEIGHT; ++y)
-      for (uint32_t z = 0; z < CHUNK_SIZE; ++z)
-        neighborShellVoxels[(y + 1) * 18 * 18 + (z + 1) * 18 + 17] =
-            east->getVoxel(0, y, z).type;
+    copyShellFace(neighborShellVoxels, east->sections, 1 * 18 + 17, 18,
+                  [](const ChunkSection &s, int y, int z) { return s.get(0, y, z); });
 
   // South face (local z = -1,  shell row z = 0):  neighbor's z = CHUNK_SIZE-1
   if (south)
-    for (uint32_t y = 0; y < CHUNK_HEIGHT; ++y)
-      for (uint32_t x = 0; x < CHUNK_SIZE; ++x)
-        neighborShellVoxels[(y + 1) * 18 * 18 + 0 * 18 + (x + 1)] =
-            south->getVoxel(x, y, CHUNK_SIZE - 1).type;
+    copyShellFace(neighborShellVoxels, south->sections, 0 * 18 + 1, 1,
+                  [](const ChunkSection &s, int y, int x) { return s.get(x, y, CHUNK_SIZE - 1); });
 
   // North face (local z = CHUNK_SIZE, shell row z = 17): neighbor's z = 0
   if (north)
-    for (uint32_t y = 0; y < CHUNK_HEIGHT; ++y)
-      for (uint32_t x = 0; x < CHUNK_SIZE; ++x)
-        neighborShellVoxels[(y + 1) * 18 * 18 + 17 * 18 + (x + 1)] =
-            north->getVoxel(x, y, 0).type;
+    copyShellFace(neighborShellVoxels, north->sections, 17 * 18 + 1, 1,
+                  [](const ChunkSection &s, int y, int x) { return s.get(x, y, 0); });
+}
+
+bool Chunk::canCache() const
+{
+  return state.load() == ChunkState::MESHED && !meshNeedsUpdate.load() && meshArena && !m_isLODMesh &&
+         !m_surfaceOnly.load() && m_dirtySections.load() == 0;
+}
+
+std::unique_ptr<CachedChunk> Chunk::takeCached()
+{
+  // Packed from the uploaded meshes: nothing is kept for it while loaded
+  auto cached = std::make_unique<CachedChunk>();
+  std::vector<ChunkQuad> quads;
+  for (int section = 0; section < SECTION_COUNT; ++section)
+  {
+    meshArena->download(opaqueMeshes[section], quads);
+    packQuads(quads, cached->opaque[section]);
+    meshArena->download(waterMeshes[section], quads);
+    packQuads(quads, cached->water[section]);
+  }
+  cached->sections = std::move(sections);
+  cached->colors = biomeColors;
+  return cached;
+}
+
+void Chunk::restore(CachedChunk &&cached)
+{
+  sections = std::move(cached.sections);
+  biomeColors = cached.colors;
+  for (int section = 0; section < SECTION_COUNT; ++section)
+  {
+    SectionMesh &mesh = sectionMeshes[section];
+    mesh.quads.clear();
+    mesh.waterQuads.clear();
+    unpackQuads(cached.opaque[section], mesh.quads);
+    unpackQuads(cached.water[section], mesh.waterQuads);
+    sortWaterQuads(mesh.waterQuads, mesh.waterPlanes); // Packed in order: only lists the planes
+  }
+
+  // Rebuilt by ChunkManager before the next re-mesh, like after an upload
+  freeShellVoxels();
+  m_isLODMesh = false;
+  m_meshedSections = ALL_SECTIONS;
+  m_dirtySections = 0;
+  meshNeedsUpdate = true;
+  state = ChunkState::MESHED;
 }
 
 void Chunk::reset(const glm::vec3 &newPosition)
 {
-  // Conserver les ressources GPU (VAO, VBO, EBO) pour réutilisation.
-  // Réinitialiser simplement les compteurs de dessin pour ne pas afficher le chunk tant qu'il n'est pas remaillé.
-  opaqueIndexCount = 0;
-  waterIndexCount = 0;
+  // Rendre les maillages à l'arène : le chunk n'est plus dessiné tant qu'il n'est pas remaillé.
+  releaseMesh();
 
   // Reset identity
   position = newPosition;
@@ -1041,23 +590,29 @@ void Chunk::reset(const glm::vec3 &newPosition)
   m_inTransit.store(false);
 
   // Clear buffers but retain capacity for reuse (avoid reallocation)
-  vertices.clear();
-  indices.clear();
-  waterVertices.clear();
-  waterIndices.clear();
-
-  // Reset voxels to AIR (keep vector at CHUNK_VOLUME size)
-  if (voxels.size() != CHUNK_VOLUME)
-    voxels.resize(CHUNK_VOLUME);
-  std::fill(voxels.begin(), voxels.end(), Voxel{static_cast<uint8_t>(AIR)});
+  for (SectionMesh &mesh : sectionMeshes)
+  {
+    mesh.quads.clear();
+    mesh.waterQuads.clear();
+    mesh.waterPlanes.clear();
+  }
+  m_meshedSections = 0;
+  m_dirtySections.store(ALL_SECTIONS);
 
-  activeVoxels.reset();
+  // Reset voxels to AIR: every section gives its storage back
+  for (ChunkSection &section : sections)
+    section.fill(AIR);
 
   // Clear shell — keep capacity for reuse
   neighborShellVoxels.clear();
 
   // Reset biome colors
-  biomeGrassColors.fill(0);
-  biomeFoliageColors.fill(0);
+  biomeColors = BiomeColorField{};
+
+  m_pendingTerrain.reset();
+  m_surface.reset();
+  m_surfaceOnly.store(false);
+  m_editQueue.clear();
+  m_receivedEdits.clear();
 }
 
@@ -9,15 +9,21 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <array>
 #include <atomic>
-#include <bitset>
 #include <thread>
 #include <mutex>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include <glm/gtx/hash.hpp>
 
 #include <chrono>
 
+#include <Chunk/ChunkMesher.hpp>
+#include <Chunk/ChunkSection.hpp>
+#include <Chunk/MeshArena.hpp>
+#include <Chunk/MeshCache.hpp>
 #include <Chunk/TerrainGenerator.hpp>
+#include <Chunk/VoxelEditQueue.hpp>
 #include <Renderer/TextureManager.hpp>
 #include <Shader/Shader.hpp>
 #include <Camera/Camera.hpp>
@@ -30,7 +36,6 @@ public:
 	Chunk(const glm::vec3 &position, ChunkState state = ChunkState::UNLOADED);
 	Chunk(Chunk &&other) noexcept;
 	Chunk &operator=(Chunk &&other) noexcept;
-	~Chunk();
 
 	const glm::vec3 &getPosition() const;
 	bool isVisible() const;
@@ -40,30 +45,89 @@ public:
 
 	void setVoxels(const std::vector<Voxel> &voxels);
 
-	Voxel &getVoxel(uint32_t x, uint32_t y, uint32_t z);
-	const Voxel &getVoxel(uint32_t x, uint32_t y, uint32_t z) const;
+	Voxel getVoxel(uint32_t x, uint32_t y, uint32_t z) const;
 	bool isVoxelActive(int x, int y, int z) const;
 	void setVoxel(int x, int y, int z, TextureType type);
+	/// Flags the sections the voxel at layer y shows in for re-meshing (see
+	/// sectionsTouchedBy()); a meshed chunk goes back to GENERATED. A full
+	/// re-mesh is setState(ChunkState::GENERATED).
+	void markVoxelDirty(int y);
 
 	bool deleteVoxel(const glm::vec3 &position);
 	bool placeVoxel(const glm::vec3 &position, TextureType type);
-	uint32_t draw();
-	uint32_t drawWater();
-	void drawShadow() const;
 	void generateTerrain(TerrainGenerator &generator);
+	void applyTerrain(const ChunkData &chunkData); // Install pre-generated data (e.g. from generateRegion)
+
+	/// Keeps undecorated terrain (generateTerrain() / generateRegion(..., false))
+	/// until the vegetation stage runs, and moves the chunk to TERRAIN.
+	void setPendingTerrain(ChunkData &&chunkData);
+	/// Far-LOD fast path: keeps only the column tops from
+	/// TerrainGenerator::generateSurface(), releases the voxel storage and
+	/// moves the chunk to GENERATED. Only generateLODMesh() can mesh it;
+	/// generateTerrain() upgrades it to full voxels.
+	void generateSurface(TerrainGenerator &generator);
+	bool isSurfaceOnly() const { return m_surfaceOnly.load(); }
+	/// Vegetation stage: decorates the pending terrain, installs it (GENERATED)
+	/// and returns the voxels that belong to neighbouring chunks.
+	std::vector<SpillVoxel> decorate(TerrainGenerator &generator);
+
+	/// Voxels written into this chunk by a neighbour's vegetation stage.
+	/// Thread-safe and lock-free; nothing is applied until applyQueuedEdits().
+	void queueEdits(std::vector<VoxelEdit> edits) { m_editQueue.push(std::move(edits)); }
+	bool hasQueuedEdits() const { return !m_editQueue.empty(); }
+	/// Applies the queued edits with TerrainGenerator::spillReplaces() and
+	/// flags the sections of each changed voxel for re-meshing. Once GENERATED only,
+	/// with no task running on the chunk; a surface-only chunk keeps its edits
+	/// queued until it has voxels.
+	bool applyQueuedEdits();
+	/// Every edit received from neighbours so far, applied or still queued,
+	/// for when the chunk is unloaded before its neighbours are.
+	std::vector<VoxelEdit> takeReceivedEdits();
+
+	/// A pinned chunk may still receive queueEdits() from a running task and
+	/// must not be unloaded.
+	void pin() { m_pinCount.fetch_add(1); }
+	void unpin() { m_pinCount.fetch_sub(1); }
+	bool isPinned() const { return m_pinCount.load() > 0; }
+	/// Meshes the dirty sections only (every section after setState(GENERATED)
+	/// or over a LOD mesh)
 	void generateMesh();
 	void generateLODMesh(); // K: simplified column-top mesh for distant chunks
-	bool hasWaterMesh() const { return waterIndexCount > 0; }
+	bool hasWaterMesh() const;
+	/// Where uploadToGPU() placed each section's meshes in the MeshArena
+	const std::array<MeshArena::Range, SECTION_COUNT> &getOpaqueMeshes() const { return opaqueMeshes; }
+	const std::array<MeshArena::Range, SECTION_COUNT> &getWaterMeshes() const { return waterMeshes; }
+	/// Plane runs of each uploaded water mesh, relative to its range (see sortWaterQuads())
+	const std::array<std::vector<WaterPlane>, SECTION_COUNT> &getWaterPlanes() const { return waterPlanes; }
+	/// Quads of the largest uploaded section mesh
+	uint32_t getMaxQuadCount() const;
+	/// Layers [first, last) the uploaded meshes lie in while the chunk is
+	/// MESHED, so empty sections above and below are culled; the whole column
+	/// before, when the chunk may still need to be generated or meshed.
+	std::pair<int, int> getVisibleLayers() const;
 	bool isLODMesh() const { return m_isLODMesh; }
 	bool needsGPUUpload() const { return meshNeedsUpdate.load(); }
 	bool isInTransit() const { return m_inTransit.load(); }
 	void setInTransit(bool val) { m_inTransit.store(val); }
-	void uploadToGPU();
+	/// Moves the meshed sections into the arena, replacing their previous
+	/// upload; the other sections keep theirs. Main thread only.
+	void uploadToGPU(MeshArena &arena);
 	bool isShellEmpty() const { return neighborShellVoxels.empty(); }
 	void freeShellVoxels();
 	void rebuildShellFromNeighbors(const Chunk *west, const Chunk *east,
 								   const Chunk *south, const Chunk *north);
 
+	/// A fully meshed, uploaded chunk with voxels, whose meshes and voxels
+	/// takeCached() can hand to the MeshCache when it is unloaded
+	bool canCache() const;
+	/// Packs the uploaded meshes, read back from the arena, and moves the
+	/// voxels and biome colours out; the chunk is released to the pool next.
+	/// Main thread only.
+	std::unique_ptr<CachedChunk> takeCached();
+	/// Installs a cached chunk on a chunk fresh from the pool: MESHED, waiting
+	/// for upload, without generating or meshing it
+	void restore(CachedChunk &&cached);
+
 	/// Reinitialize this chunk for reuse by the ChunkPool.
 	/// Releases GPU resources, clears internal buffers (capacity retained),
 	/// and resets all state to UNLOADED.
@@ -74,29 +138,26 @@ private:
 	bool visible;
 	std::atomic<ChunkState> state;
 
-	GLuint VAO;
-	GLuint VBO;
-	GLuint EBO;
-
-	// Separate water mesh for transparency pass
-	GLuint waterVAO;
-	GLuint waterVBO;
-	GLuint waterEBO;
-
-	std::vector<Vertex> vertices;
-	std::vector<uint32_t> indices; // J: upgraded from uint16_t to eliminate silent overflow
-	std::vector<Vertex> waterVertices;
-	std::vector<uint32_t> waterIndices;
-	std::vector<Voxel> voxels;
-	std::bitset<CHUNK_VOLUME> activeVoxels;
+	// Uploaded section meshes, given back to the arena by reset() and by the
+	// next upload of their section
+	MeshArena *meshArena;
+	std::array<MeshArena::Range, SECTION_COUNT> opaqueMeshes;
+	std::array<MeshArena::Range, SECTION_COUNT> waterMeshes; // Separate water meshes for transparency pass
+	std::array<std::vector<WaterPlane>, SECTION_COUNT> waterPlanes;
+
+	// Meshed and not uploaded yet: the sections of m_meshedSections
+	SectionMeshes sectionMeshes;
+	uint32_t m_meshedSections{0};
+	// Layer span of the uploaded meshes (see getVisibleLayers())
+	int m_firstVisibleLayer{0};
+	int m_lastVisibleLayer{CHUNK_HEIGHT};
+	// Sections to re-mesh; taken by generateMesh() on the meshing thread
+	std::atomic<uint32_t> m_dirtySections{ALL_SECTIONS};
+	ChunkSections sections; // Voxels, SECTION_SIZE layers each
 	std::vector<uint8_t> neighborShellVoxels; // Flat array for 1-thick shell (18x(H+2)x18)
 
-	// Precomputed packed RGBA biome colors per column (from terrain generation)
-	std::array<uint32_t, CHUNK_SIZE * CHUNK_SIZE> biomeGrassColors{};
-	std::array<uint32_t, CHUNK_SIZE * CHUNK_SIZE> biomeFoliageColors{};
-
-	uint32_t opaqueIndexCount;
-	uint32_t waterIndexCount;
+	// Blended biome colors at the column corners (from terrain generation)
+	BiomeColorField biomeColors{};
 
 	std::atomic<bool> meshNeedsUpdate;
 	bool m_isLODMesh{false}; // K: true when this chunk carries the simplified LOD mesh
@@ -106,5 +167,12 @@ private:
 	// costly node-based hash map lookups and cache misses in hot loops when iterating over activeChunks.
 	std::atomic<bool> m_inTransit{false};
 
-	size_t getIndex(uint32_t x, uint32_t y, uint32_t z) const;
+	std::unique_ptr<ChunkData> m_pendingTerrain; // Between TERRAIN and the vegetation stage
+	std::unique_ptr<SurfaceData> m_surface; // Column tops of a surface-only chunk
+	std::atomic<bool> m_surfaceOnly{false}; // No voxels: generated by generateSurface()
+	VoxelEditQueue m_editQueue;
+	std::vector<VoxelEdit> m_receivedEdits;
+	std::atomic<int> m_pinCount{0};
+
+	void releaseMesh();
 };
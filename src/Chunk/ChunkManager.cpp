@@ -4,6 +4,8 @@
 #include <Renderer/Renderer.hpp>
 #include <Engine/ThreadPool.hpp>
 #include <Chunk/ChunkManager.hpp>
+#include <Chunk/ColumnNoiseCache.hpp>
+#include <Chunk/ErosionTileCache.hpp>
 #include <glm/gtc/matrix_access.hpp>
 
 #include <iostream>
@@ -11,6 +13,25 @@
 #include <cmath>
 #include <execution>
 
+// The 8 chunks around a chunk, row-major (z, then x) with the centre left out
+static const glm::ivec3 NEIGHBOUR_OFFSETS[8] = {
+	{-1, 0, -1}, {0, 0, -1}, {1, 0, -1},
+	{-1, 0, 0}, {1, 0, 0},
+	{-1, 0, 1}, {0, 0, 1}, {1, 0, 1}};
+
+static int neighbourSlot(int dx, int dz)
+{
+	const int index = (dz + 1) * 3 + (dx + 1);
+	return index > 4 ? index - 1 : index;
+}
+
+static glm::ivec3 chunkIndexOf(const Chunk *chunk)
+{
+	const glm::vec3 &wp = chunk->getPosition();
+	return glm::ivec3(static_cast<int>(std::round(wp.x)) / CHUNK_SIZE, 0,
+					  static_cast<int>(std::round(wp.z)) / CHUNK_SIZE);
+}
+
 ChunkManager::ChunkManager(TerrainGenerator *terrainGenerator, ThreadPool *threadPool, ChunkPool *chunkPool, RenderTiming &renderTiming)
 	: m_terrainGenerator(terrainGenerator), p_threadPool(threadPool), m_chunkPool(chunkPool), m_renderTiming(renderTiming)
 {
@@ -26,12 +47,65 @@ ChunkManager::~ChunkManager()
 	}
 	chunks.clear();
 	activeChunks.clear();
+
+	if (m_quadVAO != 0)
+		glDeleteVertexArrays(1, &m_quadVAO);
+	if (m_quadEBO != 0)
+		glDeleteBuffers(1, &m_quadEBO);
+	if (m_indirectBuffer != 0)
+		glDeleteBuffers(1, &m_indirectBuffer);
+	if (m_drawOriginBuffer != 0)
+		glDeleteBuffers(1, &m_drawOriginBuffer);
 }
 
 void ChunkManager::updatePlayerPosition(const glm::ivec2 &newPlayerChunkPos, const Camera &camera, const RenderSettings &settings)
 {
 	unloadOutOfRangeChunks(camera, settings);
 	loadChunksAroundPlayer(glm::ivec3(newPlayerChunkPos.x, 0, newPlayerChunkPos.y), camera, settings);
+	prefetchErosionTiles(newPlayerChunkPos, settings);
+}
+
+void ChunkManager::prefetchErosionTiles(const glm::ivec2 &playerChunkPos, const RenderSettings &settings)
+{
+	const std::optional<glm::ivec2> lastPos = m_lastPlayerChunkPos;
+	m_lastPlayerChunkPos = playerChunkPos;
+	if (!lastPos || !m_terrainGenerator || !p_threadPool)
+		return;
+
+	const glm::ivec2 travel = playerChunkPos - *lastPos;
+	const int dirX = (travel.x > 0) - (travel.x < 0);
+	const int dirZ = (travel.y > 0) - (travel.y < 0);
+	if (dirX == 0 && dirZ == 0)
+		return;
+
+	// Erosion tiles just past the edge of the load radius on the side(s) the
+	// player is heading to, across the whole width of that edge. They are
+	// built in the background so the chunks loaded there next find them ready.
+	const int radius = static_cast<int>(std::ceil(static_cast<float>(settings.maxRenderDistance) / CHUNK_SIZE));
+	const int seed = m_terrainGenerator->getSeed();
+	const ErosionTileCache &cache = ErosionTileCache::instance();
+	auto tileOfChunk = [](int chunk)
+	{ return ErosionTileCache::tileOf(chunk * CHUNK_SIZE); };
+	auto prefetch = [&](int tileX, int tileZ)
+	{
+		if (cache.contains(seed, tileX, tileZ))
+			return;
+		p_threadPool->enqueue(TaskPriority::Low, [seed, tileX, tileZ]()
+							  { TerrainGenerator::getThreadLocal(seed).prefetchErosionTile(tileX, tileZ); });
+	};
+
+	if (dirX != 0)
+	{
+		const int tileX = tileOfChunk(playerChunkPos.x + dirX * (radius + 1));
+		for (int tileZ = tileOfChunk(playerChunkPos.y - radius); tileZ <= tileOfChunk(playerChunkPos.y + radius); ++tileZ)
+			prefetch(tileX, tileZ);
+	}
+	if (dirZ != 0)
+	{
+		const int tileZ = tileOfChunk(playerChunkPos.y + dirZ * (radius + 1));
+		for (int tileX = tileOfChunk(playerChunkPos.x - radius); tileX <= tileOfChunk(playerChunkPos.x + radius); ++tileX)
+			prefetch(tileX, tileZ);
+	}
 }
 
 void ChunkManager::processChunkLoading(const RenderSettings &settings, int budget)
@@ -77,6 +151,22 @@ void ChunkManager::processChunkLoading(const RenderSettings &settings, int budge
 			{
 				chunks[chunkPos] = chunk;
 				activeChunks.push_back(chunk);
+
+				// Unloaded not long ago: back as it was, meshed and waiting for upload
+				if (m_terrainGenerator)
+				{
+					std::unique_ptr<CachedChunk> cached = m_meshCache.take(chunkPos, m_terrainGenerator->getSeed(), editGenerationOf(chunkPos));
+					if (cached)
+						chunk->restore(std::move(*cached));
+				}
+
+				// Trees of neighbours decorated while this chunk was not loaded
+				auto orphanIt = m_orphanEdits.find(chunkPos);
+				if (orphanIt != m_orphanEdits.end())
+				{
+					chunk->queueEdits(std::move(orphanIt->second));
+					m_orphanEdits.erase(orphanIt);
+				}
 			}
 			else
 			{
@@ -124,8 +214,10 @@ void ChunkManager::performFrustumCulling(const Camera &camera, int windowWidth,
 	std::shared_lock<std::shared_mutex> lock(chunkMutex);
 	for (Chunk *chunk : activeChunks)
 	{
-		glm::vec3 aabbMin = chunk->getPosition();
-		glm::vec3 aabbMax = aabbMin + glm::vec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+		// Empty sections above and below the mesh are left out of the box
+		const auto [firstLayer, lastLayer] = chunk->getVisibleLayers();
+		glm::vec3 aabbMin = chunk->getPosition() + glm::vec3(0.0f, firstLayer, 0.0f);
+		glm::vec3 aabbMax = chunk->getPosition() + glm::vec3(CHUNK_SIZE, lastLayer, CHUNK_SIZE);
 
 		// Broad-phase: Frustum AABB test
 		if (aabbMax.x < fMin.x || aabbMin.x > fMax.x || 
@@ -160,6 +252,8 @@ void ChunkManager::generatePendingVoxels(const Camera &camera, const RenderSetti
 	if (!m_terrainGenerator || !p_threadPool)
 		return;
 
+	m_renderTiming.columnCacheHitRate = ColumnNoiseCache::instance().hitRate();
+
 	std::lock_guard<std::shared_mutex> lock(chunkMutex);
 
 	// Trier les chunks par distance au joueur pour une génération plus cohérente
@@ -173,17 +267,25 @@ void ChunkManager::generatePendingVoxels(const Camera &camera, const RenderSetti
 	genQueueVec.clear();
 	genQueueVec.reserve(activeChunks.size());
 	const glm::vec3 camPos = camera.getPosition();
+	const float lodThreshold = static_cast<float>(settings.minRenderDistance) * 2.0f;
+	const float lodThresholdSq = lodThreshold * lodThreshold;
 
 	for (Chunk *chunk : activeChunks)
 	{
-		if (chunk->isVisible() && chunk->getState() == ChunkState::UNLOADED && !chunk->isInTransit())
-		{
-			glm::vec3 chunkCenter = chunk->getPosition() + glm::vec3(CHUNK_SIZE / 2.0f);
-			float dx = chunkCenter.x - camPos.x;
-			float dz = chunkCenter.z - camPos.z;
-			float distanceSq = dx * dx + dz * dz;
+		if (chunk->isInTransit())
+			continue;
+		glm::vec3 chunkCenter = chunk->getPosition() + glm::vec3(CHUNK_SIZE / 2.0f);
+		float dx = chunkCenter.x - camPos.x;
+		float dz = chunkCenter.z - camPos.z;
+		float distanceSq = dx * dx + dz * dz;
+
+		// Unloaded chunks, and surface-only chunks that came within the
+		// full-detail radius and need their voxels now
+		const bool pending = chunk->getState() == ChunkState::UNLOADED
+								 ? chunk->isVisible() || m_decorationBlockers.count(chunkIndexOf(chunk))
+								 : chunk->isSurfaceOnly() && chunk->isVisible() && distanceSq <= lodThresholdSq;
+		if (pending)
 			genQueueVec.push_back({chunk, distanceSq});
-		}
 	} // Générer les chunks par ordre de priorité
 
 	const int chunksToProcess = std::min(budget, static_cast<int>(genQueueVec.size()));
@@ -197,23 +299,203 @@ void ChunkManager::generatePendingVoxels(const Camera &camera, const RenderSetti
 					  });
 
 	const int currentSeed = m_terrainGenerator->getSeed();
-	const float lodThreshold = static_cast<float>(settings.minRenderDistance) * 2.0f;
-	const float lodThresholdSq = lodThreshold * lodThreshold;
-	for (int i = 0; i < chunksToProcess; ++i)
+
+	// A deep queue (spawn, teleport, render distance change) is drained with
+	// whole regions, which sample each noise layer once for REGION_CHUNKS^2 chunks.
+	bool dispatchRegions = static_cast<int>(genQueueVec.size()) >= REGION_QUEUE_DEPTH;
+
+	int dispatched = 0;
+	for (int i = 0; i < chunksToProcess && dispatched < budget; ++i)
 	{
 		Chunk *chunk = genQueueVec[i].chunk;
+		if (chunk->isInTransit()) // Already taken by a region dispatched this frame
+			continue;
+
 		float distanceSq = genQueueVec[i].distance;
 		TaskPriority priority = calculateTaskPriority(distanceSq, lodThresholdSq);
 
+		// Beyond the LOD threshold only the column tops are drawn: skip the voxels
+		if (distanceSq > lodThresholdSq)
+		{
+			chunk->setInTransit(true);
+			auto future = p_threadPool->enqueue(priority, [chunk, currentSeed]()
+												{
+													TerrainGenerator& localGenerator = TerrainGenerator::getThreadLocal(currentSeed);
+													chunk->generateSurface(localGenerator); });
+			pendingGenerationTasks.push_back({future.share(), chunk});
+			++dispatched;
+			continue;
+		}
+
+		// A region counts as REGION_CHUNKS^2 chunks against the budget: once one no
+		// longer fits, the rest of the frame goes chunk by chunk
+		if (dispatchRegions && dispatched + REGION_CHUNKS * REGION_CHUNKS > budget)
+			dispatchRegions = false;
+
+		if (dispatchRegions && !chunk->isSurfaceOnly() && tryDispatchRegion(chunk, currentSeed, priority, camPos, lodThresholdSq))
+		{
+			dispatched += REGION_CHUNKS * REGION_CHUNKS;
+			continue;
+		}
+
 		chunk->setInTransit(true);
 		auto future = p_threadPool->enqueue(priority, [chunk, currentSeed]()
 											{
 												TerrainGenerator& localGenerator = TerrainGenerator::getThreadLocal(currentSeed);
 												chunk->generateTerrain(localGenerator); });
-		pendingGenerationTasks.push_back({std::move(future), chunk});
+		pendingGenerationTasks.push_back({future.share(), chunk});
+		++dispatched;
 	}
 }
 
+// Dispatch the aligned REGION_CHUNKS x REGION_CHUNKS region containing `chunk`
+// as a single generateRegion() task. Only done when every chunk of the region
+// is loaded, still waiting for generation and within the LOD threshold (a
+// farther one only needs generateSurface()); otherwise the caller falls back
+// to per-chunk generation. Caller holds chunkMutex.
+bool ChunkManager::tryDispatchRegion(Chunk *chunk, int seed, TaskPriority priority, const glm::vec3 &camPos, float lodThresholdSq)
+{
+	auto floorDiv = [](int a, int b)
+	{ return (a >= 0) ? a / b : -((-a + b - 1) / b); };
+
+	const glm::vec3 &wp = chunk->getPosition();
+	const int regionCX = floorDiv(static_cast<int>(std::round(wp.x)) / CHUNK_SIZE, REGION_CHUNKS) * REGION_CHUNKS;
+	const int regionCZ = floorDiv(static_cast<int>(std::round(wp.z)) / CHUNK_SIZE, REGION_CHUNKS) * REGION_CHUNKS;
+
+	std::array<Chunk *, REGION_CHUNKS * REGION_CHUNKS> members;
+	for (int dz = 0; dz < REGION_CHUNKS; ++dz)
+	{
+		for (int dx = 0; dx < REGION_CHUNKS; ++dx)
+		{
+			auto it = chunks.find(glm::ivec3(regionCX + dx, 0, regionCZ + dz));
+			if (it == chunks.end() || it->second->getState() != ChunkState::UNLOADED || it->second->isInTransit())
+				return false;
+			const glm::vec3 center = it->second->getPosition() + glm::vec3(CHUNK_SIZE / 2.0f);
+			const float distX = center.x - camPos.x;
+			const float distZ = center.z - camPos.z;
+			if (distX * distX + distZ * distZ > lodThresholdSq)
+				return false;
+			members[dz * REGION_CHUNKS + dx] = it->second;
+		}
+	}
+
+	for (Chunk *member : members)
+		member->setInTransit(true);
+
+	const int regionX = regionCX * CHUNK_SIZE;
+	const int regionZ = regionCZ * CHUNK_SIZE;
+	std::shared_future<void> future = p_threadPool->enqueue(priority, [members, regionX, regionZ, seed]()
+															{
+																TerrainGenerator &localGenerator = TerrainGenerator::getThreadLocal(seed);
+																std::vector<ChunkData> data = localGenerator.generateRegion(regionX, regionZ, REGION_CHUNKS, false);
+																for (size_t i = 0; i < members.size(); ++i)
+																	members[i]->setPendingTerrain(std::move(data[i])); })
+										  .share();
+	for (Chunk *member : members)
+		pendingGenerationTasks.push_back({future, member});
+	return true;
+}
+
+// Vegetation stage. A chunk with terrain is decorated once none of its loaded
+// neighbours is still waiting for terrain; the task queues the trees' spill-over
+// straight into the neighbours (Chunk::queueEdits), which apply it before their
+// next mesh. Spill-over for neighbours that are not loaded is kept in
+// m_orphanEdits until they are.
+void ChunkManager::decoratePendingChunks(const Camera &camera, const RenderSettings &settings, int budget)
+{
+	if (!m_terrainGenerator || !p_threadPool)
+		return;
+
+	std::lock_guard<std::shared_mutex> lock(chunkMutex);
+	m_decorationBlockers.clear();
+
+	const int currentSeed = m_terrainGenerator->getSeed();
+	const float lodThreshold = static_cast<float>(settings.minRenderDistance) * 2.0f;
+	const float lodThresholdSq = lodThreshold * lodThreshold;
+	const glm::vec3 camPos = camera.getPosition();
+
+	int dispatched = 0;
+	for (Chunk *chunk : activeChunks)
+	{
+		if (dispatched >= budget)
+			break;
+		if (chunk->getState() != ChunkState::TERRAIN || chunk->isInTransit())
+			continue;
+
+		const glm::ivec3 chunkIdx = chunkIndexOf(chunk);
+		std::array<Chunk *, 8> neighbours;
+		bool ready = true;
+		for (int i = 0; i < 8; ++i)
+		{
+			neighbours[i] = getChunk(chunkIdx + NEIGHBOUR_OFFSETS[i]);
+			if (neighbours[i] && neighbours[i]->getState() == ChunkState::UNLOADED)
+			{
+				m_decorationBlockers.insert(chunkIdx + NEIGHBOUR_OFFSETS[i]);
+				ready = false;
+			}
+		}
+		if (!ready)
+			continue;
+
+		chunk->setInTransit(true);
+		for (Chunk *neighbour : neighbours)
+		{
+			if (neighbour)
+				neighbour->pin();
+		}
+
+		glm::vec3 chunkCenter = chunk->getPosition() + glm::vec3(CHUNK_SIZE / 2.0f);
+		float dx = chunkCenter.x - camPos.x;
+		float dz = chunkCenter.z - camPos.z;
+		TaskPriority priority = calculateTaskPriority(dx * dx + dz * dz, lodThresholdSq);
+
+		auto orphaned = std::make_shared<OrphanedEdits>();
+		auto future = p_threadPool->enqueue(priority, [chunk, chunkIdx, neighbours, orphaned, currentSeed]()
+											{
+												TerrainGenerator &localGenerator = TerrainGenerator::getThreadLocal(currentSeed);
+												std::array<std::vector<VoxelEdit>, 8> spill;
+												for (const SpillVoxel &voxel : chunk->decorate(localGenerator))
+												{
+													const int nx = voxel.x < 0 ? -1 : (voxel.x >= CHUNK_SIZE ? 1 : 0);
+													const int nz = voxel.z < 0 ? -1 : (voxel.z >= CHUNK_SIZE ? 1 : 0);
+													spill[neighbourSlot(nx, nz)].push_back({static_cast<uint8_t>(voxel.x - nx * CHUNK_SIZE), voxel.y,
+																							static_cast<uint8_t>(voxel.z - nz * CHUNK_SIZE), voxel.type});
+												}
+												for (int i = 0; i < 8; ++i)
+												{
+													if (spill[i].empty())
+														continue;
+													if (neighbours[i])
+														neighbours[i]->queueEdits(std::move(spill[i]));
+													else
+														orphaned->emplace_back(chunkIdx + NEIGHBOUR_OFFSETS[i], std::move(spill[i]));
+												} });
+		pendingDecorationTasks.push_back({std::move(future), chunk, neighbours, std::move(orphaned)});
+		++dispatched;
+	}
+}
+
+// Keep what `chunk` received from its neighbours: the ones that stay loaded will
+// not decorate again when it comes back. Caller holds chunkMutex.
+void ChunkManager::stashReceivedEdits(const glm::ivec3 &chunkPos, Chunk *chunk)
+{
+	std::vector<VoxelEdit> received = chunk->takeReceivedEdits();
+	if (received.empty())
+		return;
+
+	std::vector<VoxelEdit> &stash = m_orphanEdits[chunkPos];
+	stash.insert(stash.end(), received.begin(), received.end());
+
+	// Neighbours that are unloaded too spill the same voxels again once reloaded
+	auto key = [](const VoxelEdit &e)
+	{ return (uint32_t(e.y) << 24) | (uint32_t(e.z) << 16) | (uint32_t(e.x) << 8) | e.type; };
+	std::sort(stash.begin(), stash.end(), [&](const VoxelEdit &a, const VoxelEdit &b)
+			  { return key(a) < key(b); });
+	stash.erase(std::unique(stash.begin(), stash.end(), [&](const VoxelEdit &a, const VoxelEdit &b)
+							{ return key(a) == key(b); }),
+				stash.end());
+}
+
 void ChunkManager::meshPendingChunks(const Camera &camera, const RenderSettings &settings, int budget)
 {
 	if (!p_threadPool)
@@ -233,6 +515,13 @@ void ChunkManager::meshPendingChunks(const Camera &camera, const RenderSettings
 	meshQueueVec.reserve(activeChunks.size());
 	const glm::vec3 camPos = camera.getPosition();
 
+	// Trees spilled over from neighbours; a meshed chunk goes back to GENERATED
+	for (Chunk *chunk : activeChunks)
+	{
+		if (chunk->getState() >= ChunkState::GENERATED && !chunk->isInTransit() && chunk->hasQueuedEdits())
+			chunk->applyQueuedEdits();
+	}
+
 	for (Chunk *chunk : activeChunks)
 	{
 		if (chunk->isVisible() && chunk->getState() == ChunkState::GENERATED && !chunk->isInTransit())
@@ -253,7 +542,7 @@ void ChunkManager::meshPendingChunks(const Camera &camera, const RenderSettings
 	for (Chunk *chunk : activeChunks)
 	{
 		if (chunk->isLODMesh() && chunk->getState() == ChunkState::MESHED &&
-			!chunk->isInTransit())
+			!chunk->isInTransit() && !chunk->isSurfaceOnly()) // Surface-only: upgraded by generatePendingVoxels()
 		{
 			glm::vec3 cc = chunk->getPosition() + glm::vec3(CHUNK_SIZE / 2.0f);
 			float dx = cc.x - camPos.x;
@@ -283,7 +572,7 @@ void ChunkManager::meshPendingChunks(const Camera &camera, const RenderSettings
 					  static_cast<int>(std::round(wp.z)) / CHUNK_SIZE);
 		chunk->setInTransit(true);
 		TaskPriority priority = calculateTaskPriority(chunkDistSq, lodThresholdSq);
-		if (chunkDistSq > lodThresholdSq)
+		if (chunkDistSq > lodThresholdSq || chunk->isSurfaceOnly()) // Surface-only until generatePendingVoxels() upgrades it
 		{
 			// K: Distant chunk — simplified column-top mesh, no shell needed
 			auto future = p_threadPool->enqueue(priority, [chunk]()
@@ -311,7 +600,6 @@ void ChunkManager::drawVisibleChunks(Shader &shader, const Camera &camera, const
 	// --- Set all frame-constant uniforms once ---
 	shader.use();
 	shader.setMat4("projection", camera.getProjectionMatrix(static_cast<float>(windowWidth), static_cast<float>(windowHeight), static_cast<float>(renderSettings.maxRenderDistance)));
-	shader.setMat4("model", glm::mat4(1.0f));
 	shader.setMat4("view", camera.getViewMatrix());
 	shader.setInt("textureArray", 0);
 
@@ -348,15 +636,18 @@ void ChunkManager::drawVisibleChunks(Shader &shader, const Camera &camera, const
 	for (const auto& pair : m_visibleOpaquePairs)
 	{
 		Chunk *chunk = pair.second;
-		renderSettings.visibleVoxelsCount += chunk->draw();
+		for (const MeshArena::Range &mesh : chunk->getOpaqueMeshes())
+			renderSettings.visibleVoxelsCount += addDraw(mesh, chunk->getPosition());
 		renderSettings.visibleChunksCount++;
+	}
+	submitDraws();
 
-		if (renderSettings.chunkBorders && renderer)
-		{
-			renderer->drawBoundingBox(*chunk, camera);
-		}
+	if (renderSettings.chunkBorders && renderer)
+	{
+		for (const auto& pair : m_visibleOpaquePairs)
+			renderer->drawBoundingBox(*pair.second, camera);
+		shader.use();
 	}
-	glBindVertexArray(0);
 
 	// --- Water transparency sub-pass ---
 	// H: Rebuild sorted water list only when camera moved > CHUNK_SIZE/2 from last sort.
@@ -394,12 +685,15 @@ void ChunkManager::drawVisibleChunks(Shader &shader, const Camera &camera, const
 	glDepthMask(GL_FALSE);
 	glDisable(GL_CULL_FACE); // V1: Allow seeing water from below
 
+	// Commands run in order, so the water stays sorted back to front: chunks
+	// by the sort above, and within a chunk, plane runs every frame
 	for (Chunk *chunk : m_cachedWaterChunks)
 	{
-		if (chunk->isVisible() && chunk->getState() >= ChunkState::MESHED)
-			chunk->drawWater();
+		if (!chunk->isVisible() || chunk->getState() < ChunkState::MESHED)
+			continue;
+		addWaterDraws(*chunk, camPos);
 	}
-	glBindVertexArray(0);
+	submitDraws();
 
 	glDepthMask(GL_TRUE);
 	glDisable(GL_BLEND);
@@ -412,8 +706,6 @@ void ChunkManager::drawShadows(const Shader &shader, const glm::vec3 &cameraPos)
 {
 	std::shared_lock<std::shared_mutex> lock(chunkMutex);
 	shader.use();
-	// Set model matrix once for all chunks to avoid redundant per-chunk API overhead
-	shader.setMat4("model", glm::mat4(1.0f));
 
 	// Rayon de couverture de la shadow map (512.0f) + marge pour la diagonale du chunk (~250.0f)
 	constexpr float kShadowCullDistanceSq = (512.0f + 250.0f) * (512.0f + 250.0f);
@@ -433,9 +725,92 @@ void ChunkManager::drawShadows(const Shader &shader, const glm::vec3 &cameraPos)
 		if (distSq > kShadowCullDistanceSq)
 			continue;
 
-		chunk->drawShadow();
+		if (chunk->needsGPUUpload())
+			continue;
+		for (const MeshArena::Range &mesh : chunk->getOpaqueMeshes())
+			addDraw(mesh, chunk->getPosition());
+	}
+	submitDraws();
+}
+
+uint32_t ChunkManager::addDraw(const MeshArena::Range &mesh, const glm::vec3 &origin) const
+{
+	if (mesh.count == 0)
+		return 0;
+	DrawElementsIndirectCommand command{};
+	command.count = mesh.count * 6;
+	command.instanceCount = 1;
+	command.baseVertex = static_cast<int32_t>(mesh.offset * 4);
+	m_drawCommands.push_back(command);
+	m_drawOrigins.push_back(glm::vec4(origin, 0.0f)); // Read as origins[gl_DrawID]
+	return command.count;
+}
+
+uint32_t ChunkManager::addWaterDraws(const Chunk &chunk, const glm::vec3 &cameraPos) const
+{
+	// Distance to each plane along its axis: exact back to front among the
+	// planes of one axis, both sides of the camera, and close enough across
+	// axes for water, which is mostly flat
+	const glm::vec3 camera = cameraPos - chunk.getPosition();
+	m_waterRuns.clear();
+	for (int section = 0; section < SECTION_COUNT; ++section)
+	{
+		const MeshArena::Range &mesh = chunk.getWaterMeshes()[section];
+		for (const WaterPlane &plane : chunk.getWaterPlanes()[section])
+		{
+			const float distance = std::abs(camera[plane.normal >> 1] - static_cast<float>(plane.plane));
+			m_waterRuns.push_back({distance, section, {mesh.offset + plane.first, plane.count}});
+		}
 	}
+	std::sort(m_waterRuns.begin(), m_waterRuns.end(), [](const WaterRun &a, const WaterRun &b)
+			  { return a.distance > b.distance || (a.distance == b.distance && a.range.offset < b.range.offset); });
+
+	// Merged within a section only: a draw must not outgrow the shared index
+	// pattern, sized to the largest section mesh (reserveQuadIndices())
+	uint32_t indices = 0;
+	MeshArena::Range merged{};
+	int mergedSection = -1;
+	for (const WaterRun &run : m_waterRuns)
+	{
+		if (run.section == mergedSection && merged.offset + merged.count == run.range.offset)
+		{
+			merged.count += run.range.count;
+			continue;
+		}
+		indices += addDraw(merged, chunk.getPosition());
+		merged = run.range;
+		mergedSection = run.section;
+	}
+	return indices + addDraw(merged, chunk.getPosition());
+}
+
+void ChunkManager::submitDraws() const
+{
+	if (m_drawCommands.empty())
+		return;
+	if (m_indirectBuffer == 0)
+		glGenBuffers(1, &m_indirectBuffer);
+	if (m_drawOriginBuffer == 0)
+		glGenBuffers(1, &m_drawOriginBuffer);
+
+	// Orphaned every pass: the driver hands out fresh storage instead of
+	// waiting for the previous pass to finish reading
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, m_drawCommands.size() * sizeof(DrawElementsIndirectCommand),
+				 m_drawCommands.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawOriginBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, m_drawOrigins.size() * sizeof(glm::vec4), m_drawOrigins.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_meshArena.buffer());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_drawOriginBuffer);
+	glBindVertexArray(m_quadVAO);
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(m_drawCommands.size()), 0);
 	glBindVertexArray(0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	m_drawCommands.clear();
+	m_drawOrigins.clear();
 }
 
 void ChunkManager::uploadPendingMeshes(int budget)
@@ -448,21 +823,81 @@ void ChunkManager::uploadPendingMeshes(int budget)
 			break;
 		if (chunk->getState() == ChunkState::MESHED && chunk->needsGPUUpload() && !chunk->isInTransit())
 		{
-			chunk->uploadToGPU();
+			chunk->uploadToGPU(m_meshArena);
+			reserveQuadIndices(chunk->getMaxQuadCount());
 			++uploaded;
 		}
 	}
 }
 
+void ChunkManager::reserveQuadIndices(uint32_t quads)
+{
+	if (quads <= m_quadIndexCapacity)
+		return;
+	// Grows by doubling: a few reallocations cover the largest chunk mesh
+	uint32_t capacity = std::max(m_quadIndexCapacity, 4096u);
+	while (capacity < quads)
+		capacity *= 2;
+
+	std::vector<uint32_t> pattern(static_cast<size_t>(capacity) * 6);
+	for (uint32_t q = 0; q < capacity; ++q)
+	{
+		static constexpr uint32_t QUAD[6] = {0, 1, 2, 0, 2, 3};
+		for (int i = 0; i < 6; ++i)
+			pattern[q * 6 + i] = q * 4 + QUAD[i];
+	}
+
+	if (m_quadVAO == 0)
+		glGenVertexArrays(1, &m_quadVAO);
+	if (m_quadEBO == 0)
+		glGenBuffers(1, &m_quadEBO);
+	glBindVertexArray(m_quadVAO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadEBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, pattern.size() * sizeof(uint32_t), pattern.data(), GL_STATIC_DRAW);
+	glBindVertexArray(0);
+	m_quadIndexCapacity = capacity;
+}
+
 void ChunkManager::ensureShellPopulated(Chunk *chunk, const glm::ivec3 &chunkIdx)
 {
-	if (!chunk->isShellEmpty())
+	if (!chunk->isShellEmpty() || chunk->isSurfaceOnly())
 		return;
+	// Surface-only neighbours have no voxels to copy
+	auto withVoxels = [this, &chunkIdx](const glm::ivec3 &offset) -> const Chunk *
+	{
+		const Chunk *neighbor = getChunk(chunkIdx + offset);
+		return neighbor && !neighbor->isSurfaceOnly() ? neighbor : nullptr;
+	};
 	chunk->rebuildShellFromNeighbors(
-		getChunk(chunkIdx + glm::ivec3(-1, 0, 0)),
-		getChunk(chunkIdx + glm::ivec3(+1, 0, 0)),
-		getChunk(chunkIdx + glm::ivec3(0, 0, -1)),
-		getChunk(chunkIdx + glm::ivec3(0, 0, +1)));
+		withVoxels(glm::ivec3(-1, 0, 0)),
+		withVoxels(glm::ivec3(+1, 0, 0)),
+		withVoxels(glm::ivec3(0, 0, -1)),
+		withVoxels(glm::ivec3(0, 0, +1)));
+}
+
+// Every edit that changes a voxel, and every edit to a chunk that is not
+// loaded, moves the edit generation of the chunk and of the neighbours whose
+// shell holds the voxel, so none of them is restored from a MeshCache entry
+// stored before it. Caller holds chunkMutex.
+void ChunkManager::noteEdit(const glm::ivec3 &chunkPos, const glm::vec3 &worldPos)
+{
+	const int localX = static_cast<int>(std::floor(worldPos.x)) - chunkPos.x * CHUNK_SIZE;
+	const int localZ = static_cast<int>(std::floor(worldPos.z)) - chunkPos.z * CHUNK_SIZE;
+	++m_editGenerations[chunkPos];
+	if (localX == 0)
+		++m_editGenerations[chunkPos + glm::ivec3(-1, 0, 0)];
+	if (localX == CHUNK_SIZE - 1)
+		++m_editGenerations[chunkPos + glm::ivec3(1, 0, 0)];
+	if (localZ == 0)
+		++m_editGenerations[chunkPos + glm::ivec3(0, 0, -1)];
+	if (localZ == CHUNK_SIZE - 1)
+		++m_editGenerations[chunkPos + glm::ivec3(0, 0, 1)];
+}
+
+uint32_t ChunkManager::editGenerationOf(const glm::ivec3 &chunkPos) const
+{
+	auto it = m_editGenerations.find(chunkPos);
+	return it != m_editGenerations.end() ? it->second : 0;
 }
 
 bool ChunkManager::deleteVoxel(const glm::vec3 &worldPos)
@@ -478,6 +913,7 @@ bool ChunkManager::deleteVoxel(const glm::vec3 &worldPos)
 		bool modified = it->second->deleteVoxel(worldPos);
 		if (modified)
 		{
+			noteEdit(chunkPos, worldPos);
 			const int localX = static_cast<int>(std::floor(worldPos.x)) - chunkX * CHUNK_SIZE;
 			const int localY = static_cast<int>(std::floor(worldPos.y));
 			const int localZ = static_cast<int>(std::floor(worldPos.z)) - chunkZ * CHUNK_SIZE;
@@ -491,7 +927,7 @@ bool ChunkManager::deleteVoxel(const glm::vec3 &worldPos)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(CHUNK_SIZE, localY, localZ, AIR);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 			if (localX == CHUNK_SIZE - 1)
@@ -502,7 +938,7 @@ bool ChunkManager::deleteVoxel(const glm::vec3 &worldPos)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(-1, localY, localZ, AIR);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 			if (localZ == 0)
@@ -513,7 +949,7 @@ bool ChunkManager::deleteVoxel(const glm::vec3 &worldPos)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(localX, localY, CHUNK_SIZE, AIR);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 			if (localZ == CHUNK_SIZE - 1)
@@ -524,12 +960,13 @@ bool ChunkManager::deleteVoxel(const glm::vec3 &worldPos)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(localX, localY, -1, AIR);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 		}
 		return modified;
 	}
+	noteEdit(chunkPos, worldPos); // Dropped here, but a cached copy of the chunk is stale
 	return false;
 }
 
@@ -546,6 +983,7 @@ bool ChunkManager::placeVoxel(const glm::vec3 &worldPos, TextureType type)
 		bool modified = it->second->placeVoxel(worldPos, type);
 		if (modified)
 		{
+			noteEdit(chunkPos, worldPos);
 			const int localX = static_cast<int>(std::floor(worldPos.x)) - chunkX * CHUNK_SIZE;
 			const int localY = static_cast<int>(std::floor(worldPos.y));
 			const int localZ = static_cast<int>(std::floor(worldPos.z)) - chunkZ * CHUNK_SIZE;
@@ -559,7 +997,7 @@ bool ChunkManager::placeVoxel(const glm::vec3 &worldPos, TextureType type)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(CHUNK_SIZE, localY, localZ, type);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 			if (localX == CHUNK_SIZE - 1)
@@ -570,7 +1008,7 @@ bool ChunkManager::placeVoxel(const glm::vec3 &worldPos, TextureType type)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(-1, localY, localZ, type);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 			if (localZ == 0)
@@ -581,7 +1019,7 @@ bool ChunkManager::placeVoxel(const glm::vec3 &worldPos, TextureType type)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(localX, localY, CHUNK_SIZE, type);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 			if (localZ == CHUNK_SIZE - 1)
@@ -592,12 +1030,13 @@ bool ChunkManager::placeVoxel(const glm::vec3 &worldPos, TextureType type)
 				{
 					ensureShellPopulated(neighbor, nPos);
 					neighbor->setVoxel(localX, localY, -1, type);
-					neighbor->setState(ChunkState::GENERATED);
+					neighbor->markVoxelDirty(localY);
 				}
 			}
 		}
 		return modified;
 	}
+	noteEdit(chunkPos, worldPos); // Dropped here, but a cached copy of the chunk is stale
 	return false;
 }
 
@@ -612,7 +1051,7 @@ bool ChunkManager::isVoxelActive(const glm::vec3 &worldPos) const
 
 	std::shared_lock<std::shared_mutex> lock(chunkMutex); // const method, shared read lock
 	auto it = chunks.find(chunkPos);
-	if (it != chunks.end() && it->second->getState() >= ChunkState::GENERATED) // Voxels exist once generated
+	if (it != chunks.end() && it->second->getState() >= ChunkState::GENERATED && !it->second->isSurfaceOnly()) // Voxels exist once generated
 	{
 		// Convert world coordinates to local voxel coordinates
 		int localX = static_cast<int>(std::floor(worldPos.x)) - chunkX * CHUNK_SIZE;
@@ -677,7 +1116,7 @@ void ChunkManager::unloadOutOfRangeChunks(const Camera &camera, const RenderSett
 			if (distToPlayerSq > unloadDistSq)
 			{
 				// Do not unload chunks that are currently being processed
-				if (!chunkPtr->isInTransit())
+				if (!chunkPtr->isInTransit() && !chunkPtr->isPinned())
 				{
 					chunksToUnload.push_back(pos);
 				}
@@ -696,8 +1135,11 @@ void ChunkManager::unloadOutOfRangeChunks(const Camera &camera, const RenderSett
 			{
 				Chunk* chunkPtr = it->second;
 				// Re-check in_transit just in case state changed
-				if (!chunkPtr->isInTransit())
+				if (!chunkPtr->isInTransit() && !chunkPtr->isPinned())
 				{
+					stashReceivedEdits(pos, chunkPtr);
+					if (m_terrainGenerator && chunkPtr->canCache())
+						m_meshCache.store(pos, m_terrainGenerator->getSeed(), editGenerationOf(pos), chunkPtr->takeCached());
 					auto activeIt = std::find(activeChunks.begin(), activeChunks.end(), chunkPtr);
 					if (activeIt != activeChunks.end())
 					{
@@ -711,6 +1153,39 @@ void ChunkManager::unloadOutOfRangeChunks(const Camera &camera, const RenderSett
 			}
 		}
 	}
+
+	// Cached chunks are kept up to half the render distance past the unload
+	// distance. They are not decorated again when restored, so a neighbour
+	// generated next to one needs the trees it spilled: kept in m_orphanEdits.
+	const float cacheDist = unloadDist + static_cast<float>(settings.maxRenderDistance) * 0.5f;
+	m_meshCache.dropBeyond(camera.getPosition(), cacheDist);
+
+	// Orphaned edits are only useful while a loaded or cached chunk can still
+	// be next to their target: drop them one chunk diagonal beyond the cache distance
+	if (!m_orphanEdits.empty())
+	{
+		const float dropDist = cacheDist + 2.0f * CHUNK_SIZE;
+		const float dropDistSq = dropDist * dropDist;
+		std::lock_guard<std::shared_mutex> lock(chunkMutex);
+		for (auto it = m_orphanEdits.begin(); it != m_orphanEdits.end();)
+		{
+			float dx = camera.getPosition().x - (it->first.x * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+			float dz = camera.getPosition().z - (it->first.z * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+			if (dx * dx + dz * dz > dropDistSq)
+				it = m_orphanEdits.erase(it);
+			else
+				++it;
+		}
+	}
+
+	// A generation only has to outlive the cache entry it guards: the chunks
+	// with neither an entry nor orphaned edits start over from 0
+	if (!m_editGenerations.empty())
+	{
+		std::lock_guard<std::shared_mutex> lock(chunkMutex);
+		std::erase_if(m_editGenerations, [this](const auto &entry)
+					  { return !m_meshCache.contains(entry.first) && !m_orphanEdits.contains(entry.first); });
+	}
 }
 
 void ChunkManager::loadChunksAroundPlayer(const glm::ivec3 &cameraChunkPos, const Camera &camera, const RenderSettings &settings)
@@ -797,6 +1272,40 @@ void ChunkManager::processFinishedJobs()
 		}
 	}
 
+	// Check vegetation tasks
+	for (size_t i = 0; i < pendingDecorationTasks.size(); )
+	{
+		DecorationTask &task = pendingDecorationTasks[i];
+		if (task.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			task.future.get();
+			task.chunk->setInTransit(false);
+			for (Chunk *neighbour : task.neighbours)
+			{
+				if (neighbour)
+					neighbour->unpin();
+			}
+			for (auto &[chunkPos, edits] : *task.orphaned)
+			{
+				// The neighbour may have been loaded while the task ran
+				auto it = chunks.find(chunkPos);
+				if (it != chunks.end())
+					it->second->queueEdits(std::move(edits));
+				else
+				{
+					std::vector<VoxelEdit> &stash = m_orphanEdits[chunkPos];
+					stash.insert(stash.end(), edits.begin(), edits.end());
+				}
+			}
+			pendingDecorationTasks[i] = std::move(pendingDecorationTasks.back());
+			pendingDecorationTasks.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+
 	// Check meshing tasks
 	for (size_t i = 0; i < pendingMeshingTasks.size(); )
 	{
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
 #include <queue>
 #include <mutex>
 #include <shared_mutex>
 #include <vector>
 #include <future>
 #include <memory>
+#include <optional>
 
 #include <glm/glm.hpp>
 #include <Chunk/Chunk.hpp>
 #include <Chunk/ChunkPool.hpp>
+#include <Chunk/MeshCache.hpp>
 #include <utils.hpp>
 #include <Engine/EngineDefs.hpp>
 #include <Chunk/TerrainGenerator.hpp>
@@ -35,6 +38,7 @@ public:
 	void performFrustumCulling(const Camera &camera, int windowWidth, int windowHeight, const RenderSettings &settings);
 
 	void generatePendingVoxels(const Camera &camera, const RenderSettings &settings, unsigned int seed, int budget);
+	void decoratePendingChunks(const Camera &camera, const RenderSettings &settings, int budget);
 	void meshPendingChunks(const Camera &camera, const RenderSettings &settings, int budget);
 
 	void drawVisibleChunks(Shader &shader, const Camera &camera, const GLuint &textureAtlas, const ShaderParameters &shaderParams, Renderer *renderer, RenderSettings &renderSettings, int windowWidth, int windowHeight);
@@ -51,20 +55,74 @@ public:
 
 	/// Returns the ChunkPool used by this manager (for UI stats display).
 	ChunkPool *getChunkPool() const { return m_chunkPool; }
+	/// Unloaded chunks kept for a quick reload (for UI stats display).
+	const MeshCache &getMeshCache() const { return m_meshCache; }
 
 private:
+	// Region-batched generation: aligned REGION_CHUNKS x REGION_CHUNKS blocks are
+	// dispatched as one task once at least REGION_QUEUE_DEPTH chunks wait for generation.
+	static constexpr int REGION_CHUNKS = TerrainGenerator::MAX_REGION_CHUNKS;
+	static constexpr int REGION_QUEUE_DEPTH = 64;
+	static constexpr size_t MESH_CACHE_BYTES = size_t(64) << 20;
+
 	void unloadOutOfRangeChunks(const Camera &camera, const RenderSettings &settings);
 	void loadChunksAroundPlayer(const glm::ivec3 &cameraChunkPos, const Camera &camera, const RenderSettings &settings);
 	void ensureShellPopulated(Chunk *chunk, const glm::ivec3 &chunkIdx);
 	TaskPriority calculateTaskPriority(float distance, float lodThreshold) const;
+	bool tryDispatchRegion(Chunk *chunk, int seed, TaskPriority priority, const glm::vec3 &camPos, float lodThresholdSq);
+	void stashReceivedEdits(const glm::ivec3 &chunkPos, Chunk *chunk);
+	void noteEdit(const glm::ivec3 &chunkPos, const glm::vec3 &worldPos);
+	uint32_t editGenerationOf(const glm::ivec3 &chunkPos) const;
+	void prefetchErosionTiles(const glm::ivec2 &playerChunkPos, const RenderSettings &settings);
+	void reserveQuadIndices(uint32_t quads);
+	/// Queues one indirect command for a mesh; returns its index count
+	uint32_t addDraw(const MeshArena::Range &mesh, const glm::vec3 &origin) const;
+	/// Queues the water plane runs of a chunk, farthest from the camera first,
+	/// merging runs of one section that follow one another in the arena;
+	/// returns their index count
+	uint32_t addWaterDraws(const Chunk &chunk, const glm::vec3 &cameraPos) const;
+	/// Draws the queued commands with one glMultiDrawElementsIndirect() and clears them
+	void submitDraws() const;
 
 	std::unordered_map<glm::ivec3, Chunk*, IVec3Hash> chunks;
 	std::vector<Chunk *> activeChunks;
 	std::queue<glm::ivec3> chunkLoadQueue;
 
-	std::vector<std::pair<std::future<void>, Chunk *>> pendingGenerationTasks;
+	// Shared: a region task completes several chunks at once
+	std::vector<std::pair<std::shared_future<void>, Chunk *>> pendingGenerationTasks;
 	std::vector<std::pair<std::future<void>, Chunk *>> pendingMeshingTasks;
 
+	// Vegetation stage: the chunk is in transit, its loaded neighbours are
+	// pinned while the task queues spill-over edits into them.
+	using OrphanedEdits = std::vector<std::pair<glm::ivec3, std::vector<VoxelEdit>>>;
+	struct DecorationTask
+	{
+		std::future<void> future;
+		Chunk *chunk;
+		std::array<Chunk *, 8> neighbours;
+		std::shared_ptr<OrphanedEdits> orphaned; // Spill-over for neighbours that are not loaded
+	};
+	std::vector<DecorationTask> pendingDecorationTasks;
+
+	// Spill-over edits for chunks that are not loaded, handed over when they
+	// are. Also keeps what an unloaded chunk had received from neighbours that
+	// stay loaded, since those will not decorate again.
+	std::unordered_map<glm::ivec3, std::vector<VoxelEdit>, IVec3Hash> m_orphanEdits;
+	// Loaded but ungenerated neighbours holding back a vegetation stage: they
+	// are generated even when not visible.
+	std::unordered_set<glm::ivec3, IVec3Hash> m_decorationBlockers;
+
+	// Chunks unloaded near the load radius, restored on reload (see MeshCache).
+	// An entry is only taken back at the edit generation it was stored at: the
+	// count of edits that changed its chunk or its border, or were aimed at it
+	// while it was not loaded. Pruned to the chunks with an entry or orphaned
+	// edits by unloadOutOfRangeChunks().
+	MeshCache m_meshCache{MESH_CACHE_BYTES};
+	std::unordered_map<glm::ivec3, uint32_t, IVec3Hash> m_editGenerations;
+
+	// Player chunk at the previous updatePlayerPosition(), for the direction of travel
+	std::optional<glm::ivec2> m_lastPlayerChunkPos;
+
 	mutable std::shared_mutex chunkMutex;
 
 	// Optimization: Pre-allocated vectors for sorting to avoid per-frame allocations
@@ -74,6 +132,29 @@ private:
 	// H: water-sort cache — rebuilt only when camera moves > CHUNK_SIZE/2
 	mutable glm::vec3 m_lastWaterSortCamPos{std::numeric_limits<float>::max()};
 	mutable std::vector<Chunk *> m_cachedWaterChunks;
+	// Water plane runs of the chunk addWaterDraws() is queuing, by distance to the camera
+	struct WaterRun
+	{
+		float distance;
+		int section;
+		MeshArena::Range range;
+	};
+	mutable std::vector<WaterRun> m_waterRuns;
+
+	// Vertex pulling: chunk meshes have no vertex attributes; every draw uses
+	// this VAO, whose index buffer repeats {0, 1, 2, 0, 2, 3} + 4q for
+	// m_quadIndexCapacity quads
+	GLuint m_quadVAO = 0;
+	GLuint m_quadEBO = 0;
+	uint32_t m_quadIndexCapacity = 0;
+
+	// Every uploaded chunk mesh; a pass queues one command per section mesh
+	// with addDraw() and the chunk origins, indexed by gl_DrawID in the shaders
+	MeshArena m_meshArena;
+	mutable std::vector<DrawElementsIndirectCommand> m_drawCommands;
+	mutable std::vector<glm::vec4> m_drawOrigins;
+	mutable GLuint m_indirectBuffer = 0;
+	mutable GLuint m_drawOriginBuffer = 0;
 
 	TerrainGenerator *m_terrainGenerator;
 	ThreadPool *p_threadPool;
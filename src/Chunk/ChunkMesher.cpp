@@ -0,0 +1,562 @@
+#include "ChunkMesher.hpp"
+
+#include <Renderer/TextureManager.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace
+{
+	constexpr int PAD = CHUNK_SIZE + 2; // Padded row: shell voxel, the chunk's voxels, shell voxel
+	constexpr int PAD_HEIGHT = CHUNK_HEIGHT + 2;
+	constexpr int PAD_LAYER = PAD * PAD;
+	constexpr uint32_t CHUNK_BITS = (1u << CHUNK_SIZE) - 1;
+	constexpr uint32_t PAD_BITS = (1u << PAD) - 1;
+	constexpr uint64_t AIR_BYTES = 0x0101010101010101ull * static_cast<uint8_t>(AIR);
+	static_assert(CHUNK_SIZE == 16, "Rows are gathered as two 8-byte words");
+	static_assert(sizeof(Voxel) == 1, "Voxel rows are copied as bytes");
+
+	// Every type TextureManager::isTransparent() accepts. Rows tell them apart
+	// by a 2-bit number (1 to 3), so that a face between two voxels of the same
+	// one is culled
+	constexpr TextureType TRANSPARENT_TYPES[] = {GLASS, OAK_LEAVES, WATER};
+	static_assert(std::size(TRANSPARENT_TYPES) <= 3, "Transparent types are numbered on 2 bits");
+
+	/// Occupancy of one padded row along X: bit i is voxel i - 1
+	struct RowMasks
+	{
+		uint32_t solid;	   // Not air
+		uint32_t opaque;   // Not air and not transparent
+		uint32_t typeLow;  // Transparent voxels: bit 0 of their number
+		uint32_t typeHigh; // Transparent voxels: bit 1 of their number
+
+		/// Rows of the neighbours at +1 (by = 1) or -1 (by = -1) along X
+		RowMasks neighbours(int by) const
+		{
+			auto shift = [by](uint32_t bits)
+			{ return by > 0 ? bits >> by : bits << -by; };
+			return {shift(solid), shift(opaque), shift(typeLow), shift(typeHigh)};
+		}
+	};
+
+	/// Faces of the chunk's voxels in row a that look into row b (bit for bit
+	/// their neighbours), as CHUNK_SIZE bits
+	uint32_t visibleFaces(const RowMasks &a, const RowMasks &b)
+	{
+		const uint32_t sameTransparent = (a.solid & ~a.opaque) & (b.solid & ~b.opaque) &
+										 ~(a.typeLow ^ b.typeLow) & ~(a.typeHigh ^ b.typeHigh);
+		return ((a.solid & ~b.opaque & ~sameTransparent) >> 1) & CHUNK_BITS;
+	}
+
+	/// Per-type bits, in RowMasks order: solid, opaque, typeLow, typeHigh
+	const std::array<uint8_t, 256> &typeKinds()
+	{
+		static const std::array<uint8_t, 256> kinds = []
+		{
+			std::array<uint8_t, 256> table{};
+			for (int type = 0; type < 256; ++type)
+			{
+				if (type == AIR)
+					continue;
+				const TextureType t = static_cast<TextureType>(type);
+				table[type] = TextureManager::isTransparent(t) ? 1 : 3;
+				for (size_t i = 0; i < std::size(TRANSPARENT_TYPES); ++i)
+					if (t == TRANSPARENT_TYPES[i])
+						table[type] |= static_cast<uint8_t>((i + 1) << 2);
+			}
+			return table;
+		}();
+		return kinds;
+	}
+
+	/// Bit `bit` of each of the 8 bytes of `bytes`: byte i gives bit i
+	uint32_t gatherBits(uint64_t bytes, int bit)
+	{
+		return static_cast<uint32_t>((((bytes >> bit) & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56);
+	}
+
+	enum FaceDir
+	{
+		POS_X,
+		NEG_X,
+		POS_Y,
+		NEG_Y,
+		POS_Z,
+		NEG_Z,
+		FACE_DIR_COUNT
+	};
+
+	struct MeshWorkspace
+	{
+		std::array<uint8_t, PAD_HEIGHT * PAD_LAYER> types; // Chunk and shell, indexed like the shell
+		std::array<RowMasks, PAD_HEIGHT * PAD> rows;	   // [y][z], padded
+		// Visible faces per FaceDir, as planes of CHUNK_SIZE-bit rows: X planes
+		// [x][y] hold z bits, Y planes [y][z] and Z planes [z][y] hold x bits
+		std::array<std::array<uint32_t, CHUNK_SIZE * CHUNK_HEIGHT>, FACE_DIR_COUNT> faces;
+		// Colour of a column when its four corners agree, else -1
+		std::array<int32_t, CHUNK_SIZE * CHUNK_SIZE> flatGrass;
+		std::array<int32_t, CHUNK_SIZE * CHUNK_SIZE> flatFoliage;
+	};
+
+	MeshWorkspace &workspace()
+	{
+		// On the heap, and only for threads that mesh
+		thread_local std::unique_ptr<MeshWorkspace> ws = std::make_unique<MeshWorkspace>();
+		return *ws;
+	}
+
+	int typeIndex(int x, int y, int z)
+	{
+		return (y + 1) * PAD_LAYER + (z + 1) * PAD + (x + 1);
+	}
+
+	bool isBiomeColored(TextureType type)
+	{
+		return type == GRASS_TOP || type == GRASS_SIDE || type == OAK_LEAVES;
+	}
+
+	void fillFlatColors(const std::array<uint16_t, BiomeColorField::SIZE * BiomeColorField::SIZE> &corners,
+						std::array<int32_t, CHUNK_SIZE * CHUNK_SIZE> &flat)
+	{
+		constexpr int SIZE = BiomeColorField::SIZE;
+		for (int z = 0; z < CHUNK_SIZE; ++z)
+		{
+			for (int x = 0; x < CHUNK_SIZE; ++x)
+			{
+				const int i = z * SIZE + x;
+				const uint16_t color = corners[i];
+				const bool same = corners[i + 1] == color && corners[i + SIZE] == color && corners[i + SIZE + 1] == color;
+				flat[z * CHUNK_SIZE + x] = same ? color : -1;
+			}
+		}
+	}
+
+	/// Ambient occlusion of quad corner `corner`, from the layer in front of
+	/// the face. Samples lie on the diagonal through the corner, and air counts
+	/// as an occluder like every other non-transparent type.
+	uint32_t cornerAO(const uint8_t *types, int d, int u, int v, bool positive, const glm::ivec3 &pos, int corner)
+	{
+		const int layer = positive ? pos[d] : pos[d] - 1;
+		auto occludes = [&](int du)
+		{
+			glm::ivec3 c;
+			c[d] = layer;
+			c[u] = pos[u] + du;
+			c[v] = pos[v] + du;
+			return !TextureManager::isTransparent(static_cast<TextureType>(types[typeIndex(c.x, c.y, c.z)]));
+		};
+
+		const bool inner = occludes(0);
+		const bool outer = occludes(-1);
+		if (inner && outer)
+			return 0;
+		const bool diagonal = (corner == 1 || corner == 2) ? inner : outer;
+		return 3 - (inner + outer + diagonal);
+	}
+
+	/// Appends the quad of direction `face` that starts at voxel `owner` and
+	/// spans `size` voxels (1 along the normal axis)
+	void emitQuad(const ChunkMeshInput &input, const uint8_t *types, SectionMesh &out,
+				  int face, const glm::ivec3 &owner, const glm::ivec3 &size, TextureType type)
+	{
+		const int d = face / 2;
+		const int u = (d + 1) % 3;
+		const int v = (d + 2) % 3;
+		const bool positive = (face & 1) == 0;
+
+		glm::ivec3 start = owner;
+		if (positive)
+			start[d] += 1;
+		glm::ivec3 alongU(0);
+		alongU[u] = size[u];
+		glm::ivec3 alongV(0);
+		alongV[v] = size[v];
+		const glm::ivec3 corners[4] = {start, start + alongU, start + alongU + alongV, start + alongV};
+
+		TextureType texture = type;
+		if (type == GRASS_SIDE && face == POS_Y)
+			texture = GRASS_TOP;
+		else if (type == GRASS_SIDE && face == NEG_Y)
+			texture = DIRT;
+		else if (type == OAK_LOG && d == 1)
+			texture = OAK_LOG_TOP;
+
+		const bool biomeColored = isBiomeColored(type);
+		const bool isWater = (type == WATER);
+		const std::array<uint16_t, BiomeColorField::SIZE * BiomeColorField::SIZE> &colors =
+			(type == OAK_LEAVES) ? input.colors->foliage : input.colors->grass;
+
+		uint32_t ao[4];
+		uint16_t cornerColors[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			const glm::ivec3 &pos = corners[i];
+			ao[i] = cornerAO(types, d, u, v, positive, pos, i);
+			cornerColors[i] = isWater ? WATER_COLOR : 0;
+			if (biomeColored)
+				cornerColors[i] = colors[pos.z * BiomeColorField::SIZE + pos.x];
+		}
+		(isWater ? out.waterQuads : out.quads)
+			.push_back(ChunkQuad::pack(start, face, ao, size[u], size[v], texture, biomeColored || isWater, cornerColors));
+	}
+
+	/// Greedy-merges the faces of one plane and emits them. Rows run along
+	/// rowAxis over [rowBegin, rowEnd); bit b of a row is voxel b along bitAxis.
+	void meshPlane(const ChunkMeshInput &input, MeshWorkspace &ws, SectionMesh &out, int face, int slice,
+				   int rowAxis, int bitAxis, uint32_t *rows, int rowBegin, int rowEnd)
+	{
+		const int normalAxis = face / 2;
+		const uint8_t *types = ws.types.data();
+
+		auto voxelAt = [&](int row, int bit)
+		{
+			glm::ivec3 c;
+			c[normalAxis] = slice;
+			c[rowAxis] = row;
+			c[bitAxis] = bit;
+			return c;
+		};
+		auto typeAt = [&](const glm::ivec3 &c)
+		{ return static_cast<TextureType>(types[typeIndex(c.x, c.y, c.z)]); };
+
+		for (int row = rowBegin; row < rowEnd; ++row)
+		{
+			while (rows[row] != 0)
+			{
+				const int bit = std::countr_zero(rows[row]);
+				const glm::ivec3 owner = voxelAt(row, bit);
+				const TextureType type = typeAt(owner);
+
+				// Vertices take the colour of the column corner they sit on, so a
+				// coloured quad may only grow along its own column (i.e. along Y)
+				// or over columns whose corners all hold that column's colour
+				const bool colored = isBiomeColored(type);
+				const std::array<int32_t, CHUNK_SIZE * CHUNK_SIZE> &flat = (type == OAK_LEAVES) ? ws.flatFoliage : ws.flatGrass;
+				const int32_t ownerColor = colored ? flat[owner.z * CHUNK_SIZE + owner.x] : 0;
+				auto mergeable = [&](const glm::ivec3 &c)
+				{
+					if (typeAt(c) != type)
+						return false;
+					if (!colored || (c.x == owner.x && c.z == owner.z))
+						return true;
+					return ownerColor >= 0 && flat[c.z * CHUNK_SIZE + c.x] == ownerColor;
+				};
+
+				int width = 1;
+				while (bit + width < CHUNK_SIZE && (rows[row] >> (bit + width) & 1) && mergeable(voxelAt(row, bit + width)))
+					++width;
+				const uint32_t run = ((1u << width) - 1) << bit;
+
+				int height = 1;
+				for (; row + height < rowEnd && (rows[row + height] & run) == run; ++height)
+				{
+					int k = 0;
+					while (k < width && mergeable(voxelAt(row + height, bit + k)))
+						++k;
+					if (k < width)
+						break;
+				}
+				for (int i = 0; i < height; ++i)
+					rows[row + i] &= ~run;
+
+				glm::ivec3 size(1);
+				size[rowAxis] = height;
+				size[bitAxis] = width;
+				emitQuad(input, types, out, face, owner, size, type);
+			}
+		}
+	}
+
+	/// Layers [first, second) of a section that may show faces: none for an
+	/// empty section or a solid one whose every neighbour voxel is opaque,
+	/// else the section without the all-air layers at either end
+	std::pair<int, int> sectionLayers(const ChunkMeshInput &input, int s)
+	{
+		const ChunkSections &sections = *input.sections;
+		const ChunkSection &section = sections[s];
+		const int bottom = s * SECTION_SIZE;
+		if (section.isEmpty())
+			return {bottom, bottom};
+
+		const std::array<uint8_t, 256> &kinds = typeKinds();
+		auto allOpaque = [&kinds](const uint8_t *types, int count, int stride)
+		{
+			for (int i = 0; i < count; ++i)
+				if (!(kinds[types[i * stride]] & 2))
+					return false;
+			return true;
+		};
+		// Layer y (-1 and CHUNK_HEIGHT: the shell) is opaque over the section's columns
+		auto layerOpaque = [&](int y)
+		{
+			if (y < 0 || y >= CHUNK_HEIGHT)
+			{
+				if (!input.shell)
+					return false;
+				for (int z = 0; z < CHUNK_SIZE; ++z)
+					if (!allOpaque(input.shell + typeIndex(0, y, z), CHUNK_SIZE, 1))
+						return false;
+				return true;
+			}
+			const ChunkSection &other = sections[y / SECTION_SIZE];
+			if (other.isSolid())
+				return true;
+			uint8_t layer[ChunkSection::LAYER];
+			other.decodeLayer(y % SECTION_SIZE, layer);
+			return allOpaque(layer, ChunkSection::LAYER, 1);
+		};
+		auto enclosed = [&]()
+		{
+			if (!section.isSolid() || !input.shell || !layerOpaque(bottom - 1) || !layerOpaque(bottom + SECTION_SIZE))
+				return false;
+			for (int y = bottom; y < bottom + SECTION_SIZE; ++y)
+			{
+				if (!allOpaque(input.shell + typeIndex(-1, y, 0), CHUNK_SIZE, PAD) ||
+					!allOpaque(input.shell + typeIndex(CHUNK_SIZE, y, 0), CHUNK_SIZE, PAD) ||
+					!allOpaque(input.shell + typeIndex(0, y, -1), CHUNK_SIZE, 1) ||
+					!allOpaque(input.shell + typeIndex(0, y, CHUNK_SIZE), CHUNK_SIZE, 1))
+					return false;
+			}
+			return true;
+		};
+		if (enclosed())
+			return {bottom, bottom};
+		if (section.isUniform())
+			return {bottom, bottom + SECTION_SIZE};
+
+		auto layerEmpty = [&section](int y)
+		{
+			uint8_t layer[ChunkSection::LAYER];
+			section.decodeLayer(y, layer);
+			uint64_t differ = 0;
+			for (int i = 0; i < ChunkSection::LAYER; i += 8)
+			{
+				uint64_t word;
+				std::memcpy(&word, layer + i, 8);
+				differ |= word ^ AIR_BYTES;
+			}
+			return differ == 0;
+		};
+		int first = 0;
+		int last = SECTION_SIZE - 1;
+		while (layerEmpty(last))
+			--last;
+		while (layerEmpty(first))
+			++first;
+		return {bottom + first, bottom + last + 1};
+	}
+
+	/// Meshes the sections of `sections` into outputs[s], which are already
+	/// cleared. Rows are built once for every layer those sections need
+	void meshSections(const ChunkMeshInput &input, uint32_t sections, const std::array<SectionMesh *, SECTION_COUNT> &outputs)
+	{
+		// Layers that may show faces, per section. Rows are only built for them
+		// and the layer on either side, and only those are copied into the
+		// padded types
+		std::array<std::pair<int, int>, SECTION_COUNT> ranges{};
+		std::array<bool, PAD_HEIGHT> needed{}; // Padded layer y + 1
+		bool any = false;
+		for (uint32_t rest = sections; rest != 0; rest &= rest - 1)
+		{
+			const int section = std::countr_zero(rest);
+			ranges[section] = sectionLayers(input, section);
+			const auto [begin, end] = ranges[section];
+			if (begin == end)
+				continue;
+			std::fill(needed.begin() + begin, needed.begin() + end + 2, true); // Layers begin - 1 to end
+			any = true;
+		}
+		if (!any)
+			return;
+
+		MeshWorkspace &ws = workspace();
+		uint8_t *types = ws.types.data();
+		const std::array<uint8_t, 256> &kinds = typeKinds();
+		for (int y = -1; y <= CHUNK_HEIGHT; ++y)
+		{
+			if (!needed[y + 1])
+				continue;
+
+			// Padded types: the shell layer, then the chunk's rows over its interior
+			uint8_t *padded = types + static_cast<size_t>(y + 1) * PAD_LAYER;
+			if (input.shell)
+				std::memcpy(padded, input.shell + static_cast<size_t>(y + 1) * PAD_LAYER, PAD_LAYER);
+			else
+				std::fill_n(padded, PAD_LAYER, static_cast<uint8_t>(AIR));
+			if (y >= 0 && y < CHUNK_HEIGHT)
+			{
+				uint8_t layer[ChunkSection::LAYER];
+				(*input.sections)[y / SECTION_SIZE].decodeLayer(y % SECTION_SIZE, layer);
+				for (int z = 0; z < CHUNK_SIZE; ++z)
+					std::memcpy(types + typeIndex(0, y, z), layer + z * CHUNK_SIZE, CHUNK_SIZE);
+			}
+
+			// Occupancy rows, eight voxels per kind bit at a time. Most rows hold a
+			// single type (air above the ground, stone below it) and skip the gather
+			for (int z = -1; z <= CHUNK_SIZE; ++z)
+			{
+				const uint8_t *row = types + typeIndex(-1, y, z);
+				RowMasks &masks = ws.rows[(y + 1) * PAD + (z + 1)];
+
+				uint64_t low;
+				uint64_t high;
+				std::memcpy(&low, row + 1, 8);
+				std::memcpy(&high, row + 9, 8);
+				const uint64_t firstBytes = 0x0101010101010101ull * row[0];
+				if (low == firstBytes && high == firstBytes && row[PAD - 1] == row[0])
+				{
+					const uint8_t kind = kinds[row[0]];
+					auto fill = [kind](int bit)
+					{ return ((kind >> bit) & 1) ? PAD_BITS : 0u; };
+					masks = {fill(0), fill(1), fill(2), fill(3)};
+					continue;
+				}
+
+				uint8_t rowKinds[PAD];
+				for (int i = 0; i < PAD; ++i)
+					rowKinds[i] = kinds[row[i]];
+				std::memcpy(&low, rowKinds + 1, 8);
+				std::memcpy(&high, rowKinds + 9, 8);
+				auto gather = [&](int bit)
+				{
+					return static_cast<uint32_t>((rowKinds[0] >> bit) & 1) | (gatherBits(low, bit) << 1) |
+						   (gatherBits(high, bit) << 9) | (static_cast<uint32_t>((rowKinds[PAD - 1] >> bit) & 1) << (PAD - 1));
+				};
+				masks = {gather(0), gather(1), gather(2), gather(3)};
+			}
+		}
+
+		// Visible faces of every row. X faces come from the row against itself
+		// shifted by one voxel, and are scattered into their [x][y] planes
+		for (uint32_t remaining = sections; remaining != 0; remaining &= remaining - 1)
+		{
+			const auto [begin, end] = ranges[std::countr_zero(remaining)];
+			for (int x = 0; x < CHUNK_SIZE; ++x)
+			{
+				std::fill(ws.faces[POS_X].begin() + x * CHUNK_HEIGHT + begin, ws.faces[POS_X].begin() + x * CHUNK_HEIGHT + end, 0u);
+				std::fill(ws.faces[NEG_X].begin() + x * CHUNK_HEIGHT + begin, ws.faces[NEG_X].begin() + x * CHUNK_HEIGHT + end, 0u);
+			}
+			for (int y = begin; y < end; ++y)
+			{
+				for (int z = 0; z < CHUNK_SIZE; ++z)
+				{
+					const RowMasks &row = ws.rows[(y + 1) * PAD + (z + 1)];
+					ws.faces[POS_Y][y * CHUNK_SIZE + z] = visibleFaces(row, ws.rows[(y + 2) * PAD + (z + 1)]);
+					ws.faces[NEG_Y][y * CHUNK_SIZE + z] = visibleFaces(row, ws.rows[y * PAD + (z + 1)]);
+					ws.faces[POS_Z][z * CHUNK_HEIGHT + y] = visibleFaces(row, ws.rows[(y + 1) * PAD + (z + 2)]);
+					ws.faces[NEG_Z][z * CHUNK_HEIGHT + y] = visibleFaces(row, ws.rows[(y + 1) * PAD + z]);
+
+					const uint32_t zBit = 1u << z;
+					for (int dir : {POS_X, NEG_X})
+					{
+						uint32_t bits = visibleFaces(row, row.neighbours(dir == POS_X ? 1 : -1));
+						while (bits != 0)
+						{
+							const int x = std::countr_zero(bits);
+							bits &= bits - 1;
+							ws.faces[dir][x * CHUNK_HEIGHT + y] |= zBit;
+						}
+					}
+				}
+			}
+		}
+
+		fillFlatColors(input.colors->grass, ws.flatGrass);
+		fillFlatColors(input.colors->foliage, ws.flatFoliage);
+
+		// Each section on its own: the X and Z planes' rows and the Y planes stop
+		// at its boundaries
+		while (sections != 0)
+		{
+			const int section = std::countr_zero(sections);
+			sections &= sections - 1;
+			const auto [begin, end] = ranges[section];
+			SectionMesh &out = *outputs[section];
+			for (int x = 0; x < CHUNK_SIZE && begin < end; ++x)
+			{
+				meshPlane(input, ws, out, POS_X, x, 1, 2, ws.faces[POS_X].data() + x * CHUNK_HEIGHT, begin, end);
+				meshPlane(input, ws, out, NEG_X, x, 1, 2, ws.faces[NEG_X].data() + x * CHUNK_HEIGHT, begin, end);
+			}
+			for (int y = begin; y < end; ++y)
+			{
+				meshPlane(input, ws, out, POS_Y, y, 2, 0, ws.faces[POS_Y].data() + y * CHUNK_SIZE, 0, CHUNK_SIZE);
+				meshPlane(input, ws, out, NEG_Y, y, 2, 0, ws.faces[NEG_Y].data() + y * CHUNK_SIZE, 0, CHUNK_SIZE);
+			}
+			for (int z = 0; z < CHUNK_SIZE && begin < end; ++z)
+			{
+				meshPlane(input, ws, out, POS_Z, z, 1, 0, ws.faces[POS_Z].data() + z * CHUNK_HEIGHT, begin, end);
+				meshPlane(input, ws, out, NEG_Z, z, 1, 0, ws.faces[NEG_Z].data() + z * CHUNK_HEIGHT, begin, end);
+			}
+		}
+	}
+}
+
+void buildChunkMesh(const ChunkMeshInput &input, std::vector<ChunkQuad> &quads, std::vector<ChunkQuad> &waterQuads)
+{
+	// Every section into one mesh, in the caller's vectors (capacity kept)
+	SectionMesh out;
+	out.quads.swap(quads);
+	out.waterQuads.swap(waterQuads);
+	out.quads.clear();
+	out.waterQuads.clear();
+	std::array<SectionMesh *, SECTION_COUNT> outputs;
+	outputs.fill(&out);
+	meshSections(input, ALL_SECTIONS, outputs);
+	quads.swap(out.quads);
+	waterQuads.swap(out.waterQuads);
+}
+
+void buildSectionMeshes(const ChunkMeshInput &input, uint32_t sections, SectionMeshes &meshes)
+{
+	sections &= ALL_SECTIONS;
+	std::array<SectionMesh *, SECTION_COUNT> outputs{};
+	for (uint32_t rest = sections; rest != 0; rest &= rest - 1)
+	{
+		SectionMesh &mesh = meshes[std::countr_zero(rest)];
+		mesh.quads.clear();
+		mesh.waterQuads.clear();
+		outputs[std::countr_zero(rest)] = &mesh;
+	}
+	meshSections(input, sections, outputs);
+	for (uint32_t rest = sections; rest != 0; rest &= rest - 1)
+	{
+		SectionMesh &mesh = meshes[std::countr_zero(rest)];
+		sortWaterQuads(mesh.waterQuads, mesh.waterPlanes);
+	}
+}
+
+void sortWaterQuads(std::vector<ChunkQuad> &waterQuads, std::vector<WaterPlane> &planes)
+{
+	// Normal, then the corner coordinate along its axis: the plane of the face
+	auto key = [](const ChunkQuad &quad)
+	{
+		const uint32_t normal = quad.normal();
+		return (normal << 9) | static_cast<uint32_t>(quad.start()[static_cast<int>(normal >> 1)]);
+	};
+	std::stable_sort(waterQuads.begin(), waterQuads.end(), [&key](const ChunkQuad &a, const ChunkQuad &b)
+					 { return key(a) < key(b); });
+
+	planes.clear();
+	for (size_t i = 0; i < waterQuads.size(); ++i)
+	{
+		const uint32_t k = key(waterQuads[i]);
+		if (planes.empty() || ((static_cast<uint32_t>(planes.back().normal) << 9) | planes.back().plane) != k)
+			planes.push_back({static_cast<uint16_t>(i), 0, static_cast<uint16_t>(k & 0x1FFu), static_cast<uint8_t>(k >> 9)});
+		++planes.back().count;
+	}
+}
+
+uint32_t sectionsTouchedBy(int y)
+{
+	const int below = std::max(y - 1, 0) / SECTION_SIZE;
+	const int above = std::min(y + 1, CHUNK_HEIGHT - 1) / SECTION_SIZE;
+	uint32_t sections = 0;
+	for (int section = below; section <= above; ++section)
+		sections |= 1u << section;
+	return sections;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <Chunk/BiomeColorField.hpp>
+#include <Chunk/ChunkSection.hpp>
+#include <utils.hpp>
+
+/// RGB565 water tint (77, 128, 230) shared by the full mesh and LOD mesh generators.
+inline constexpr uint16_t WATER_COLOR = 0x4C1C;
+
+/// What buildChunkMesh() reads: a chunk's voxels and the 1-voxel shell of its
+/// neighbours, laid out like Chunk's.
+struct ChunkMeshInput
+{
+	const ChunkSections *sections; // The chunk's voxels
+	const uint8_t *shell;		   // 18 x (CHUNK_HEIGHT + 2) x 18 TextureType values, or null for all air
+	const BiomeColorField *colors; // Grass and leaves colours
+};
+
+/// Water quads [first, first + count) of a section mesh, which all face
+/// `normal` (0: +X, 1: -X, 2: +Y, 3: -Y, 4: +Z, 5: -Z) and lie on the plane at
+/// chunk coordinate `plane` along its axis
+struct WaterPlane
+{
+	uint16_t first;
+	uint16_t count;
+	uint16_t plane;
+	uint8_t normal;
+};
+
+/// Quads of one section of a chunk (see SECTION_SIZE)
+struct SectionMesh
+{
+	std::vector<ChunkQuad> quads;	   // Opaque and glass
+	std::vector<ChunkQuad> waterQuads; // In sortWaterQuads() order
+	std::vector<WaterPlane> waterPlanes;
+};
+using SectionMeshes = std::array<SectionMesh, SECTION_COUNT>;
+
+/// Greedy mesh of a chunk: opaque and glass quads in quads, water quads in
+/// waterQuads (see ChunkQuad). The output vectors are cleared first. The mesh
+/// is the concatenation of the chunk's section meshes (buildSectionMeshes()).
+///
+/// Binary mesher. One pass over the voxels and the shell builds 18-bit
+/// occupancy rows along X (solid, opaque, and which transparent type); the
+/// visible faces of a whole row then come out of a few AND/NOT operations
+/// against the row above, below, in front, behind, or itself shifted by one,
+/// and faces are merged by scanning set bits. Voxel types are only read for
+/// faces that are actually visible. Empty sections, solid sections whose
+/// neighbour voxels are all opaque, and the all-air layers at either end of a
+/// section are skipped.
+///
+/// A face shows when its voxel is not air and the neighbour it faces is air,
+/// or a transparent voxel of another type. Only voxels of the chunk emit
+/// faces; the shell is only looked at. Quads only merge faces of the same
+/// type and, for biome-coloured types, of a flat colour (see
+/// BiomeColorField).
+void buildChunkMesh(const ChunkMeshInput &input, std::vector<ChunkQuad> &quads, std::vector<ChunkQuad> &waterQuads);
+
+/// Meshes only the sections in `sections` (bit s: section s) into their entry
+/// of `meshes`, cleared first; the other entries are left alone. Quads never
+/// cross a section boundary, so a section's mesh only depends on its own
+/// layers and the layer on either side of it. Water quads come out sorted
+/// (sortWaterQuads()).
+void buildSectionMeshes(const ChunkMeshInput &input, uint32_t sections, SectionMeshes &meshes);
+
+/// Orders water quads by normal, then by plane, and lists the runs that share
+/// both in `planes`, in the same order. Each run is then one index range of
+/// the uploaded mesh, and blending is drawn back to front by picking the
+/// order of the runs from the camera position, without touching the buffer:
+/// quads of one plane never overlap one another.
+void sortWaterQuads(std::vector<ChunkQuad> &waterQuads, std::vector<WaterPlane> &planes);
+
+/// Sections whose mesh changes when the voxel at layer y does: its own, and
+/// the one above or below when y is next to them (faces and ambient occlusion
+/// look one layer away).
+uint32_t sectionsTouchedBy(int y);
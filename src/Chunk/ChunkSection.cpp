@@ -0,0 +1,235 @@
+#include "ChunkSection.hpp"
+
+#include <Renderer/TextureManager.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+static_assert(ChunkSection::VOLUME <= UINT16_MAX, "Voxel counts are 16-bit");
+static_assert(sizeof(Voxel) == 1, "Voxels are read as bytes");
+
+namespace
+{
+	bool isClear(uint8_t type)
+	{
+		return type == AIR || TextureManager::isTransparent(static_cast<TextureType>(type));
+	}
+
+	/// Fewest bits per voxel for `types` palette entries
+	int bitsFor(int types)
+	{
+		if (types <= 2)
+			return 1;
+		if (types <= 4)
+			return 2;
+		return types <= 16 ? 4 : 8;
+	}
+
+	template <int BITS>
+	void decode(const uint8_t *indices, const uint8_t *palette, uint8_t *out, int count)
+	{
+		constexpr int PER_BYTE = 8 / BITS;
+		constexpr uint8_t MASK = (1 << BITS) - 1;
+		for (int i = 0; i < count / PER_BYTE; ++i)
+		{
+			const uint8_t byte = indices[i];
+			for (int k = 0; k < PER_BYTE; ++k)
+				out[i * PER_BYTE + k] = palette[(byte >> (k * BITS)) & MASK];
+		}
+	}
+}
+
+ChunkSection::Block::Block(int bits)
+	: bits(bits), mask(static_cast<uint8_t>((1 << bits) - 1)),
+	  storage(std::make_unique<uint8_t[]>((1 << bits) + VOLUME * bits / 8)),
+	  palette(storage.get()), indices(storage.get() + (1 << bits))
+{
+}
+
+void ChunkSection::Block::setIndex(int i, uint8_t value)
+{
+	const int bit = i * bits;
+	uint8_t &byte = indices[bit >> 3];
+	byte = static_cast<uint8_t>((byte & ~(mask << (bit & 7))) | (value << (bit & 7)));
+}
+
+size_t ChunkSection::Block::bytes() const
+{
+	return sizeof(Block) + (1 << bits) + VOLUME * bits / 8;
+}
+
+ChunkSection::~ChunkSection()
+{
+	delete m_block.load();
+}
+
+ChunkSection::ChunkSection(ChunkSection &&other) noexcept
+	: m_block(other.m_block.exchange(nullptr)), m_airCount(other.m_airCount),
+	  m_clearCount(other.m_clearCount), m_fill(other.m_fill)
+{
+	other.fill(AIR);
+}
+
+ChunkSection &ChunkSection::operator=(ChunkSection &&other) noexcept
+{
+	if (this != &other)
+	{
+		delete m_block.exchange(other.m_block.exchange(nullptr));
+		m_airCount = other.m_airCount;
+		m_clearCount = other.m_clearCount;
+		m_fill = other.m_fill;
+		other.fill(AIR);
+	}
+	return *this;
+}
+
+ChunkSection::Kind ChunkSection::kind() const
+{
+	if (isEmpty())
+		return Kind::EMPTY;
+	return isUniform() ? Kind::UNIFORM : Kind::MIXED;
+}
+
+int ChunkSection::indexBits() const
+{
+	const Block *block = m_block.load();
+	return block ? block->bits : 0;
+}
+
+void ChunkSection::set(int x, int y, int z, uint8_t type)
+{
+	const uint8_t previous = get(x, y, z);
+	if (previous == type)
+		return;
+
+	Block *block = m_block.load();
+	if (!block)
+	{
+		// Every index 0: the fill type until the voxel is written below
+		block = new Block(1);
+		block->palette[0] = m_fill;
+		block->paletteSize = 1;
+		m_block.store(block, std::memory_order_release);
+	}
+
+	int entry = 0;
+	while (entry < block->paletteSize && block->palette[entry] != type)
+		++entry;
+	if (entry == block->paletteSize)
+	{
+		if (entry == 1 << block->bits)
+		{
+			auto grown = std::make_unique<Block>(block->bits * 2);
+			std::memcpy(grown->palette, block->palette, block->paletteSize);
+			grown->paletteSize = block->paletteSize;
+			for (int i = 0; i < VOLUME; ++i)
+			{
+				const int bit = i * block->bits;
+				grown->setIndex(i, (block->indices[bit >> 3] >> (bit & 7)) & block->mask);
+			}
+			grown->retired.reset(block);
+			block = grown.release();
+			m_block.store(block, std::memory_order_release);
+		}
+		block->palette[entry] = type;
+		++block->paletteSize;
+	}
+	block->setIndex(index(x, y, z), static_cast<uint8_t>(entry));
+
+	m_airCount += (type == AIR) - (previous == AIR);
+	m_clearCount += isClear(type) - isClear(previous);
+}
+
+void ChunkSection::assign(const Voxel *voxels)
+{
+	std::array<int, 256> entries;
+	entries.fill(-1);
+	uint8_t palette[256];
+	int types = 0;
+	int air = 0;
+	int clear = 0;
+	for (int i = 0; i < VOLUME; ++i)
+	{
+		const uint8_t type = voxels[i].type;
+		if (entries[type] < 0)
+		{
+			entries[type] = types;
+			palette[types++] = type;
+		}
+		air += type == AIR;
+		clear += isClear(type);
+	}
+
+	if (types == 1)
+	{
+		fill(palette[0]);
+		return;
+	}
+	auto block = std::make_unique<Block>(bitsFor(types));
+	std::memcpy(block->palette, palette, types);
+	block->paletteSize = types;
+	std::memset(block->indices, 0, VOLUME * block->bits / 8);
+	for (int i = 0; i < VOLUME; ++i)
+	{
+		const int bit = i * block->bits;
+		block->indices[bit >> 3] |= static_cast<uint8_t>(entries[voxels[i].type] << (bit & 7));
+	}
+	delete m_block.exchange(block.release());
+	m_airCount = static_cast<uint16_t>(air);
+	m_clearCount = static_cast<uint16_t>(clear);
+}
+
+void ChunkSection::fill(uint8_t type)
+{
+	delete m_block.exchange(nullptr);
+	m_fill = type;
+	m_airCount = type == AIR ? VOLUME : 0;
+	m_clearCount = isClear(type) ? VOLUME : 0;
+}
+
+void ChunkSection::decodeLayer(int y, uint8_t *out) const
+{
+	const Block *block = m_block.load(std::memory_order_acquire);
+	if (!block)
+	{
+		std::memset(out, m_fill, LAYER);
+		return;
+	}
+
+	// A layer starts on a byte: LAYER indices fill whole bytes at any width
+	const uint8_t *indices = block->indices + y * LAYER * block->bits / 8;
+	switch (block->bits)
+	{
+	case 1:
+		decode<1>(indices, block->palette, out, LAYER);
+		break;
+	case 2:
+		decode<2>(indices, block->palette, out, LAYER);
+		break;
+	case 4:
+		decode<4>(indices, block->palette, out, LAYER);
+		break;
+	default:
+		for (int i = 0; i < LAYER; ++i)
+			out[i] = block->palette[indices[i]];
+		break;
+	}
+}
+
+void ChunkSection::releaseRetired()
+{
+	if (Block *block = m_block.load())
+		block->retired.reset();
+}
+
+size_t ChunkSection::storageBytes() const
+{
+	const Block *block = m_block.load();
+	return block ? block->bytes() : 0;
+}
+
+void assignSections(ChunkSections &sections, const Voxel *voxels)
+{
+	for (int s = 0; s < SECTION_COUNT; ++s)
+		sections[s].assign(voxels + s * ChunkSection::VOLUME);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <utils.hpp>
+
+/// SECTION_SIZE layers of a chunk's voxels. A section of one type alone (all
+/// air above the ground) keeps that type and nothing else; the others keep a
+/// palette of the types they hold and, for every voxel, its index in the
+/// palette on 1, 2, 4 or 8 bits (up to 2, 4, 16 or 256 types), indexed y, z,
+/// x like Chunk's.
+///
+/// It also counts its air voxels and the voxels light goes through (air and
+/// transparent types), so that empty sections and solid ones, which can only
+/// show faces on their boundary, are known without looking at the voxels.
+///
+/// set() runs on the main thread while a mesh task may be reading the
+/// section. The indices are published with their palette in one block, and a
+/// block outgrown by set() is kept until releaseRetired(), so a reader never
+/// sees them freed; it may read a stale voxel, which the edit re-meshes anyway.
+class ChunkSection
+{
+public:
+	static constexpr int LAYER = CHUNK_SIZE * CHUNK_SIZE;
+	static constexpr int VOLUME = LAYER * SECTION_SIZE;
+
+	enum class Kind : uint8_t
+	{
+		EMPTY,	 // Air only
+		UNIFORM, // One other type only
+		MIXED
+	};
+
+	ChunkSection() = default;
+	~ChunkSection();
+	ChunkSection(ChunkSection &&other) noexcept;
+	ChunkSection &operator=(ChunkSection &&other) noexcept;
+	ChunkSection(const ChunkSection &) = delete;
+	ChunkSection &operator=(const ChunkSection &) = delete;
+
+	Kind kind() const;
+	bool isEmpty() const { return m_airCount == VOLUME; }
+	/// Every voxel is opaque
+	bool isSolid() const { return m_clearCount == 0; }
+	/// Every voxel is fillType()
+	bool isUniform() const { return m_block.load(std::memory_order_acquire) == nullptr; }
+	uint8_t fillType() const { return m_fill; }
+	/// Bits per voxel: 0 when uniform, else 1, 2, 4 or 8
+	int indexBits() const;
+
+	uint8_t get(int x, int y, int z) const
+	{
+		const Block *block = m_block.load(std::memory_order_acquire);
+		return block ? block->get(index(x, y, z)) : m_fill;
+	}
+	/// A uniform section becomes mixed, and a section out of palette entries
+	/// doubles its bits per voxel. Neither shrinks back before assign().
+	void set(int x, int y, int z, uint8_t type);
+	/// Copies VOLUME voxels in, on as few bits as their types need; uniform
+	/// when they are all one type
+	void assign(const Voxel *voxels);
+	void fill(uint8_t type);
+	/// Decodes the CHUNK_SIZE x CHUNK_SIZE types of layer y, indexed z, x
+	void decodeLayer(int y, uint8_t *out) const;
+	/// Frees the blocks set() outgrew. Only while nothing reads the section
+	/// from another thread.
+	void releaseRetired();
+
+	/// Bytes of voxel storage: palette and indices when mixed, none otherwise
+	size_t storageBytes() const;
+
+private:
+	struct Block
+	{
+		explicit Block(int bits);
+
+		uint8_t get(int i) const
+		{
+			const int bit = i * bits;
+			return palette[(indices[bit >> 3] >> (bit & 7)) & mask];
+		}
+		void setIndex(int i, uint8_t value);
+		size_t bytes() const;
+
+		int bits;
+		uint8_t mask;
+		int paletteSize = 0;
+		std::unique_ptr<uint8_t[]> storage; // Palette (1 << bits entries), then indices
+		uint8_t *palette;
+		uint8_t *indices;
+		std::unique_ptr<Block> retired; // The block this one replaced, see releaseRetired()
+	};
+
+	static int index(int x, int y, int z) { return (y * CHUNK_SIZE + z) * CHUNK_SIZE + x; }
+
+	std::atomic<Block *> m_block{nullptr}; // Owned; null when uniform
+	uint16_t m_airCount = VOLUME;
+	uint16_t m_clearCount = VOLUME; // Air and transparent voxels
+	uint8_t m_fill = AIR;
+};
+
+using ChunkSections = std::array<ChunkSection, SECTION_COUNT>;
+
+/// Splits CHUNK_VOLUME voxels, indexed y, z, x, into sections
+void assignSections(ChunkSections &sections, const Voxel *voxels);
@@ -0,0 +1,135 @@
+#include "ColumnFill.hpp"
+#include "TerrainGenerator.hpp"
+
+#include <algorithm>
+
+const CarveThresholds CarveThresholds::table = []
+{
+	CarveThresholds t;
+	for (int y = 0; y < CHUNK_HEIGHT; ++y)
+	{
+		float heightRatio = std::clamp(static_cast<float>(y - TerrainGenerator::SEA_LEVEL) / 64.0f, 0.0f, 1.0f);
+		t.cave[y] = 0.6f + heightRatio * 0.35f;
+		t.ravine[y] = 0.8f + heightRatio * 0.15f;
+	}
+	return t;
+}();
+
+// Y values classified per step. Every per-lane statement below is a plain
+// select so the compiler can keep the whole step in vector registers.
+static constexpr int FILL_LANES = 16;
+static_assert(CHUNK_HEIGHT % FILL_LANES == 0, "CHUNK_HEIGHT must be a multiple of FILL_LANES");
+
+// getVoxelTypeAt() branches flattened per biome. Index [1] is the variant used
+// at or below SEA_LEVEL + 2, where non-stone layers turn into underwaterBlock.
+struct BiomeLayers
+{
+	uint8_t surface[2];
+	uint8_t subsurface[2];
+	bool surfaceFloods; // surface[1] replaces the surface block, snow included
+	float subsurfaceLimit; // Density below which the subsurface block is used
+	bool snowy;
+	bool frozenSea;
+};
+
+static const std::array<BiomeLayers, BIOME_COUNT> &biomeLayers()
+{
+	static const std::array<BiomeLayers, BIOME_COUNT> layers = []
+	{
+		std::array<BiomeLayers, BIOME_COUNT> table{};
+		for (int b = 0; b < BIOME_COUNT; ++b)
+		{
+			const BiomeType biome = static_cast<BiomeType>(b);
+			const BiomeConfig &config = TerrainGenerator::getBiomeConfig(biome);
+			BiomeLayers &l = table[b];
+			l.surface[0] = static_cast<uint8_t>(config.surfaceBlock);
+			l.surfaceFloods = config.surfaceBlock != STONE;
+			l.surface[1] = static_cast<uint8_t>(l.surfaceFloods ? config.underwaterBlock : config.surfaceBlock);
+			l.subsurface[0] = static_cast<uint8_t>(config.subsurfaceBlock);
+			l.subsurface[1] = static_cast<uint8_t>(config.subsurfaceBlock != STONE ? config.underwaterBlock : config.subsurfaceBlock);
+			l.subsurfaceLimit = static_cast<float>(config.subsurfaceDepth + 1);
+			l.snowy = biome == BIOME_MOUNTAINS || biome == BIOME_SNOWY_MOUNTAINS || config.hasSnow;
+			l.frozenSea = biome == BIOME_FROZEN_OCEAN;
+		}
+		return table;
+	}();
+	return layers;
+}
+
+int fillColumn(const ColumnFillInput &column, uint8_t *out)
+{
+	const BiomeLayers &layers = biomeLayers()[column.biome];
+	const bool isMountain = column.biome == BIOME_MOUNTAINS || column.biome == BIOME_SNOWY_MOUNTAINS;
+	const int seaLevel = TerrainGenerator::SEA_LEVEL;
+
+	// Snow is only possible on the surface layer of snowy biomes; otherwise the
+	// threshold is out of reach.
+	float snowThreshold = static_cast<float>(CHUNK_HEIGHT);
+	if (layers.snowy)
+	{
+		float snowLine = 160.0f + column.temperature * 10.0f;
+		uint32_t hash = ((uint32_t)column.worldX * 374761393 + (uint32_t)column.worldZ * 668265263) ^ (uint32_t)column.seed;
+		float dither = static_cast<float>(hash & 0xFFFF) / 65535.0f;
+		snowThreshold = snowLine + (dither - 0.5f) * 15.0f;
+	}
+
+	int maxSolidY = 0;
+	for (int y0 = 0; y0 < CHUNK_HEIGHT; y0 += FILL_LANES)
+	{
+		float density[FILL_LANES];
+		float caveVal[FILL_LANES];
+		float ravineVal[FILL_LANES];
+
+		for (int l = 0; l < FILL_LANES; ++l)
+		{
+			// Clamped so lanes outside the slab still read valid memory; their
+			// value is never used.
+			const int caveY = std::clamp(y0 + l, column.caveMinY, column.caveMaxY) - column.caveMinY;
+			caveVal[l] = column.cave[caveY * column.caveStride];
+			ravineVal[l] = column.ravine[caveY * column.caveStride];
+			density[l] = static_cast<float>(column.height - (y0 + l));
+		}
+
+		// Mountain overhangs: perturb the density near the heightmap surface
+		if (isMountain)
+		{
+			for (int l = 0; l < FILL_LANES; ++l)
+			{
+				const int surfaceY = std::clamp(y0 + l, column.surfaceMinY, column.surfaceMaxY) - column.surfaceMinY;
+				const float surface3DVal = column.surface3D[surfaceY * column.surfaceStride];
+				const float d = density[l];
+				const float blend = std::max(0.0f, 1.0f - std::abs(d) / 12.0f);
+				density[l] = (d > -8.0f && d < 12.0f) ? d + surface3DVal * 8.0f * blend : d;
+			}
+		}
+
+		for (int l = 0; l < FILL_LANES; ++l)
+		{
+			const int y = y0 + l;
+			const float d = density[l];
+			// getVoxelTypeAt() treats exactly -1 as "no density given" and falls
+			// back to the unperturbed one
+			const float typeDensity = d == -1.0f ? static_cast<float>(column.height - y) : d;
+			const int low = y <= seaLevel + 2 ? 1 : 0;
+
+			const uint8_t surface = (low && layers.surfaceFloods) ? layers.surface[1]
+									: (static_cast<float>(y) > snowThreshold ? static_cast<uint8_t>(SNOW) : layers.surface[0]);
+			const uint8_t solid = typeDensity < 1.0f ? surface
+								  : (typeDensity < layers.subsurfaceLimit ? layers.subsurface[low] : static_cast<uint8_t>(STONE));
+			const uint8_t fluid = y > seaLevel ? static_cast<uint8_t>(AIR)
+								  : ((layers.frozenSea && y == seaLevel) ? static_cast<uint8_t>(GLASS) : static_cast<uint8_t>(WATER));
+
+			uint8_t type = typeDensity >= 0.0f ? solid : fluid;
+			type = y <= TerrainGenerator::BEDROCK_LEVEL ? static_cast<uint8_t>(BEDROCK) : type;
+
+			// Carving follows the density itself, not the -1 fallback above
+			const bool carved = d >= 0.0f && type != BEDROCK && type != WATER &&
+								(caveVal[l] > CarveThresholds::table.cave[y] || ravineVal[l] > CarveThresholds::table.ravine[y]);
+			type = carved ? static_cast<uint8_t>(AIR) : type;
+
+			out[y] = type;
+			maxSolidY = (type != AIR && type != WATER) ? y : maxSolidY;
+		}
+	}
+	return maxSolidY;
+}
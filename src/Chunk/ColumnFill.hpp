@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <utils.hpp>
+
+/// Cave/ravine carve thresholds. They only depend on Y, so they are tabulated
+/// once. Sharing the table keeps the batch pass, the border pass and the cached
+/// carve masks in ColumnNoiseCache bit-for-bit consistent.
+struct CarveThresholds
+{
+	std::array<float, CHUNK_HEIGHT> cave;
+	std::array<float, CHUNK_HEIGHT> ravine;
+
+	static const CarveThresholds table;
+};
+
+inline bool isCarved(float caveVal, float ravineVal, int y)
+{
+	return caveVal > CarveThresholds::table.cave[y] || ravineVal > CarveThresholds::table.ravine[y];
+}
+
+/// One voxel column as seen by fillColumn().
+///
+/// The 3D noise pointers address the column inside the chunk's slab buffers:
+/// the sample for Y is at [(y - minY) * stride]. cave/ravine are only consumed
+/// for solid voxels above bedrock and surface3D only inside the perturbation
+/// band of mountain columns, which the slab covers by construction.
+struct ColumnFillInput
+{
+	int worldX;
+	int worldZ;
+	int height; // Unperturbed surface height
+	BiomeType biome;
+	float temperature; // Already clamped to [-1, 1]
+	int seed;		   // Generator seed, for the snow line dither
+
+	const float *cave;
+	const float *ravine;
+	int caveMinY;
+	int caveMaxY;
+	int caveStride;
+
+	const float *surface3D; // May be null for non-mountain biomes
+	int surfaceMinY;
+	int surfaceMaxY;
+	int surfaceStride;
+};
+
+/// Classifies the CHUNK_HEIGHT voxels of a column into out[y] (TextureType
+/// values), 16 Y values at a time with per-biome layer tables.
+/// Produces exactly what TerrainGenerator::getVoxelTypeAt() plus the carve test
+/// give voxel by voxel.
+/// @return Highest Y that is neither air nor water, 0 if there is none.
+int fillColumn(const ColumnFillInput &column, uint8_t *out);
@@ -0,0 +1,75 @@
+#include "ColumnNoiseCache.hpp"
+#include <algorithm>
+
+// ~12.5 KB per chunk, so the default budget stays around 12 MB. Neighbours are
+// generated close together in time (distance-sorted dispatch), so this only
+// needs to cover the streaming frontier, not the whole render radius.
+static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+ColumnNoiseCache::ColumnNoiseCache(size_t capacity)
+	: m_shardCapacity(std::max<size_t>(1, (capacity + SHARD_COUNT - 1) / SHARD_COUNT))
+{
+}
+
+ColumnNoiseCache &ColumnNoiseCache::instance()
+{
+	static ColumnNoiseCache cache(DEFAULT_CAPACITY);
+	return cache;
+}
+
+void ColumnNoiseCache::store(int seed, uint32_t variant, int chunkX, int chunkZ, std::shared_ptr<const ChunkEdgeNoise> edges)
+{
+	const Key key{seed, variant, chunkX, chunkZ};
+	Shard &shard = shardFor(key);
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto [it, inserted] = shard.entries.insert_or_assign(key, std::move(edges));
+	if (!inserted)
+		return; // Regenerated chunk: refreshed in place, keeps its eviction slot
+
+	shard.order.push_back(key);
+	m_size.fetch_add(1, std::memory_order_relaxed);
+
+	while (shard.order.size() > m_shardCapacity)
+	{
+		shard.entries.erase(shard.order.front());
+		shard.order.pop_front();
+		m_size.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
+std::shared_ptr<const ChunkEdgeNoise> ColumnNoiseCache::find(int seed, uint32_t variant, int chunkX, int chunkZ) const
+{
+	const Key key{seed, variant, chunkX, chunkZ};
+	const Shard &shard = shardFor(key);
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto it = shard.entries.find(key);
+	return it != shard.entries.end() ? it->second : nullptr;
+}
+
+void ColumnNoiseCache::clear()
+{
+	for (Shard &shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		m_size.fetch_sub(shard.order.size(), std::memory_order_relaxed);
+		shard.entries.clear();
+		shard.order.clear();
+	}
+}
+
+void ColumnNoiseCache::recordLookup(bool hit) const
+{
+	if (hit)
+		m_hits.fetch_add(1, std::memory_order_relaxed);
+	else
+		m_misses.fetch_add(1, std::memory_order_relaxed);
+}
+
+float ColumnNoiseCache::hitRate() const
+{
+	const uint64_t h = hits();
+	const uint64_t total = h + misses();
+	return total > 0 ? static_cast<float>(h) / static_cast<float>(total) : 0.0f;
+}
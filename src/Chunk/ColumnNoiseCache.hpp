@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <utils.hpp>
+
+/// 3D noise results for the outermost columns of a generated chunk.
+///
+/// generateChunkBorders() needs the cave/ravine/surface3D noise of the 1-voxel
+/// shell around a chunk, which is exactly the edge columns of its four
+/// neighbours. Instead of re-sampling those strips, the border pass looks the
+/// neighbour's edges up here when that neighbour was generated first.
+///
+/// Only what the border pass consumes is kept:
+///  - cave/ravine reduced to a per-Y carve bit (the thresholds only depend on Y)
+///  - surface3D around the column's surface, where the mountain perturbation applies
+struct ChunkEdgeNoise
+{
+	enum Edge
+	{
+		EDGE_MIN_Z = 0, // localZ == 0, indexed by localX
+		EDGE_MAX_Z,		// localZ == CHUNK_SIZE - 1, indexed by localX
+		EDGE_MIN_X,		// localX == 0, indexed by localZ
+		EDGE_MAX_X,		// localX == CHUNK_SIZE - 1, indexed by localZ
+		EDGE_COUNT
+	};
+
+	// Max number of surface3D samples kept per column, starting at surfaceMinY.
+	static constexpr int SURFACE_SPAN = 40;
+
+	struct Column
+	{
+		std::array<uint32_t, CHUNK_HEIGHT / 32> carveMask;
+		std::array<float, SURFACE_SPAN> surface3D;
+		int16_t surfaceMinY;
+		int16_t surfaceMaxY; // Inclusive, empty when < surfaceMinY (no mountain nearby)
+
+		bool isCarved(int y) const { return (carveMask[y >> 5] >> (y & 31)) & 1u; }
+
+		/// True if surface3D holds every Y in [minY, maxY].
+		bool coversSurface(int minY, int maxY) const
+		{
+			return minY >= surfaceMinY && maxY <= surfaceMaxY;
+		}
+		float surfaceAt(int y) const { return surface3D[y - surfaceMinY]; }
+	};
+
+	std::array<std::array<Column, CHUNK_SIZE>, EDGE_COUNT> edges;
+
+	// Cave/ravine were only sampled up to this Y (the chunk's solid band);
+	// carve bits above it are unknown.
+	int16_t carveMaxY;
+
+	bool coversCarve(int maxY) const { return maxY <= carveMaxY; }
+};
+
+/// Thread-safe, bounded cache of ChunkEdgeNoise keyed by (seed, variant, chunk origin).
+///
+/// Entries are immutable once published and handed out as shared_ptr, so a
+/// lookup only holds a shard lock for the duration of the map find. Each shard
+/// evicts in insertion order once it reaches its share of the capacity.
+class ColumnNoiseCache
+{
+public:
+	/// @param capacity Maximum number of chunks kept across all shards.
+	explicit ColumnNoiseCache(size_t capacity);
+
+	// Non-copyable, non-movable
+	ColumnNoiseCache(const ColumnNoiseCache &) = delete;
+	ColumnNoiseCache &operator=(const ColumnNoiseCache &) = delete;
+
+	/// Process-wide cache shared by every thread-local TerrainGenerator.
+	static ColumnNoiseCache &instance();
+
+	/// chunkX/chunkZ are the world block coordinates of the chunk origin.
+	/// variant identifies generator settings that change the noise values
+	/// (e.g. coarse 3D sampling), so differently configured generators of the
+	/// same seed never read each other's entries.
+	void store(int seed, uint32_t variant, int chunkX, int chunkZ, std::shared_ptr<const ChunkEdgeNoise> edges);
+	std::shared_ptr<const ChunkEdgeNoise> find(int seed, uint32_t variant, int chunkX, int chunkZ) const;
+
+	/// Drops every entry (statistics are kept).
+	void clear();
+
+	/// Border strips served from the cache vs. re-sampled. Reported by the border pass.
+	void recordLookup(bool hit) const;
+
+	// --- Statistics (lock-free reads) ---
+	size_t capacity() const { return m_shardCapacity * SHARD_COUNT; }
+	size_t size() const { return m_size.load(std::memory_order_relaxed); }
+	uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+	uint64_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+	float hitRate() const;
+
+private:
+	static constexpr size_t SHARD_COUNT = 16;
+
+	struct Key
+	{
+		int seed;
+		uint32_t variant;
+		int chunkX;
+		int chunkZ;
+
+		bool operator==(const Key &other) const
+		{
+			return seed == other.seed && variant == other.variant && chunkX == other.chunkX && chunkZ == other.chunkZ;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key &key) const
+		{
+			size_t h = std::hash<int>()(key.seed);
+			hash_combine(h, key.variant);
+			hash_combine(h, static_cast<uint32_t>(key.chunkX));
+			hash_combine(h, static_cast<uint32_t>(key.chunkZ));
+			return h;
+		}
+	};
+
+	struct Shard
+	{
+		mutable std::mutex mutex;
+		std::unordered_map<Key, std::shared_ptr<const ChunkEdgeNoise>, KeyHash> entries;
+		std::deque<Key> order; // Insertion order, front is evicted first
+	};
+
+	Shard &shardFor(const Key &key) const { return m_shards[KeyHash()(key) % SHARD_COUNT]; }
+
+	size_t m_shardCapacity;
+	mutable std::array<Shard, SHARD_COUNT> m_shards;
+
+	std::atomic<size_t> m_size{0};
+	mutable std::atomic<uint64_t> m_hits{0};
+	mutable std::atomic<uint64_t> m_misses{0};
+};
@@ -0,0 +1,71 @@
+#include "ErosionTileCache.hpp"
+#include <algorithm>
+
+// 8 MB: the tiles under the loaded area at a large render distance, plus the
+// ones prefetched ahead of the player.
+static constexpr size_t DEFAULT_CAPACITY = 128;
+
+ErosionTileCache::ErosionTileCache(size_t capacity)
+	: m_capacity(std::max<size_t>(1, capacity))
+{
+}
+
+ErosionTileCache &ErosionTileCache::instance()
+{
+	static ErosionTileCache cache(DEFAULT_CAPACITY);
+	return cache;
+}
+
+std::shared_ptr<const ErosionTileCache::Tile> ErosionTileCache::get(int seed, int tileX, int tileZ, const Builder &build)
+{
+	const Key key{seed, tileX, tileZ};
+	std::shared_ptr<Slot> slot;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(key);
+		if (it != m_entries.end())
+		{
+			m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+			slot = it->second.slot;
+		}
+		else
+		{
+			slot = std::make_shared<Slot>();
+			m_lru.push_front(key);
+			m_entries.emplace(key, Entry{slot, m_lru.begin()});
+
+			while (m_entries.size() > m_capacity)
+			{
+				m_entries.erase(m_lru.back());
+				m_lru.pop_back();
+			}
+		}
+	}
+
+	// Built outside the lock: other tiles stay available meanwhile
+	std::call_once(slot->built, [&]
+				   {
+					   auto tile = std::make_shared<Tile>();
+					   build(tileX, tileZ, *tile);
+					   slot->tile = std::move(tile); });
+	return slot->tile;
+}
+
+bool ErosionTileCache::contains(int seed, int tileX, int tileZ) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.count(Key{seed, tileX, tileZ}) != 0;
+}
+
+void ErosionTileCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_lru.clear();
+}
+
+size_t ErosionTileCache::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
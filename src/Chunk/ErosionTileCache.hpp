@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <utils.hpp>
+
+/// Eroded terrain heights, one tile of TILE_CHUNKS x TILE_CHUNKS chunks at a time.
+///
+/// Erosion needs a neighbourhood far wider than a chunk's apron. Each tile is
+/// eroded once over its own area plus a margin (TerrainGenerator::buildErosionTile),
+/// and only the tile's own columns are kept, so every world column has exactly
+/// one eroded height whichever chunk, border strip or region asks for it.
+///
+/// Building is up to the caller; get() makes sure a tile is only built once
+/// even when several threads ask for it at the same time.
+class ErosionTileCache
+{
+public:
+	static constexpr int TILE_CHUNKS = 8;
+	static constexpr int TILE_BLOCKS = TILE_CHUNKS * CHUNK_SIZE;
+
+	/// Eroded float heights, row-major (z, then x)
+	using Tile = std::array<float, TILE_BLOCKS * TILE_BLOCKS>;
+	using Builder = std::function<void(int tileX, int tileZ, Tile &out)>;
+
+	/// @param capacity Maximum number of tiles kept (64 KB each).
+	explicit ErosionTileCache(size_t capacity);
+
+	// Non-copyable, non-movable
+	ErosionTileCache(const ErosionTileCache &) = delete;
+	ErosionTileCache &operator=(const ErosionTileCache &) = delete;
+
+	/// Process-wide cache shared by every TerrainGenerator (keyed by seed).
+	static ErosionTileCache &instance();
+
+	/// Tile containing a world block coordinate
+	static int tileOf(int worldBlock)
+	{
+		return worldBlock >= 0 ? worldBlock / TILE_BLOCKS : -((-worldBlock + TILE_BLOCKS - 1) / TILE_BLOCKS);
+	}
+
+	/// Returns the tile, calling build on first use and marking it as most
+	/// recently used. Concurrent callers for the same tile wait for the one
+	/// building it.
+	std::shared_ptr<const Tile> get(int seed, int tileX, int tileZ, const Builder &build);
+	/// True once get() was called for the tile, finished or not, and it was not evicted since.
+	bool contains(int seed, int tileX, int tileZ) const;
+
+	void clear();
+
+	size_t size() const;
+	size_t capacity() const { return m_capacity; }
+
+private:
+	struct Key
+	{
+		int seed;
+		int tileX;
+		int tileZ;
+
+		bool operator==(const Key &other) const
+		{
+			return seed == other.seed && tileX == other.tileX && tileZ == other.tileZ;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key &key) const
+		{
+			size_t h = std::hash<int>()(key.seed);
+			hash_combine(h, static_cast<uint32_t>(key.tileX));
+			hash_combine(h, static_cast<uint32_t>(key.tileZ));
+			return h;
+		}
+	};
+
+	// Shared with the threads building or waiting on it, so eviction cannot
+	// pull it from under them
+	struct Slot
+	{
+		std::once_flag built;
+		std::shared_ptr<const Tile> tile;
+	};
+
+	struct Entry
+	{
+		std::shared_ptr<Slot> slot;
+		std::list<Key>::iterator lruIt;
+	};
+
+	size_t m_capacity;
+	mutable std::mutex m_mutex;
+	std::unordered_map<Key, Entry, KeyHash> m_entries;
+	std::list<Key> m_lru; // Front is the most recently used
+};
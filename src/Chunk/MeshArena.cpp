@@ -0,0 +1,76 @@
+#include "MeshArena.hpp"
+
+#include <algorithm>
+
+MeshArena::~MeshArena()
+{
+	if (m_buffer != 0)
+		glDeleteBuffers(1, &m_buffer);
+}
+
+MeshArena::Range MeshArena::upload(const std::vector<ChunkQuad> &quads)
+{
+	Range range;
+	if (quads.empty())
+		return range;
+
+	const uint32_t count = static_cast<uint32_t>(quads.size());
+	uint32_t offset = m_allocator.allocate(count);
+	if (offset == ArenaAllocator::INVALID)
+	{
+		grow(count);
+		offset = m_allocator.allocate(count);
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_buffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(offset) * sizeof(ChunkQuad),
+					static_cast<GLsizeiptr>(count) * sizeof(ChunkQuad), quads.data());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	range.offset = offset;
+	range.count = count;
+	return range;
+}
+
+void MeshArena::release(Range &range)
+{
+	m_allocator.free(range.offset, range.count);
+	range = Range{};
+}
+
+void MeshArena::download(const Range &range, std::vector<ChunkQuad> &quads) const
+{
+	quads.resize(range.count);
+	if (range.count == 0)
+		return;
+	glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+	glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(range.offset) * sizeof(ChunkQuad),
+					   static_cast<GLsizeiptr>(range.count) * sizeof(ChunkQuad), quads.data());
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+void MeshArena::grow(uint32_t minFreeQuads)
+{
+	// The added tail is one free block, so it alone must fit the request
+	const uint32_t oldCapacity = m_allocator.capacity();
+	uint32_t capacity = std::max(oldCapacity * 2, INITIAL_QUADS);
+	while (capacity - oldCapacity < minFreeQuads)
+		capacity *= 2;
+
+	GLuint buffer = 0;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity) * sizeof(ChunkQuad), nullptr, GL_DYNAMIC_DRAW);
+	if (m_buffer != 0)
+	{
+		glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+							static_cast<GLsizeiptr>(oldCapacity) * sizeof(ChunkQuad));
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glDeleteBuffers(1, &m_buffer);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	m_buffer = buffer;
+	m_allocator.grow(capacity);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <Chunk/ArenaAllocator.hpp>
+#include <utils.hpp>
+
+/// Layout of one glMultiDrawElementsIndirect() command
+struct DrawElementsIndirectCommand
+{
+	uint32_t count;
+	uint32_t instanceCount;
+	uint32_t firstIndex;
+	int32_t baseVertex;
+	uint32_t baseInstance;
+};
+
+/// One shader storage buffer of ChunkQuad that every chunk mesh, opaque and
+/// water, is placed into, so a whole pass draws with a single
+/// glMultiDrawElementsIndirect(): a mesh at offset o is drawn with
+/// baseVertex = 4 * o over the shared quad index pattern.
+///
+/// Space is handed out by an ArenaAllocator. When no free block is large
+/// enough the buffer doubles, and what it holds is copied over on the GPU.
+/// Main thread only (GL calls); the buffer is created on the first upload.
+class MeshArena
+{
+public:
+	static constexpr uint32_t INITIAL_QUADS = 1u << 20; // 16 MiB
+
+	/// Quads [offset, offset + count) of the arena buffer
+	struct Range
+	{
+		uint32_t offset = 0;
+		uint32_t count = 0;
+	};
+
+	MeshArena() = default;
+	~MeshArena();
+	MeshArena(const MeshArena &) = delete;
+	MeshArena &operator=(const MeshArena &) = delete;
+
+	/// Copies quads into the arena; an empty mesh gets an empty range
+	Range upload(const std::vector<ChunkQuad> &quads);
+	/// Gives a range from upload() back and empties it
+	void release(Range &range);
+	/// Reads the quads of a range back into `quads`. Waits for the GPU: for
+	/// rare reads only, such as a chunk going into the MeshCache.
+	void download(const Range &range, std::vector<ChunkQuad> &quads) const;
+
+	GLuint buffer() const { return m_buffer; }
+	uint32_t capacity() const { return m_allocator.capacity(); }
+	uint32_t usedQuads() const { return m_allocator.used(); }
+
+private:
+	void grow(uint32_t minFreeQuads);
+
+	ArenaAllocator m_allocator;
+	GLuint m_buffer = 0;
+};
@@ -0,0 +1,205 @@
+#include "MeshCache.hpp"
+
+namespace
+{
+	// Flag byte of a packed quad
+	constexpr uint8_t NORMAL_MASK = 0x7;	   // Bits 0-2: normal
+	constexpr int COLOR_SHIFT = 3;			   // Bits 3-4: COLOR_NONE, COLOR_FLAT or COLOR_CORNERS
+	constexpr uint8_t SAME_TEXTURE = 1u << 5;  // Texture index of the previous quad
+	constexpr uint8_t SMALL_SIZES = 1u << 6;   // Both sizes in one byte, 4 bits each
+	constexpr uint8_t BIOME_COLOR = 1u << 7;
+
+	enum ColorMode : uint8_t
+	{
+		COLOR_NONE,
+		COLOR_FLAT,
+		COLOR_CORNERS
+	};
+
+	void put16(std::vector<uint8_t> &out, uint16_t value)
+	{
+		out.push_back(static_cast<uint8_t>(value));
+		out.push_back(static_cast<uint8_t>(value >> 8));
+	}
+
+	uint16_t get16(const uint8_t *&in)
+	{
+		const uint16_t value = static_cast<uint16_t>(in[0] | (in[1] << 8));
+		in += 2;
+		return value;
+	}
+}
+
+void packQuads(const std::vector<ChunkQuad> &quads, std::vector<uint8_t> &out)
+{
+	out.clear();
+	out.reserve(quads.size() * 7);
+	uint32_t texture = ~0u;
+	for (const ChunkQuad &quad : quads)
+	{
+		ColorMode colors = COLOR_CORNERS;
+		if (quad.colors[0] == 0 && quad.colors[1] == 0)
+			colors = COLOR_NONE;
+		else if (quad.color(0) == quad.color(1) && quad.colors[0] == quad.colors[1])
+			colors = COLOR_FLAT;
+		const bool smallSizes = quad.sizeU() <= 16 && quad.sizeV() <= 16;
+
+		uint8_t flags = static_cast<uint8_t>(quad.normal() | (colors << COLOR_SHIFT));
+		if (quad.textureIndex() == texture)
+			flags |= SAME_TEXTURE;
+		if (smallSizes)
+			flags |= SMALL_SIZES;
+		if (quad.useBiomeColor())
+			flags |= BIOME_COLOR;
+		out.push_back(flags);
+
+		// x, y and z of corner 0 (19 bits), then the AO byte
+		out.push_back(static_cast<uint8_t>(quad.position));
+		out.push_back(static_cast<uint8_t>(quad.position >> 8));
+		out.push_back(static_cast<uint8_t>((quad.position >> 16) & 0x7u));
+		out.push_back(static_cast<uint8_t>(quad.position >> 22));
+		if (smallSizes)
+			out.push_back(static_cast<uint8_t>((quad.sizeU() - 1) | ((quad.sizeV() - 1) << 4)));
+		else
+		{
+			out.push_back(static_cast<uint8_t>(quad.sizeU() - 1));
+			out.push_back(static_cast<uint8_t>(quad.sizeV() - 1));
+		}
+		if (!(flags & SAME_TEXTURE))
+			out.push_back(static_cast<uint8_t>(quad.textureIndex()));
+
+		if (colors == COLOR_FLAT)
+			put16(out, quad.color(0));
+		else if (colors == COLOR_CORNERS)
+		{
+			for (int corner = 0; corner < 4; ++corner)
+				put16(out, quad.color(corner));
+		}
+		texture = quad.textureIndex();
+	}
+}
+
+void unpackQuads(const std::vector<uint8_t> &packed, std::vector<ChunkQuad> &quads)
+{
+	const uint8_t *in = packed.data();
+	const uint8_t *end = in + packed.size();
+	uint32_t texture = 0;
+	while (in < end)
+	{
+		const uint8_t flags = *in++;
+		ChunkQuad quad;
+		quad.position = in[0] | (in[1] << 8) | (static_cast<uint32_t>(in[2]) << 16) |
+						(static_cast<uint32_t>(flags & NORMAL_MASK) << 19) | (static_cast<uint32_t>(in[3]) << 22);
+		in += 4;
+
+		uint32_t sizeU;
+		uint32_t sizeV;
+		if (flags & SMALL_SIZES)
+		{
+			sizeU = *in & 0xFu;
+			sizeV = *in++ >> 4;
+		}
+		else
+		{
+			sizeU = *in++;
+			sizeV = *in++;
+		}
+		if (!(flags & SAME_TEXTURE))
+			texture = *in++;
+		quad.material = texture | ((flags & BIOME_COLOR) ? (1u << 8) : 0u) | (sizeU << 16) | (sizeV << 24);
+
+		const uint8_t colors = (flags >> COLOR_SHIFT) & 0x3u;
+		uint16_t corner[4] = {0, 0, 0, 0};
+		if (colors == COLOR_FLAT)
+			corner[0] = corner[1] = corner[2] = corner[3] = get16(in);
+		else if (colors == COLOR_CORNERS)
+		{
+			for (uint16_t &color : corner)
+				color = get16(in);
+		}
+		quad.colors[0] = corner[0] | (static_cast<uint32_t>(corner[1]) << 16);
+		quad.colors[1] = corner[2] | (static_cast<uint32_t>(corner[3]) << 16);
+		quads.push_back(quad);
+	}
+}
+
+size_t CachedChunk::bytes() const
+{
+	size_t total = sizeof(CachedChunk);
+	for (int s = 0; s < SECTION_COUNT; ++s)
+		total += opaque[s].capacity() + water[s].capacity() + sections[s].storageBytes();
+	return total;
+}
+
+MeshCache::MeshCache(size_t capacityBytes)
+	: m_capacityBytes(capacityBytes)
+{
+}
+
+void MeshCache::store(const glm::ivec3 &chunkPos, int seed, uint32_t editGeneration, std::unique_ptr<CachedChunk> chunk)
+{
+	auto it = m_entries.find(chunkPos);
+	if (it != m_entries.end())
+		erase(it);
+
+	const size_t bytes = chunk->bytes();
+	if (bytes > m_capacityBytes)
+		return;
+	while (m_bytes + bytes > m_capacityBytes)
+		erase(m_entries.find(m_order.front()));
+
+	m_order.push_back(chunkPos);
+	m_entries.emplace(chunkPos, Entry{seed, editGeneration, bytes, std::move(chunk), std::prev(m_order.end())});
+	m_bytes += bytes;
+}
+
+std::unique_ptr<CachedChunk> MeshCache::take(const glm::ivec3 &chunkPos, int seed, uint32_t editGeneration)
+{
+	auto it = m_entries.find(chunkPos);
+	if (it == m_entries.end())
+	{
+		++m_misses;
+		return nullptr;
+	}
+
+	std::unique_ptr<CachedChunk> chunk;
+	if (it->second.seed == seed && it->second.editGeneration == editGeneration)
+		chunk = std::move(it->second.chunk);
+	erase(it); // Taken, or stale
+	++(chunk ? m_hits : m_misses);
+	return chunk;
+}
+
+void MeshCache::dropBeyond(const glm::vec3 &center, float distance)
+{
+	const float distanceSq = distance * distance;
+	for (auto it = m_entries.begin(); it != m_entries.end();)
+	{
+		const float dx = center.x - (it->first.x * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+		const float dz = center.z - (it->first.z * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
+		if (dx * dx + dz * dz > distanceSq)
+			it = erase(it);
+		else
+			++it;
+	}
+}
+
+void MeshCache::clear()
+{
+	m_entries.clear();
+	m_order.clear();
+	m_bytes = 0;
+}
+
+float MeshCache::hitRate() const
+{
+	const uint64_t total = m_hits + m_misses;
+	return total > 0 ? static_cast<float>(m_hits) / static_cast<float>(total) : 0.0f;
+}
+
+MeshCache::EntryMap::iterator MeshCache::erase(EntryMap::iterator it)
+{
+	m_bytes -= it->second.bytes;
+	m_order.erase(it->second.order);
+	return m_entries.erase(it);
+}
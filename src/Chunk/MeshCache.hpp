@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Chunk/BiomeColorField.hpp>
+#include <Chunk/ChunkSection.hpp>
+#include <utils.hpp>
+
+/// Packs quads into a byte stream, field by field: a flag byte (normal, biome
+/// flag, colour mode), the corner position on 3 bytes, the AO byte, both sizes
+/// on one byte when they fit, the texture unless it repeats the previous
+/// quad's, and the corner colours as none, one or four RGB565 values (no biome
+/// colour, a flat one, a gradient). Under half the size of the quads.
+void packQuads(const std::vector<ChunkQuad> &quads, std::vector<uint8_t> &out);
+/// Appends the quads of a packQuads() stream to `quads`
+void unpackQuads(const std::vector<uint8_t> &packed, std::vector<ChunkQuad> &quads);
+
+/// What restoring an unloaded chunk needs: its section meshes, packed, and
+/// its voxels and biome colours, for the edits and re-meshes that follow.
+struct CachedChunk
+{
+	std::array<std::vector<uint8_t>, SECTION_COUNT> opaque; // packQuads() streams
+	std::array<std::vector<uint8_t>, SECTION_COUNT> water;
+	ChunkSections sections;
+	BiomeColorField colors;
+
+	/// Heap and inline bytes held
+	size_t bytes() const;
+};
+
+/// Chunks unloaded at the edge of the load radius, kept so that walking back
+/// over the unload boundary restores them without generating or meshing them
+/// again.
+///
+/// An entry is valid for one seed and one edit generation of its chunk (see
+/// ChunkManager): take() with any other misses and drops it. At most one entry
+/// per chunk coordinate. Bounded by the bytes held: the oldest entries go
+/// first. Main thread only.
+class MeshCache
+{
+public:
+	/// @param capacityBytes Maximum bytes held by the entries together.
+	explicit MeshCache(size_t capacityBytes);
+
+	// Non-copyable, non-movable
+	MeshCache(const MeshCache &) = delete;
+	MeshCache &operator=(const MeshCache &) = delete;
+
+	/// Replaces any entry of `chunkPos`. An entry larger than the capacity is dropped.
+	void store(const glm::ivec3 &chunkPos, int seed, uint32_t editGeneration, std::unique_ptr<CachedChunk> chunk);
+	/// Removes and returns the entry of `chunkPos` if it was stored with this
+	/// seed and edit generation; null otherwise. Counts a hit or a miss.
+	std::unique_ptr<CachedChunk> take(const glm::ivec3 &chunkPos, int seed, uint32_t editGeneration);
+	bool contains(const glm::ivec3 &chunkPos) const { return m_entries.contains(chunkPos); }
+	/// Drops the entries whose chunk centre is farther than `distance` from `center` on XZ
+	void dropBeyond(const glm::vec3 &center, float distance);
+	void clear();
+
+	// --- Statistics ---
+	size_t capacityBytes() const { return m_capacityBytes; }
+	size_t bytes() const { return m_bytes; }
+	size_t size() const { return m_entries.size(); }
+	uint64_t hits() const { return m_hits; }
+	uint64_t misses() const { return m_misses; }
+	float hitRate() const;
+
+private:
+	struct Entry
+	{
+		int seed;
+		uint32_t editGeneration;
+		size_t bytes;
+		std::unique_ptr<CachedChunk> chunk;
+		std::list<glm::ivec3>::iterator order;
+	};
+
+	using EntryMap = std::unordered_map<glm::ivec3, Entry, IVec3Hash>;
+	EntryMap::iterator erase(EntryMap::iterator it);
+
+	size_t m_capacityBytes;
+	size_t m_bytes = 0;
+	EntryMap m_entries;
+	std::list<glm::ivec3> m_order; // Storing order, front is evicted first
+	uint64_t m_hits = 0;
+	uint64_t m_misses = 0;
+};
@@ -0,0 +1,66 @@
+#include "StructureTemplate.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+void StructureTemplate::set(int x, int y, int z, TextureType type)
+{
+	assert(x >= INT8_MIN && x <= INT8_MAX && y >= INT8_MIN && y <= INT8_MAX && z >= INT8_MIN && z <= INT8_MAX);
+	m_pending.push_back({static_cast<int8_t>(x), static_cast<int8_t>(y), static_cast<int8_t>(z),
+						 static_cast<uint8_t>(type), static_cast<uint32_t>(m_pending.size())});
+}
+
+void StructureTemplate::compile()
+{
+	// Order by position, and by set() order within a position so the last one wins
+	std::sort(m_pending.begin(), m_pending.end(), [](const PendingVoxel &a, const PendingVoxel &b)
+			  {
+				  if (a.y != b.y)
+					  return a.y < b.y;
+				  if (a.z != b.z)
+					  return a.z < b.z;
+				  if (a.x != b.x)
+					  return a.x < b.x;
+				  return a.order < b.order; });
+
+	m_spans.clear();
+	for (size_t i = 0; i < m_pending.size(); ++i)
+	{
+		const PendingVoxel &voxel = m_pending[i];
+		if (i + 1 < m_pending.size() && m_pending[i + 1].x == voxel.x && m_pending[i + 1].y == voxel.y &&
+			m_pending[i + 1].z == voxel.z)
+			continue; // Overwritten by a later set()
+
+		if (!m_spans.empty())
+		{
+			StructureSpan &last = m_spans.back();
+			if (last.y == voxel.y && last.z == voxel.z && last.type == voxel.type &&
+				last.x + last.length == voxel.x && last.length < UINT8_MAX)
+			{
+				++last.length;
+				continue;
+			}
+		}
+		m_spans.push_back({voxel.x, voxel.y, voxel.z, 1, voxel.type});
+	}
+	m_pending.clear();
+	m_pending.shrink_to_fit();
+
+	if (m_spans.empty())
+		return;
+	m_min = glm::ivec3(INT8_MAX);
+	m_max = glm::ivec3(INT8_MIN);
+	for (const StructureSpan &span : m_spans)
+	{
+		m_min = glm::min(m_min, glm::ivec3(span.x, span.y, span.z));
+		m_max = glm::max(m_max, glm::ivec3(span.x + span.length - 1, span.y, span.z));
+	}
+}
+
+size_t StructureTemplate::voxelCount() const
+{
+	size_t count = 0;
+	for (const StructureSpan &span : m_spans)
+		count += span.length;
+	return count;
+}
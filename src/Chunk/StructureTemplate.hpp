@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <utils.hpp>
+
+/// `length` voxels of `type` starting at (x, y, z) and running along +X,
+/// relative to the anchor of the structure.
+struct StructureSpan
+{
+	int8_t x;
+	int8_t y;
+	int8_t z;
+	uint8_t length;
+	uint8_t type; // TextureType, AIR included: a structure may clear space
+};
+
+/// A structure shape, compiled once into StructureSpans.
+///
+/// Shapes are described voxel by voxel with set(), where a later set() of the
+/// same voxel wins, then compile() merges them into spans ordered by y, z and
+/// x. Stamping a template (TerrainGenerator::stampStructure) is then one
+/// clipped write per span instead of the shape's loops and branches.
+class StructureTemplate
+{
+public:
+	/// Coordinates relative to the anchor must fit in an int8_t
+	void set(int x, int y, int z, TextureType type);
+	void compile();
+
+	const std::vector<StructureSpan> &spans() const { return m_spans; }
+	/// Bounding box of the voxels relative to the anchor, inclusive.
+	/// Valid once compiled and not empty.
+	const glm::ivec3 &min() const { return m_min; }
+	const glm::ivec3 &max() const { return m_max; }
+	bool empty() const { return m_spans.empty(); }
+	size_t voxelCount() const;
+
+private:
+	struct PendingVoxel
+	{
+		int8_t x;
+		int8_t y;
+		int8_t z;
+		uint8_t type;
+		uint32_t order;
+	};
+
+	std::vector<PendingVoxel> m_pending; // Between set() and compile()
+	std::vector<StructureSpan> m_spans;
+	glm::ivec3 m_min{0};
+	glm::ivec3 m_max{0};
+};
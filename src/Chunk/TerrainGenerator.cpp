@@ -1,5 +1,10 @@
 #include <Chunk/TerrainGenerator.hpp>
+#include <Chunk/ColumnNoiseCache.hpp>
+#include <Chunk/ColumnFill.hpp>
+#include <Chunk/TerrainProfiler.hpp>
 #include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <cmath>
 #include <mutex>
 
@@ -284,26 +289,44 @@ const BiomeConfig &TerrainGenerator::getBiomeConfig(BiomeType biome)
 // CONSTRUCTOR
 // =============================================
 
-TerrainGenerator::TerrainGenerator(int seed) : m_seed(seed)
+TerrainGenerator::TerrainGenerator(int seed)
+    : m_graphs(getNoiseGraphs(seed)), m_seed(seed), m_gridStructures(&worldGridStructures())
 {
   initBiomeConfigs();
-  setupNoiseGenerators();
+  // Every 3D layer samples every voxel unless switched with setNoiseSampling()
+  m_noiseSampling.fill(NoiseSampling::Full);
 }
 
 // =============================================
 // NOISE SETUP
 // =============================================
 
-void TerrainGenerator::setupNoiseGenerators()
+std::shared_ptr<const TerrainGenerator::NoiseGraphs> TerrainGenerator::getNoiseGraphs(int seed)
 {
-  setupTerrainNoise();
-  setupBiomeNoise();
-  setupCaveNoise();
-  setupVegetationNoise();
-  setupOres();
+  // Weak references: a seed's graphs go away with its last generator, so a
+  // seed change drops the old ones once every worker has moved on.
+  static std::mutex registryMutex;
+  static std::unordered_map<int, std::weak_ptr<const NoiseGraphs>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  if (std::shared_ptr<const NoiseGraphs> graphs = registry[seed].lock())
+    return graphs;
+
+  auto graphs = std::make_shared<NoiseGraphs>();
+  setupTerrainNoise(*graphs);
+  setupBiomeNoise(*graphs);
+  setupCaveNoise(*graphs);
+  setupVegetationNoise(*graphs);
+  setupOres(*graphs, seed);
+
+  // Drop the entries of seeds nobody uses anymore
+  for (auto it = registry.begin(); it != registry.end();)
+    it = it->second.expired() ? registry.erase(it) : std::next(it);
+  registry[seed] = graphs;
+  return graphs;
 }
 
-void TerrainGenerator::setupTerrainNoise()
+void TerrainGenerator::setupTerrainNoise(NoiseGraphs &graphs)
 {
   // Continental noise - Large scale continent shapes
   auto continentalBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -318,7 +341,7 @@ void TerrainGenerator::setupTerrainNoise()
   auto continentalScale = FastNoise::New<FastNoise::DomainScale>();
   continentalScale->SetSource(continentalFractal);
   continentalScale->SetScale(0.002f);
-  m_continentalNoise = continentalScale;
+  graphs.continental = continentalScale;
 
   // Erosion noise - Controls terrain smoothness
   auto erosionBase = FastNoise::New<FastNoise::Perlin>();
@@ -331,7 +354,7 @@ void TerrainGenerator::setupTerrainNoise()
   auto erosionScale = FastNoise::New<FastNoise::DomainScale>();
   erosionScale->SetSource(erosionFractal);
   erosionScale->SetScale(0.004f);
-  m_erosionNoise = erosionScale;
+  graphs.erosion = erosionScale;
 
   // Peaks and Valleys noise - Local height variation
   auto pvBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -344,7 +367,7 @@ void TerrainGenerator::setupTerrainNoise()
   auto pvScale = FastNoise::New<FastNoise::DomainScale>();
   pvScale->SetSource(pvFractal);
   pvScale->SetScale(0.01f);
-  m_peaksValleysNoise = pvScale;
+  graphs.peaksValleys = pvScale;
 
   // Ridge noise - For sharp mountain peaks
   auto ridgeBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -357,7 +380,7 @@ void TerrainGenerator::setupTerrainNoise()
   auto ridgeScale = FastNoise::New<FastNoise::DomainScale>();
   ridgeScale->SetSource(ridgeFractal);
   ridgeScale->SetScale(0.004f);
-  m_ridgeNoise = ridgeScale;
+  graphs.ridge = ridgeScale;
 
   auto surface3DBase = FastNoise::New<FastNoise::OpenSimplex2>();
   auto surface3DFractal = FastNoise::New<FastNoise::FractalFBm>();
@@ -368,10 +391,10 @@ void TerrainGenerator::setupTerrainNoise()
   auto surface3DScale = FastNoise::New<FastNoise::DomainScale>();
   surface3DScale->SetSource(surface3DFractal);
   surface3DScale->SetScale(0.015f);
-  m_surface3DNoise = surface3DScale;
+  graphs.surface3D = surface3DScale;
 }
 
-void TerrainGenerator::setupBiomeNoise()
+void TerrainGenerator::setupBiomeNoise(NoiseGraphs &graphs)
 {
   // Temperature noise - Varies from cold (north) to hot (south) with local variation
   auto tempBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -384,7 +407,7 @@ void TerrainGenerator::setupBiomeNoise()
   auto tempScale = FastNoise::New<FastNoise::DomainScale>();
   tempScale->SetSource(tempFractal);
   tempScale->SetScale(0.0007f); // Reduced from 0.0015 → ~2× larger temperature zones
-  m_temperatureNoise = tempScale;
+  graphs.temperature = tempScale;
 
   // Humidity noise - Controls wet/dry biomes
   auto humidBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -397,7 +420,7 @@ void TerrainGenerator::setupBiomeNoise()
   auto humidScale = FastNoise::New<FastNoise::DomainScale>();
   humidScale->SetSource(humidFractal);
   humidScale->SetScale(0.0009f); // Reduced from 0.002 → ~2× larger humidity zones
-  m_humidityNoise = humidScale;
+  graphs.humidity = humidScale;
 
   // Weirdness noise - For rare/unusual biomes
   auto weirdBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -410,7 +433,7 @@ void TerrainGenerator::setupBiomeNoise()
   auto weirdScale = FastNoise::New<FastNoise::DomainScale>();
   weirdScale->SetSource(weirdFractal);
   weirdScale->SetScale(0.0015f); // Reduced from 0.003 → larger weirdness patches
-  m_weirdnessNoise = weirdScale;
+  graphs.weirdness = weirdScale;
 
   auto riverBase = FastNoise::New<FastNoise::OpenSimplex2>();
   auto riverFractal = FastNoise::New<FastNoise::FractalFBm>();
@@ -419,10 +442,10 @@ void TerrainGenerator::setupBiomeNoise()
   auto riverScale = FastNoise::New<FastNoise::DomainScale>();
   riverScale->SetSource(riverFractal);
   riverScale->SetScale(0.003f);
-  m_riverNoise = riverScale;
+  graphs.river = riverScale;
 }
 
-void TerrainGenerator::setupCaveNoise()
+void TerrainGenerator::setupCaveNoise(NoiseGraphs &graphs)
 {
   // Cave noise - 3D Simplex "cheese" caves
   auto caveBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -435,7 +458,7 @@ void TerrainGenerator::setupCaveNoise()
   auto caveScale = FastNoise::New<FastNoise::DomainScale>();
   caveScale->SetSource(caveFractal);
   caveScale->SetScale(0.02f);
-  m_caveNoise = caveScale;
+  graphs.cave = caveScale;
 
   // Ravine noise - Vertical faults
   auto ravineBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -448,10 +471,24 @@ void TerrainGenerator::setupCaveNoise()
   auto ravineScale = FastNoise::New<FastNoise::DomainScale>();
   ravineScale->SetSource(ravineFractal);
   ravineScale->SetScale(0.005f);
-  m_ravineNoise = ravineScale;
+  graphs.ravine = ravineScale;
 }
 
-void TerrainGenerator::setupVegetationNoise()
+void TerrainGenerator::setNoiseSampling(Noise3DLayer layer, NoiseSampling sampling)
+{
+  m_noiseSampling[layer] = sampling;
+}
+
+uint32_t TerrainGenerator::noiseSamplingVariant() const
+{
+  uint32_t variant = 0;
+  for (int layer = 0; layer < NOISE_3D_LAYER_COUNT; ++layer)
+    if (m_noiseSampling[layer] == NoiseSampling::Coarse)
+      variant |= 1u << layer;
+  return variant;
+}
+
+void TerrainGenerator::setupVegetationNoise(NoiseGraphs &graphs)
 {
   // Local tree placement noise — high frequency, determines per-column tree candidacy
   auto treeBase = FastNoise::New<FastNoise::OpenSimplex2>();
@@ -464,7 +501,7 @@ void TerrainGenerator::setupVegetationNoise()
   auto treeScale = FastNoise::New<FastNoise::DomainScale>();
   treeScale->SetSource(treeFractal);
   treeScale->SetScale(0.05f);
-  m_treeNoise = treeScale;
+  graphs.tree = treeScale;
 
   // Forest density noise — low frequency, creates large-scale forest patches and clearings.
   // Positive values => forested area; negative or near-zero => open/clearing.
@@ -479,27 +516,81 @@ void TerrainGenerator::setupVegetationNoise()
   auto forestScale = FastNoise::New<FastNoise::DomainScale>();
   forestScale->SetSource(forestFractal);
   forestScale->SetScale(0.004f);
-  m_forestDensityNoise = forestScale;
+  graphs.forestDensity = forestScale;
 }
 
-void TerrainGenerator::setupOres()
+void TerrainGenerator::setupOres(NoiseGraphs &graphs, int seed)
 {
   // Coal: Common, large veins
-  m_ores.push_back({TextureType::COAL_ORE, 0, 128, 17, 20, 10000});
+  graphs.ores.push_back({TextureType::COAL_ORE, 0, 128, 17, 20, 10000});
   // Iron: Common, medium veins
-  m_ores.push_back({TextureType::IRON_ORE, 0, 64, 9, 20, 11000});
+  graphs.ores.push_back({TextureType::IRON_ORE, 0, 64, 9, 20, 11000});
   // Copper: Medium rarity
-  m_ores.push_back({TextureType::COPPER_ORE, 0, 96, 10, 16, 12000});
+  graphs.ores.push_back({TextureType::COPPER_ORE, 0, 96, 10, 16, 12000});
   // Gold: Rare, deep
-  m_ores.push_back({TextureType::GOLD_ORE, 0, 32, 9, 4, 13000});
+  graphs.ores.push_back({TextureType::GOLD_ORE, 0, 32, 9, 4, 13000});
   // Lapis: Rare, deep
-  m_ores.push_back({TextureType::LAPIS_ORE, 0, 32, 7, 2, 14000});
+  graphs.ores.push_back({TextureType::LAPIS_ORE, 0, 32, 7, 2, 14000});
   // Redstone: Common deep
-  m_ores.push_back({TextureType::REDSTONE_ORE, 0, 16, 8, 8, 15000});
+  graphs.ores.push_back({TextureType::REDSTONE_ORE, 0, 16, 8, 8, 15000});
   // Diamond: Very rare
-  m_ores.push_back({TextureType::DIAMOND_ORE, 1, 16, 8, 2, 16000});
+  graphs.ores.push_back({TextureType::DIAMOND_ORE, 1, 16, 8, 2, 16000});
   // Emerald: Very rare
-  m_ores.push_back({TextureType::EMERALD_ORE, 4, 32, 3, 2, 17000});
+  graphs.ores.push_back({TextureType::EMERALD_ORE, 4, 32, 3, 2, 17000});
+
+  compileOreTemplates(graphs, seed);
+}
+
+// Each template is the set of voxels a clusterSize-step random walk visits,
+// the walk ore generation used to run for every cluster of every chunk. The
+// per-chunk pass only picks a template and a start point.
+void TerrainGenerator::compileOreTemplates(NoiseGraphs &graphs, int seed)
+{
+  for (OreDef &ore : graphs.ores)
+  {
+    ore.offsetX.clear();
+    ore.offsetY.clear();
+    ore.offsetZ.clear();
+
+    for (int t = 0; t < ORE_TEMPLATES_PER_ORE; ++t)
+    {
+      const size_t first = ore.offsetX.size();
+      ore.templateStart[t] = static_cast<uint16_t>(first);
+
+      int x = 0, y = 0, z = 0;
+      for (int step = 0; step < ore.clusterSize; ++step)
+      {
+        bool visited = false;
+        for (size_t i = first; i < ore.offsetX.size() && !visited; ++i)
+          visited = ore.offsetX[i] == x && ore.offsetY[i] == y && ore.offsetZ[i] == z;
+        if (!visited)
+        {
+          ore.offsetX.push_back(static_cast<int8_t>(x));
+          ore.offsetY.push_back(static_cast<int8_t>(y));
+          ore.offsetZ.push_back(static_cast<int8_t>(z));
+        }
+
+        uint32_t stepHash = treeHash(t, step, seed + ore.seedOffset + 7919);
+        int dir = stepHash % 6;
+        if (dir == 0) x++;
+        else if (dir == 1) x--;
+        else if (dir == 2) y++;
+        else if (dir == 3) y--;
+        else if (dir == 4) z++;
+        else if (dir == 5) z--;
+      }
+    }
+    ore.templateStart[ORE_TEMPLATES_PER_ORE] = static_cast<uint16_t>(ore.offsetX.size());
+  }
+}
+
+// node->GenUniformGrid2D(args...), timed under the node's profiler counter
+template <typename... Args>
+static inline void genGrid2D(TerrainProfiler::Counter counter, const FastNoise::SmartNode<FastNoise::Generator> &node,
+                             Args... args)
+{
+  TerrainProfiler::Scope scope(counter);
+  node->GenUniformGrid2D(args...);
 }
 
 // =============================================
@@ -509,6 +600,42 @@ void TerrainGenerator::setupOres()
 // Height clamping
 static constexpr int HEIGHT_CEILING_MARGIN = 32; // Reserved space above max terrain
 
+// Mountain surface perturbation band: density in (-8, 12) means
+// Y in [height - 11, height + 7]. Cached edge columns keep surface3D over that
+// band plus some slack, since the neighbour's eroded height may differ a bit.
+static constexpr int SURFACE_BAND_BELOW = 11;
+static constexpr int SURFACE_BAND_ABOVE = 7;
+static constexpr int SURFACE_CACHE_SLACK =
+    (ChunkEdgeNoise::SURFACE_SPAN - (SURFACE_BAND_BELOW + SURFACE_BAND_ABOVE + 1)) / 2;
+
+// Vertical extent (inclusive) of the 3D noise a chunk actually consumes.
+// cave/ravine only matter for solid voxels above bedrock, which never reach
+// above height + SURFACE_BAND_ABOVE; surface3D only for mountain columns
+// inside their perturbation band. Bounds cover the 18x18 core + border shell.
+struct NoiseSlab
+{
+  int caveMinY = TerrainGenerator::BEDROCK_LEVEL + 1;
+  int caveMaxY = CHUNK_HEIGHT - 1;
+  int surfaceMinY = CHUNK_HEIGHT; // Empty (min > max) without mountain columns
+  int surfaceMaxY = -1;
+
+  int caveHeight() const { return caveMaxY - caveMinY + 1; }
+  int surfaceHeight() const { return std::max(0, surfaceMaxY - surfaceMinY + 1); }
+
+  void merge(const NoiseSlab &other)
+  {
+    caveMinY = std::min(caveMinY, other.caveMinY);
+    caveMaxY = std::max(caveMaxY, other.caveMaxY);
+    surfaceMinY = std::min(surfaceMinY, other.surfaceMinY);
+    surfaceMaxY = std::max(surfaceMaxY, other.surfaceMaxY);
+  }
+};
+
+static inline int roundedColumnHeight(float extHeight)
+{
+  return std::clamp(static_cast<int>(std::round(extHeight)), 1, static_cast<int>(CHUNK_HEIGHT - HEIGHT_CEILING_MARGIN));
+}
+
 struct GenBuffers
 {
   // Base noise buffers (20x20 to support erosion over chunk boundaries)
@@ -521,14 +648,20 @@ struct GenBuffers
   std::array<float, 20 * 20> weirdness;
   std::array<float, 20 * 20> river;
 
-  // Extended heightmap for erosion (20x20)
+  // Eroded heights of the 20x20 apron, read from the erosion tiles
   std::array<float, 20 * 20> extendedHeightMap;
 
-  // Extra space for thermal/hydraulic erosion particle simulation
-  std::array<float, 20 * 20> waterMap;
-  std::array<float, 20 * 20> sedimentMap;
-
-  // 3D noise is still generated for the core chunk + borders (not strictly 20x20, we can keep it 16x16 or 18x18 as needed)
+  // Erosion tile simulation (EROSION_DOMAIN x EROSION_DOMAIN, sized on first tile):
+  // heights, water and suspended sediment, plus the next step of the latter two
+  std::vector<float> erosionHeightMap;
+  std::vector<float> waterMap;
+  std::vector<float> sedimentMap;
+  std::vector<float> waterNextMap;
+  std::vector<float> sedimentNextMap;
+
+  // 3D noise for the core chunk, restricted to `slab`: cave/ravine are laid
+  // out as 16 x caveHeight() x 16, surface3D as 16 x surfaceHeight() x 16
+  NoiseSlab slab;
   std::array<float, CHUNK_VOLUME> cave;
   std::array<float, CHUNK_VOLUME> ravine;
   std::array<float, CHUNK_VOLUME> surface3D;
@@ -543,7 +676,7 @@ struct GenBuffers
   std::array<float, CHUNK_SIZE> borderHumid;
   std::array<float, CHUNK_SIZE> borderWeird;
   std::array<float, CHUNK_SIZE> borderRiver;
-  // 3D noise buffers for cave/ravine per strip (CHUNK_SIZE x CHUNK_HEIGHT x 1)
+  // 3D noise buffers for cave/ravine per strip (CHUNK_SIZE x slab height x 1)
   std::array<float, CHUNK_SIZE * CHUNK_HEIGHT> borderCave;
   std::array<float, CHUNK_SIZE * CHUNK_HEIGHT> borderRavine;
   std::array<float, CHUNK_SIZE * CHUNK_HEIGHT> borderSurface3D;
@@ -552,11 +685,16 @@ struct GenBuffers
   std::array<float, CHUNK_SIZE * CHUNK_SIZE> treeNoiseResults;
   std::array<float, CHUNK_SIZE * CHUNK_SIZE> forestDensityResults;
 
-  // Reusable buffer for erosion calculation
-  std::array<float, 20 * 20> erosionTempMap;
+  // Heights at the start of an erosion step, read while the step updates erosionHeightMap
+  std::vector<float> erosionTempMap;
+
+  // Blurred biome colours of the last chunk or region, and the atlas cells they came from
+  BiomeColorGrid biomeColors;
+  std::vector<uint8_t> biomeColorCells;
 
   // Reusable buffers for biome region generation
   // Using 512*512 max size to accommodate the UI map which defaults to 256
+  // The terrain layers also hold an erosion tile's noise
   std::vector<float> tempBuf;
   std::vector<float> humidBuf;
   std::vector<float> weirdBuf;
@@ -566,6 +704,55 @@ struct GenBuffers
   std::vector<float> pvBuf;
   std::vector<float> ridgeBuf;
 
+  // Region-batched noise for generateRegion(): 2D layers over (n*16+4)^2 so
+  // every chunk's 20x20 apron window is inside, 3D layers over
+  // (n*16+2) x slab height x (n*16+2) so every chunk's border shell is inside.
+  // The region slab is the union of its chunks' slabs.
+  struct RegionNoise
+  {
+    bool active = false;
+    int originX = 0; // World block coordinates of the first chunk origin
+    int originZ = 0;
+    int chunks = 0; // Region is chunks x chunks
+    int size2D = 0;
+    int size3D = 0;
+    NoiseSlab slab;
+    std::vector<float> continental;
+    std::vector<float> erosion;
+    std::vector<float> peaksValleys;
+    std::vector<float> ridge;
+    std::vector<float> temperature;
+    std::vector<float> humidity;
+    std::vector<float> weirdness;
+    std::vector<float> river;
+    std::vector<float> cave;
+    std::vector<float> ravine;
+    std::vector<float> surface3D;
+
+    bool covers(int chunkX, int chunkZ) const
+    {
+      return active &&
+             chunkX >= originX && chunkX < originX + chunks * CHUNK_SIZE &&
+             chunkZ >= originZ && chunkZ < originZ + chunks * CHUNK_SIZE;
+    }
+  } region;
+
+  // NoiseSampling::Coarse scratch: lattice positions and values, plus the
+  // per-axis cell/weight tables and one y/z-interpolated lattice row
+  struct CoarseLattice
+  {
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> posZ;
+    std::vector<float> values;
+    std::vector<float> row;
+    std::vector<int> cellX;
+    std::vector<float> weightX;
+  } coarse;
+
+  // 3D noise evaluations since the last reset (reported through ChunkGenTimings)
+  size_t noise3DSamples = 0;
+
   // Persistent generator to avoid expensive setup every chunk
   std::unique_ptr<TerrainGenerator> generator;
 };
@@ -581,109 +768,428 @@ TerrainGenerator &TerrainGenerator::getThreadLocal(int seed)
   return *s_genBuffers.generator;
 }
 
+// Copy one chunk's 20x20 apron window out of the region buffers into the
+// per-chunk buffers generateChunkBatch reads.
+static void sliceRegionNoise2D(int chunkX, int chunkZ)
+{
+  const GenBuffers::RegionNoise &region = s_genBuffers.region;
+  const int EXTENDED_SIZE = 20;
+
+  // Chunk origin relative to the region; the 2D apron (-2) cancels against
+  // the region's own apron offset.
+  const int offX = chunkX - region.originX;
+  const int offZ = chunkZ - region.originZ;
+
+  auto copy2D = [&](const std::vector<float> &src, std::array<float, 20 * 20> &dst)
+  {
+    for (int z = 0; z < EXTENDED_SIZE; ++z)
+      std::copy_n(src.data() + (offZ + z) * region.size2D + offX, EXTENDED_SIZE, dst.data() + z * EXTENDED_SIZE);
+  };
+  copy2D(region.continental, s_genBuffers.continental);
+  copy2D(region.erosion, s_genBuffers.erosion);
+  copy2D(region.peaksValleys, s_genBuffers.peaksValleys);
+  copy2D(region.ridge, s_genBuffers.ridge);
+  copy2D(region.temperature, s_genBuffers.temperature);
+  copy2D(region.humidity, s_genBuffers.humidity);
+  copy2D(region.weirdness, s_genBuffers.weirdness);
+  copy2D(region.river, s_genBuffers.river);
+}
+
+// Copy an xSize x [minY, maxY] x zSize box (chunk-local start lx/lz) of one
+// region 3D layer into dst, laid out z, y, x.
+static void sliceRegionBox(const std::vector<float> &src, int regionMinY, int chunkX, int chunkZ,
+                           int lxStart, int lzStart, int xSize, int zSize, int minY, int maxY, float *dst)
+{
+  const GenBuffers::RegionNoise &region = s_genBuffers.region;
+  const int regionHeight = static_cast<int>(src.size()) / (region.size3D * region.size3D);
+  const int baseX = chunkX - region.originX + 1 + lxStart; // +1: region 3D shell
+  const int baseZ = chunkZ - region.originZ + 1 + lzStart;
+  const int height = maxY - minY + 1;
+
+  for (int z = 0; z < zSize; ++z)
+    for (int y = 0; y < height; ++y)
+      std::copy_n(src.data() + (baseZ + z) * (regionHeight * region.size3D) + (minY - regionMinY + y) * region.size3D + baseX,
+                  xSize, dst + z * (height * xSize) + y * xSize);
+}
+
 // =============================================
 // CHUNK GENERATION
 // =============================================
 
-ChunkData TerrainGenerator::generateChunk(int chunkX, int chunkZ)
+ChunkData TerrainGenerator::generateChunk(int chunkX, int chunkZ, ChunkGenTimings *timings)
+{
+  ChunkData chunkData = generateTerrain(chunkX, chunkZ, timings);
+
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point t0 = timings ? Clock::now() : Clock::time_point{};
+  decorateChunk(chunkData, chunkX, chunkZ);
+  if (timings)
+    timings->vegetationMs = std::chrono::duration<float, std::milli>(Clock::now() - t0).count();
+
+  return chunkData;
+}
+
+ChunkData TerrainGenerator::generateTerrain(int chunkX, int chunkZ, ChunkGenTimings *timings)
 {
+  using Clock = std::chrono::steady_clock;
+  auto elapsedMs = [](Clock::time_point from, Clock::time_point to)
+  {
+    return std::chrono::duration<float, std::milli>(to - from).count();
+  };
+
   ChunkData chunkData;
   chunkData.voxels.assign(CHUNK_VOLUME, {TextureType::AIR});
   chunkData.borderVoxels.assign(18 * (CHUNK_HEIGHT + 2) * 18,
                                 static_cast<uint8_t>(AIR));
 
   // Generate the main chunk data
+  s_genBuffers.noise3DSamples = 0;
+  Clock::time_point t0 = timings ? Clock::now() : Clock::time_point{};
   generateChunkBatch(chunkData, chunkX, chunkZ);
-
-  // Generate vegetation (trees, cacti, etc.)
-  generateVegetation(chunkData, chunkX, chunkZ);
+  Clock::time_point t1 = timings ? Clock::now() : Clock::time_point{};
 
   // Generate border voxels for mesh optimization
   generateChunkBorders(chunkData, chunkX, chunkZ);
 
+  if (timings)
+  {
+    timings->batchMs = elapsedMs(t0, t1);
+    timings->bordersMs = elapsedMs(t1, Clock::now());
+    timings->noise3DSamples = s_genBuffers.noise3DSamples;
+  }
+
   return chunkData;
 }
 
-void TerrainGenerator::generateChunkBatch(ChunkData &chunkData, int chunkX,
-                                          int chunkZ)
+SurfaceData TerrainGenerator::generateSurface(int chunkX, int chunkZ)
 {
-  constexpr int totalPoints = CHUNK_SIZE * CHUNK_SIZE;
-  constexpr int totalVoxels = CHUNK_VOLUME;
+  // The column pass of generateTerrain(): heights and biomes are the same.
+  // Only the per-column arrays of chunkData get filled.
+  ChunkData chunkData;
+  generateColumnData(chunkData, chunkX, chunkZ);
 
-  // Use thread-local scratch buffers to avoid heap allocations
-  float *continentalResults = s_genBuffers.continental.data();
-  float *erosionResults = s_genBuffers.erosion.data();
-  float *peaksValleysResults = s_genBuffers.peaksValleys.data();
-  float *ridgeResults = s_genBuffers.ridge.data();
+  const int EXTENDED_SIZE = 20;
+  const float *temperatureResults = s_genBuffers.temperature.data();
 
-  // Biome noise buffers
-  float *temperatureResults = s_genBuffers.temperature.data();
-  float *humidityResults = s_genBuffers.humidity.data();
-  float *weirdnessResults = s_genBuffers.weirdness.data();
-  float *riverResults = s_genBuffers.river.data();
+  SurfaceData surface;
+  for (int localZ = 0; localZ < CHUNK_SIZE; ++localZ)
+  {
+    for (int localX = 0; localX < CHUNK_SIZE; ++localX)
+    {
+      const int localIndex = getColumnIndex(localX, localZ);
+      const int height = chunkData.heightMap[localIndex];
+      const BiomeType biome = chunkData.biomes[localIndex];
+      const float temperature = std::clamp(temperatureResults[(localZ + 2) * EXTENDED_SIZE + localX + 2], -1.0f, 1.0f);
+
+      // The ground is at `height`; below sea level the water (or ice) on top of it shows
+      const int topY = std::max(height, SEA_LEVEL);
+      surface.topY[localIndex] = static_cast<uint8_t>(topY);
+      surface.topType[localIndex] = static_cast<uint8_t>(
+          getVoxelTypeAt(chunkX + localX, topY, chunkZ + localZ, height, biome, temperature));
+    }
+  }
+  surface.colors = chunkData.colors;
+  return surface;
+}
 
-  // 3D Noise buffers
-  float *caveResults = s_genBuffers.cave.data();
-  float *ravineResults = s_genBuffers.ravine.data();
-  float *surface3DResults = s_genBuffers.surface3D.data();
+void TerrainGenerator::decorateChunk(ChunkData &chunkData, int chunkX, int chunkZ)
+{
+  chunkData.spill.clear();
+  generateVegetation(chunkData, chunkX, chunkZ);
+  // After the trees: a structure clears what grew inside it
+  placeStructures(chunkData, chunkX, chunkZ);
+}
 
-  float worldXf = static_cast<float>(chunkX) + NOISE_OFFSET;
-  float worldZf = static_cast<float>(chunkZ) + NOISE_OFFSET;
+std::vector<ChunkData> TerrainGenerator::generateRegion(int regionX, int regionZ, int n, bool decorate)
+{
+  n = std::clamp(n, 1, MAX_REGION_CHUNKS);
+
+  GenBuffers::RegionNoise &region = s_genBuffers.region;
+  region.originX = regionX;
+  region.originZ = regionZ;
+  region.chunks = n;
+  region.size2D = n * CHUNK_SIZE + 4;
+  region.size3D = n * CHUNK_SIZE + 2;
+
+  const size_t points2D = static_cast<size_t>(region.size2D) * region.size2D;
+  for (std::vector<float> *layer : {&region.continental, &region.erosion, &region.peaksValleys, &region.ridge,
+                                    &region.temperature, &region.humidity, &region.weirdness, &region.river})
+    layer->resize(points2D);
+
+  // One call per layer for the whole region. Sample positions are the same
+  // integer world coordinates as per-chunk generation, so results match it.
+  const float start2DX = static_cast<float>(regionX - 2) + NOISE_OFFSET;
+  const float start2DZ = static_cast<float>(regionZ - 2) + NOISE_OFFSET;
+  const int s2 = region.size2D;
+  genGrid2D(TerrainProfiler::NOISE_CONTINENTAL, m_graphs->continental, region.continental.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed);
+  genGrid2D(TerrainProfiler::NOISE_EROSION, m_graphs->erosion, region.erosion.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed + 1000);
+  genGrid2D(TerrainProfiler::NOISE_PEAKS_VALLEYS, m_graphs->peaksValleys, region.peaksValleys.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed + 2000);
+  genGrid2D(TerrainProfiler::NOISE_RIDGE, m_graphs->ridge, region.ridge.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed + 3000);
+  genGrid2D(TerrainProfiler::NOISE_TEMPERATURE, m_graphs->temperature, region.temperature.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed + 6000);
+  genGrid2D(TerrainProfiler::NOISE_HUMIDITY, m_graphs->humidity, region.humidity.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed + 7000);
+  genGrid2D(TerrainProfiler::NOISE_WEIRDNESS, m_graphs->weirdness, region.weirdness.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed + 8000);
+  genGrid2D(TerrainProfiler::NOISE_RIVER, m_graphs->river, region.river.data(), start2DX, start2DZ, s2, s2, 1.0f, m_seed + 9000);
+
+  region.active = true;
+  buildBiomeColors(regionX, regionZ, n);
+
+  // The 3D slab depends on every chunk's eroded heights and biomes, so run the
+  // cheap column pass once up front to size the region volume. It is re-run
+  // per chunk below, since the 20x20 scratch buffers are shared.
+  std::vector<ChunkData> chunks(static_cast<size_t>(n) * n);
+  region.slab = NoiseSlab{};
+  region.slab.caveMaxY = 0;
+  for (int cz = 0; cz < n; ++cz)
+  {
+    for (int cx = 0; cx < n; ++cx)
+    {
+      generateColumnData(chunks[cz * n + cx], regionX + cx * CHUNK_SIZE, regionZ + cz * CHUNK_SIZE);
+      region.slab.merge(s_genBuffers.slab);
+    }
+  }
 
+  const int s3 = region.size3D;
+  const int caveHeight = region.slab.caveHeight();
+  const int surfaceHeight = region.slab.surfaceHeight();
+  region.cave.resize(static_cast<size_t>(s3) * caveHeight * s3);
+  region.ravine.resize(region.cave.size());
+  region.surface3D.resize(static_cast<size_t>(s3) * surfaceHeight * s3);
+
+  sampleNoise3D(NOISE_3D_CAVE, region.cave.data(), regionX - 1, region.slab.caveMinY, regionZ - 1,
+                s3, caveHeight, s3);
+  sampleNoise3D(NOISE_3D_RAVINE, region.ravine.data(), regionX - 1, region.slab.caveMinY, regionZ - 1,
+                s3, caveHeight, s3);
+  if (surfaceHeight > 0)
+  {
+    sampleNoise3D(NOISE_3D_SURFACE, region.surface3D.data(), regionX - 1, region.slab.surfaceMinY, regionZ - 1,
+                  s3, surfaceHeight, s3);
+  }
+
+  for (int cz = 0; cz < n; ++cz)
+  {
+    for (int cx = 0; cx < n; ++cx)
+    {
+      const int chunkX = regionX + cx * CHUNK_SIZE;
+      const int chunkZ = regionZ + cz * CHUNK_SIZE;
+      ChunkData &chunkData = chunks[cz * n + cx];
+      chunkData.voxels.assign(CHUNK_VOLUME, {TextureType::AIR});
+      chunkData.borderVoxels.assign(18 * (CHUNK_HEIGHT + 2) * 18,
+                                    static_cast<uint8_t>(AIR));
+
+      generateChunkBatch(chunkData, chunkX, chunkZ);
+      generateChunkBorders(chunkData, chunkX, chunkZ);
+      if (decorate)
+        decorateChunk(chunkData, chunkX, chunkZ);
+    }
+  }
+
+  region.active = false;
+
+  // The 3D volumes can be several MB per layer: don't keep them alive on
+  // every worker thread between regions.
+  for (std::vector<float> *layer : {&region.cave, &region.ravine, &region.surface3D})
+    std::vector<float>().swap(*layer);
+
+  return chunks;
+}
+
+void TerrainGenerator::sampleChunkNoise2D(int chunkX, int chunkZ)
+{
   // Generate terrain noise for 20x20 extended area (offset by -2 from chunk origin)
-  float extendedWorldXf = worldXf - 2.0f;
-  float extendedWorldZf = worldZf - 2.0f;
+  float extendedWorldXf = static_cast<float>(chunkX) + NOISE_OFFSET - 2.0f;
+  float extendedWorldZf = static_cast<float>(chunkZ) + NOISE_OFFSET - 2.0f;
   const int EXTENDED_SIZE = 20;
 
-  m_continentalNoise->GenUniformGrid2D(continentalResults, extendedWorldXf,
-                                       extendedWorldZf, EXTENDED_SIZE, EXTENDED_SIZE, 1.0f,
-                                       m_seed);
+  genGrid2D(TerrainProfiler::NOISE_CONTINENTAL, m_graphs->continental, s_genBuffers.continental.data(), extendedWorldXf,
+            extendedWorldZf, EXTENDED_SIZE, EXTENDED_SIZE, 1.0f,
+            m_seed);
 
-  m_erosionNoise->GenUniformGrid2D(erosionResults, extendedWorldXf, extendedWorldZf,
-                                   EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 1000);
+  genGrid2D(TerrainProfiler::NOISE_EROSION, m_graphs->erosion, s_genBuffers.erosion.data(), extendedWorldXf, extendedWorldZf,
+            EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 1000);
 
-  m_peaksValleysNoise->GenUniformGrid2D(peaksValleysResults, extendedWorldXf,
-                                        extendedWorldZf, EXTENDED_SIZE, EXTENDED_SIZE, 1.0f,
-                                        m_seed + 2000);
+  genGrid2D(TerrainProfiler::NOISE_PEAKS_VALLEYS, m_graphs->peaksValleys, s_genBuffers.peaksValleys.data(), extendedWorldXf,
+            extendedWorldZf, EXTENDED_SIZE, EXTENDED_SIZE, 1.0f,
+            m_seed + 2000);
 
-  m_ridgeNoise->GenUniformGrid2D(ridgeResults, extendedWorldXf, extendedWorldZf,
-                                 EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 3000);
+  genGrid2D(TerrainProfiler::NOISE_RIDGE, m_graphs->ridge, s_genBuffers.ridge.data(), extendedWorldXf, extendedWorldZf,
+            EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 3000);
 
   // Generate biome noise for extended area
-  m_temperatureNoise->GenUniformGrid2D(temperatureResults, extendedWorldXf, extendedWorldZf,
-                                       EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 6000);
+  genGrid2D(TerrainProfiler::NOISE_TEMPERATURE, m_graphs->temperature, s_genBuffers.temperature.data(), extendedWorldXf, extendedWorldZf,
+            EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 6000);
 
-  m_humidityNoise->GenUniformGrid2D(humidityResults, extendedWorldXf, extendedWorldZf,
-                                    EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 7000);
+  genGrid2D(TerrainProfiler::NOISE_HUMIDITY, m_graphs->humidity, s_genBuffers.humidity.data(), extendedWorldXf, extendedWorldZf,
+            EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 7000);
 
-  m_weirdnessNoise->GenUniformGrid2D(weirdnessResults, extendedWorldXf, extendedWorldZf,
-                                     EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 8000);
-  m_riverNoise->GenUniformGrid2D(riverResults, extendedWorldXf, extendedWorldZf,
-                                 EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 9000);
+  genGrid2D(TerrainProfiler::NOISE_WEIRDNESS, m_graphs->weirdness, s_genBuffers.weirdness.data(), extendedWorldXf, extendedWorldZf,
+            EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 8000);
+  genGrid2D(TerrainProfiler::NOISE_RIVER, m_graphs->river, s_genBuffers.river.data(), extendedWorldXf, extendedWorldZf,
+            EXTENDED_SIZE, EXTENDED_SIZE, 1.0f, m_seed + 9000);
+}
 
-  // Pre-calculate float heights for the 20x20 extended map
-  float *extHeightMap = s_genBuffers.extendedHeightMap.data();
-  for (int i = 0; i < EXTENDED_SIZE * EXTENDED_SIZE; ++i)
+void TerrainGenerator::sampleChunkNoise3D(int chunkX, int chunkZ)
+{
+  const NoiseSlab &slab = s_genBuffers.slab;
+
+  if (s_genBuffers.region.covers(chunkX, chunkZ))
+  {
+    const GenBuffers::RegionNoise &region = s_genBuffers.region;
+    sliceRegionBox(region.cave, region.slab.caveMinY, chunkX, chunkZ, 0, 0, CHUNK_SIZE, CHUNK_SIZE,
+                   slab.caveMinY, slab.caveMaxY, s_genBuffers.cave.data());
+    sliceRegionBox(region.ravine, region.slab.caveMinY, chunkX, chunkZ, 0, 0, CHUNK_SIZE, CHUNK_SIZE,
+                   slab.caveMinY, slab.caveMaxY, s_genBuffers.ravine.data());
+    if (slab.surfaceHeight() > 0)
+      sliceRegionBox(region.surface3D, region.slab.surfaceMinY, chunkX, chunkZ, 0, 0, CHUNK_SIZE, CHUNK_SIZE,
+                     slab.surfaceMinY, slab.surfaceMaxY, s_genBuffers.surface3D.data());
+    return;
+  }
+
+  // Caves and ravines only over the solid band, surface3D only around mountain surfaces
+  sampleNoise3D(NOISE_3D_CAVE, s_genBuffers.cave.data(), chunkX, slab.caveMinY, chunkZ,
+                CHUNK_SIZE, slab.caveHeight(), CHUNK_SIZE);
+  sampleNoise3D(NOISE_3D_RAVINE, s_genBuffers.ravine.data(), chunkX, slab.caveMinY, chunkZ,
+                CHUNK_SIZE, slab.caveHeight(), CHUNK_SIZE);
+
+  if (slab.surfaceHeight() > 0)
+  {
+    sampleNoise3D(NOISE_3D_SURFACE, s_genBuffers.surface3D.data(), chunkX, slab.surfaceMinY, chunkZ,
+                  CHUNK_SIZE, slab.surfaceHeight(), CHUNK_SIZE);
+  }
+}
+
+// Floor division, for lattice cells of negative world coordinates
+static inline int floorDiv(int a, int b)
+{
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+void TerrainGenerator::sampleNoise3D(Noise3DLayer layer, float *out, int worldX, int minY, int worldZ,
+                                     int xSize, int ySize, int zSize)
+{
+  const FastNoise::SmartNode<FastNoise::Generator> &node =
+      layer == NOISE_3D_CAVE ? m_graphs->cave : (layer == NOISE_3D_RAVINE ? m_graphs->ravine : m_graphs->surface3D);
+  const int seed = m_seed + (layer == NOISE_3D_CAVE ? 4000 : (layer == NOISE_3D_RAVINE ? 5000 : 6000));
+  const auto counter = static_cast<TerrainProfiler::Counter>(TerrainProfiler::NOISE_CAVE + static_cast<int>(layer));
+
+  if (m_noiseSampling[layer] == NoiseSampling::Full)
+  {
+    TerrainProfiler::Scope profile(counter);
+    node->GenUniformGrid3D(out, static_cast<float>(worldX) + NOISE_OFFSET, static_cast<float>(minY),
+                           static_cast<float>(worldZ) + NOISE_OFFSET, xSize, ySize, zSize, 1.0f, seed);
+    s_genBuffers.noise3DSamples += static_cast<size_t>(xSize) * ySize * zSize;
+    return;
+  }
+
+  // Lattice points at world multiples of the step, from the cell holding the
+  // first voxel to one past the cell holding the last one (the apron), so
+  // every voxel has all 8 corners.
+  const int latX0 = floorDiv(worldX, COARSE_STEP_XZ);
+  const int latY0 = floorDiv(minY, COARSE_STEP_Y);
+  const int latZ0 = floorDiv(worldZ, COARSE_STEP_XZ);
+  const int nx = floorDiv(worldX + xSize - 1, COARSE_STEP_XZ) + 2 - latX0;
+  const int ny = floorDiv(minY + ySize - 1, COARSE_STEP_Y) + 2 - latY0;
+  const int nz = floorDiv(worldZ + zSize - 1, COARSE_STEP_XZ) + 2 - latZ0;
+  const int count = nx * ny * nz;
+
+  GenBuffers::CoarseLattice &lattice = s_genBuffers.coarse;
+  lattice.posX.resize(count);
+  lattice.posY.resize(count);
+  lattice.posZ.resize(count);
+  lattice.values.resize(count);
+  lattice.row.resize(nx);
+  lattice.cellX.resize(xSize);
+  lattice.weightX.resize(xSize);
+
+  int index = 0;
+  for (int k = 0; k < nz; ++k)
+  {
+    for (int j = 0; j < ny; ++j)
+    {
+      for (int i = 0; i < nx; ++i, ++index)
+      {
+        lattice.posX[index] = static_cast<float>((latX0 + i) * COARSE_STEP_XZ) + NOISE_OFFSET;
+        lattice.posY[index] = static_cast<float>((latY0 + j) * COARSE_STEP_Y);
+        lattice.posZ[index] = static_cast<float>((latZ0 + k) * COARSE_STEP_XZ) + NOISE_OFFSET;
+      }
+    }
+  }
+  {
+    TerrainProfiler::Scope profile(counter);
+    node->GenPositionArray3D(lattice.values.data(), count, lattice.posX.data(), lattice.posY.data(),
+                             lattice.posZ.data(), 0.0f, 0.0f, 0.0f, seed);
+  }
+  s_genBuffers.noise3DSamples += count;
+
+  for (int x = 0; x < xSize; ++x)
+  {
+    const int offset = worldX + x - latX0 * COARSE_STEP_XZ;
+    lattice.cellX[x] = offset / COARSE_STEP_XZ;
+    lattice.weightX[x] = static_cast<float>(offset % COARSE_STEP_XZ) * (1.0f / COARSE_STEP_XZ);
+  }
+
+  // Interpolate y/z once per lattice column of the row, then x per voxel. Each
+  // voxel goes through the same operations on the same corners whatever box it
+  // was requested in, so overlapping requests agree bit for bit.
+  const float *values = lattice.values.data();
+  float *row = lattice.row.data();
+  const int *cellX = lattice.cellX.data();
+  const float *weightX = lattice.weightX.data();
+  for (int z = 0; z < zSize; ++z)
   {
-    extHeightMap[i] = calculateHeightFloat(
-        continentalResults[i], erosionResults[i],
-        peaksValleysResults[i], ridgeResults[i], riverResults[i]);
+    const int offsetZ = worldZ + z - latZ0 * COARSE_STEP_XZ;
+    const int cellZ = offsetZ / COARSE_STEP_XZ;
+    const float wz = static_cast<float>(offsetZ % COARSE_STEP_XZ) * (1.0f / COARSE_STEP_XZ);
+
+    for (int y = 0; y < ySize; ++y)
+    {
+      const int offsetY = minY + y - latY0 * COARSE_STEP_Y;
+      const int cellY = offsetY / COARSE_STEP_Y;
+      const float wy = static_cast<float>(offsetY % COARSE_STEP_Y) * (1.0f / COARSE_STEP_Y);
+
+      const float *c00 = values + (cellZ * ny + cellY) * nx;
+      const float *c01 = c00 + nx;      // y + 1
+      const float *c10 = c00 + ny * nx; // z + 1
+      const float *c11 = c10 + nx;
+      for (int i = 0; i < nx; ++i)
+      {
+        const float a = c00[i] + (c01[i] - c00[i]) * wy;
+        const float b = c10[i] + (c11[i] - c10[i]) * wy;
+        row[i] = a + (b - a) * wz;
+      }
+
+      float *dst = out + (z * ySize + y) * xSize;
+      for (int x = 0; x < xSize; ++x)
+      {
+        const float v0 = row[cellX[x]];
+        const float v1 = row[cellX[x] + 1];
+        dst[x] = v0 + (v1 - v0) * weightX[x];
+      }
+    }
   }
+}
 
-  // Apply erosion smoothing step to the float heightmap
-  applyErosion(extHeightMap, EXTENDED_SIZE);
+void TerrainGenerator::generateColumnData(ChunkData &chunkData, int chunkX, int chunkZ)
+{
+  TerrainProfiler::Scope profile(TerrainProfiler::PASS_HEIGHTS);
+  const int EXTENDED_SIZE = 20;
+  float *continentalResults = s_genBuffers.continental.data();
+  float *erosionResults = s_genBuffers.erosion.data();
+  float *peaksValleysResults = s_genBuffers.peaksValleys.data();
+  float *temperatureResults = s_genBuffers.temperature.data();
+  float *humidityResults = s_genBuffers.humidity.data();
+  float *weirdnessResults = s_genBuffers.weirdness.data();
+  float *riverResults = s_genBuffers.river.data();
 
-  // Generate 3D noise for caves and ravines (only needs 16x16 chunk area)
-  m_caveNoise->GenUniformGrid3D(caveResults, worldXf, 0.0f, worldZf,
-                                CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE, 1.0f,
-                                m_seed + 4000);
+  // Noise comes from the surrounding generateRegion() pass when there is one
+  if (s_genBuffers.region.covers(chunkX, chunkZ))
+    sliceRegionNoise2D(chunkX, chunkZ);
+  else
+    sampleChunkNoise2D(chunkX, chunkZ);
 
-  m_ravineNoise->GenUniformGrid3D(ravineResults, worldXf, 0.0f, worldZf,
-                                  CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE, 1.0f,
-                                  m_seed + 5000);
-  m_surface3DNoise->GenUniformGrid3D(surface3DResults, worldXf, 0.0f, worldZf,
-                                     CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE, 1.0f,
-                                     m_seed + 6000);
+  // Eroded float heights for the 20x20 extended map. Every column comes from
+  // the one tile it belongs to, so chunks agree on their shared borders.
+  float *extHeightMap = s_genBuffers.extendedHeightMap.data();
+  fillErodedHeights(extHeightMap, chunkX - 2, chunkZ - 2, EXTENDED_SIZE);
 
   // Pass 1: Extract 16x16 biomes and heights from the eroded 20x20 map
   for (int localZ = 0; localZ < CHUNK_SIZE; ++localZ)
@@ -704,117 +1210,149 @@ void TerrainGenerator::generateChunkBatch(ChunkData &chunkData, int chunkX,
       float erosion = std::clamp(erosionResults[extIndex], -1.0f, 1.0f);
       float pv = std::clamp(peaksValleysResults[extIndex], -1.0f, 1.0f);
 
-      int height = std::clamp(static_cast<int>(std::round(extHeightMap[extIndex])), 1, static_cast<int>(CHUNK_HEIGHT - HEIGHT_CEILING_MARGIN));
+      int height = roundedColumnHeight(extHeightMap[extIndex]);
 
       BiomeType biome = determineBiome(temperature, humidity, weirdness,
                                        continental, erosion, pv, riverVal, height);
 
       chunkData.biomes[localIndex] = biome;
       chunkData.heightMap[localIndex] = height;
-
-      // Precompute packed biome colors for mesh generation
-      const BiomeConfig &cfg = getBiomeConfig(biome);
-      chunkData.grassColors[localIndex] = packColor(cfg.grassColor);
-      chunkData.foliageColors[localIndex] = packColor(cfg.foliageColor);
     }
   }
 
-  // Pass 2: Generate voxel columns
-  for (int localZ = 0; localZ < CHUNK_SIZE; ++localZ)
+  // Blended colours, from the grid generateRegion() built when there is one
+  BiomeColorGrid &colorGrid = s_genBuffers.biomeColors;
+  if (!colorGrid.covers(m_seed, chunkX, chunkZ))
+    buildBiomeColors(chunkX, chunkZ, 1);
+  colorGrid.sample(chunkX, chunkZ, chunkData.colors);
+
+  // Size the 3D slab over the core and the border shell (ext 1..18), with the
+  // same height/biome the border pass will derive for the shell columns.
+  NoiseSlab &slab = s_genBuffers.slab;
+  slab = NoiseSlab{};
+  int maxHeight = 0;
+  for (int extZ = 1; extZ <= CHUNK_SIZE + 1; ++extZ)
   {
-    for (int localX = 0; localX < CHUNK_SIZE; ++localX)
+    for (int extX = 1; extX <= CHUNK_SIZE + 1; ++extX)
     {
-      int colIndex = getColumnIndex(localX, localZ);
-      int terrainHeight = chunkData.heightMap[colIndex];
-      BiomeType biome = chunkData.biomes[colIndex];
-      int extIndex = (localZ + 2) * EXTENDED_SIZE + (localX + 2);
-      float temperature = std::clamp(temperatureResults[extIndex], -1.0f, 1.0f);
-
-      // Determine if this column is mountainous (allow 3D surface perturbation)
-      bool isMountain = (biome == BIOME_MOUNTAINS || biome == BIOME_SNOWY_MOUNTAINS);
+      int extIndex = extZ * EXTENDED_SIZE + extX;
+      int height = roundedColumnHeight(extHeightMap[extIndex]);
+      maxHeight = std::max(maxHeight, height);
 
-      int actualMaxHeight = 0;
-      for (int y = 0; y < CHUNK_HEIGHT; ++y)
+      BiomeType biome;
+      bool isCore = extX >= 2 && extX < CHUNK_SIZE + 2 && extZ >= 2 && extZ < CHUNK_SIZE + 2;
+      if (isCore)
+        biome = chunkData.biomes[getColumnIndex(extX - 2, extZ - 2)];
+      else
+        biome = determineBiome(std::clamp(temperatureResults[extIndex], -1.0f, 1.0f),
+                               std::clamp(humidityResults[extIndex], -1.0f, 1.0f),
+                               std::clamp(weirdnessResults[extIndex], -1.0f, 1.0f),
+                               std::clamp(continentalResults[extIndex], -1.0f, 1.0f),
+                               std::clamp(erosionResults[extIndex], -1.0f, 1.0f),
+                               std::clamp(peaksValleysResults[extIndex], -1.0f, 1.0f),
+                               riverResults[extIndex], height);
+
+      if (biome == BIOME_MOUNTAINS || biome == BIOME_SNOWY_MOUNTAINS)
       {
-        int voxelIndex = getVoxelIndex(localX, y, localZ);
-        int noiseIndex = (localZ * CHUNK_HEIGHT * CHUNK_SIZE) + (y * CHUNK_SIZE) + localX;
+        slab.surfaceMinY = std::min(slab.surfaceMinY, std::max(0, height - SURFACE_BAND_BELOW));
+        slab.surfaceMaxY = std::max(slab.surfaceMaxY, std::min(CHUNK_HEIGHT - 1, height + SURFACE_BAND_ABOVE));
+      }
+    }
+  }
+  slab.caveMaxY = std::min(CHUNK_HEIGHT - 1, maxHeight + SURFACE_BAND_ABOVE);
+}
 
-        float caveVal = caveResults[noiseIndex];
-        float ravineVal = ravineResults[noiseIndex];
-        float surface3DVal = surface3DResults[noiseIndex];
+void TerrainGenerator::generateChunkBatch(ChunkData &chunkData, int chunkX,
+                                          int chunkZ)
+{
+  // 2D noise, heights, biomes and the 3D slab bounds
+  generateColumnData(chunkData, chunkX, chunkZ);
 
-        // 3D density: base density is distance below the heightmap surface
-        float density = static_cast<float>(terrainHeight - y);
+  // 3D noise restricted to the slab
+  sampleChunkNoise3D(chunkX, chunkZ);
 
-        // Only perturb the surface near the heightmap boundary, and only
-        // for mountainous biomes (creates overhangs/cliffs). Plains stay flat.
-        if (isMountain && density > -8.0f && density < 12.0f) {
-           // Smooth blend: full effect at surface, fades to zero at edges
-           float distToSurface = std::abs(density);
-           float blend = std::max(0.0f, 1.0f - distToSurface / 12.0f);
-           density += surface3DVal * 8.0f * blend;
-        }
+  const int EXTENDED_SIZE = 20;
+  const NoiseSlab &slab = s_genBuffers.slab;
+  const float *temperatureResults = s_genBuffers.temperature.data();
+  const float *caveResults = s_genBuffers.cave.data();
+  const float *ravineResults = s_genBuffers.ravine.data();
+  const float *surface3DResults = s_genBuffers.surface3D.data();
+  const int caveHeight = slab.caveHeight();
+  const int surfaceHeight = slab.surfaceHeight();
 
-        TextureType type;
-        if (density >= 0.0f) {
-            // Pass density so overhangs can have grass/dirt/stone correctly
-            type = getVoxelTypeAt(chunkX + localX, y, chunkZ + localZ, terrainHeight, biome, temperature, density);
-            
-            if (type != TextureType::BEDROCK && type != TextureType::WATER)
-            {
-              float heightRatio = std::clamp(static_cast<float>(y - SEA_LEVEL) / 64.0f, 0.0f, 1.0f);
-              float caveThreshold = 0.6f + heightRatio * 0.35f;
-              float ravineThreshold = 0.8f + heightRatio * 0.15f;
+  // Share the edge columns' 3D noise with the border pass of the neighbours
+  publishEdgeNoise(chunkData, chunkX, chunkZ);
 
-              if (caveVal > caveThreshold || ravineVal > ravineThreshold)
-              {
-                type = TextureType::AIR;
-              }
-            }
-        } else {
-            type = getVoxelTypeAt(chunkX + localX, y, chunkZ + localZ, terrainHeight, biome, temperature, density);
-        }
+  // Pass 2: Generate voxel columns
+  std::array<uint8_t, CHUNK_HEIGHT> columnTypes;
+  TerrainProfiler::Scope fillProfile(TerrainProfiler::PASS_COLUMN_FILL);
+  for (int localZ = 0; localZ < CHUNK_SIZE; ++localZ)
+  {
+    for (int localX = 0; localX < CHUNK_SIZE; ++localX)
+    {
+      int colIndex = getColumnIndex(localX, localZ);
+      int extIndex = (localZ + 2) * EXTENDED_SIZE + (localX + 2);
 
-        if (type != TextureType::AIR && type != TextureType::WATER) {
-            actualMaxHeight = std::max(actualMaxHeight, y);
-        }
-        chunkData.voxels[voxelIndex].type = type;
-      }
-      chunkData.heightMap[colIndex] = actualMaxHeight;
+      ColumnFillInput column;
+      column.worldX = chunkX + localX;
+      column.worldZ = chunkZ + localZ;
+      column.height = chunkData.heightMap[colIndex];
+      column.biome = chunkData.biomes[colIndex];
+      column.temperature = std::clamp(temperatureResults[extIndex], -1.0f, 1.0f);
+      column.seed = m_seed;
+      column.cave = caveResults + localZ * (caveHeight * CHUNK_SIZE) + localX;
+      column.ravine = ravineResults + localZ * (caveHeight * CHUNK_SIZE) + localX;
+      column.caveMinY = slab.caveMinY;
+      column.caveMaxY = slab.caveMaxY;
+      column.caveStride = CHUNK_SIZE;
+      column.surface3D = surfaceHeight > 0 ? surface3DResults + localZ * (surfaceHeight * CHUNK_SIZE) + localX : nullptr;
+      column.surfaceMinY = slab.surfaceMinY;
+      column.surfaceMaxY = slab.surfaceMaxY;
+      column.surfaceStride = CHUNK_SIZE;
+
+      chunkData.heightMap[colIndex] = fillColumn(column, columnTypes.data());
+      for (int y = 0; y < CHUNK_HEIGHT; ++y)
+        chunkData.voxels[getVoxelIndex(localX, y, localZ)].type = columnTypes[y];
     }
   }
 
-  // Ore generation pass (random-walk blobs)
-  for (const auto &ore : m_ores)
+  placeOres(chunkData, chunkX, chunkZ);
+}
+
+void TerrainGenerator::placeOres(ChunkData &chunkData, int chunkX, int chunkZ) const
+{
+  TerrainProfiler::Scope profile(TerrainProfiler::PASS_ORES);
+  Voxel *voxels = chunkData.voxels.data();
+
+  for (const auto &ore : m_graphs->ores)
   {
     int minY = std::max(0, ore.minHeight);
     int maxY = std::min(CHUNK_HEIGHT, ore.maxHeight);
     if (minY >= maxY)
       continue;
 
-    for (int i = 0; i < ore.clustersPerChunk; ++i) {
+    const uint8_t oreType = static_cast<uint8_t>(ore.type);
+    for (int i = 0; i < ore.clustersPerChunk; ++i)
+    {
       uint32_t h1 = treeHash(chunkX, chunkZ, m_seed + ore.seedOffset + i);
-      int startX = h1 % CHUNK_SIZE;
-      int startZ = (h1 >> 8) % CHUNK_SIZE;
-      int startY = minY + ((h1 >> 16) % (maxY - minY));
-
-      int x = startX, y = startY, z = startZ;
-      for (int step = 0; step < ore.clusterSize; ++step) {
-        if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < CHUNK_SIZE) {
-          int voxelIndex = getVoxelIndex(x, y, z);
-          if (chunkData.voxels[voxelIndex].type == TextureType::STONE) {
-            chunkData.voxels[voxelIndex].type = ore.type;
-          }
-        }
-        
-        uint32_t stepHash = treeHash(chunkX * CHUNK_SIZE + x, chunkZ * CHUNK_SIZE + z, m_seed + step * 7919 + y * 1337);
-        int dir = stepHash % 6;
-        if (dir == 0) x++;
-        else if (dir == 1) x--;
-        else if (dir == 2) y++;
-        else if (dir == 3) y--;
-        else if (dir == 4) z++;
-        else if (dir == 5) z--;
+      const int startX = h1 % CHUNK_SIZE;
+      const int startZ = (h1 >> 8) % CHUNK_SIZE;
+      const int startY = minY + ((h1 >> 16) % (maxY - minY));
+      const int t = treeHash(chunkX, chunkZ, m_seed + ore.seedOffset + i + 500) % ORE_TEMPLATES_PER_ORE;
+
+      // Masked scatter: offsets outside the chunk or over anything but stone
+      // keep the voxel as it is
+      for (int k = ore.templateStart[t]; k < ore.templateStart[t + 1]; ++k)
+      {
+        const int x = startX + ore.offsetX[k];
+        const int y = startY + ore.offsetY[k];
+        const int z = startZ + ore.offsetZ[k];
+        const bool inside = static_cast<unsigned>(x) < CHUNK_SIZE && static_cast<unsigned>(y) < CHUNK_HEIGHT &&
+                            static_cast<unsigned>(z) < CHUNK_SIZE;
+        const int voxelIndex = inside ? getVoxelIndex(x, y, z) : 0;
+        const uint8_t current = voxels[voxelIndex].type;
+        if (inside && current == TextureType::STONE)
+          voxels[voxelIndex].type = oreType;
       }
     }
   }
@@ -901,29 +1439,73 @@ BiomeType TerrainGenerator::determineBiome(float temperature, float humidity,
 
 BiomeType TerrainGenerator::getBiomeAt(int worldX, int worldZ) const
 {
-  float x = static_cast<float>(worldX) + NOISE_OFFSET;
-  float z = static_cast<float>(worldZ) + NOISE_OFFSET;
+  const int cellX = floorDiv(worldX + BiomeAtlas::CELL_SIZE / 2, BiomeAtlas::CELL_SIZE);
+  const int cellZ = floorDiv(worldZ + BiomeAtlas::CELL_SIZE / 2, BiomeAtlas::CELL_SIZE);
+  const int tileX = floorDiv(cellX, BiomeAtlas::TILE_CELLS);
+  const int tileZ = floorDiv(cellZ, BiomeAtlas::TILE_CELLS);
+
+  std::shared_ptr<const BiomeAtlas::Tile> tile = getBiomeTile(tileX, tileZ);
+  const int localX = cellX - tileX * BiomeAtlas::TILE_CELLS;
+  const int localZ = cellZ - tileZ * BiomeAtlas::TILE_CELLS;
+  return static_cast<BiomeType>((*tile)[localZ * BiomeAtlas::TILE_CELLS + localX]);
+}
 
-  float temp = m_temperatureNoise->GenSingle2D(x, z, m_seed + 6000);
-  float humid = m_humidityNoise->GenSingle2D(x, z, m_seed + 7000);
-  float weird = m_weirdnessNoise->GenSingle2D(x, z, m_seed + 8000);
-  float cont = m_continentalNoise->GenSingle2D(x, z, m_seed);
-  float erosion = m_erosionNoise->GenSingle2D(x, z, m_seed + 1000);
-  float pv = m_peaksValleysNoise->GenSingle2D(x, z, m_seed + 2000);
-  float ridge = m_ridgeNoise->GenSingle2D(x, z, m_seed + 3000);
-  float river = m_riverNoise->GenSingle2D(x, z, m_seed + 9000);
-  int height = calculateHeight(cont, erosion, pv, ridge, river);
+std::shared_ptr<const BiomeAtlas::Tile> TerrainGenerator::getBiomeTile(int tileX, int tileZ) const
+{
+  BiomeAtlas &atlas = BiomeAtlas::instance();
+  if (std::shared_ptr<const BiomeAtlas::Tile> tile = atlas.find(m_seed, tileX, tileZ))
+    return tile;
+
+  // Cell centers are world multiples of CELL_SIZE; NOISE_OFFSET is one too, so
+  // the grid start stays an exact integer in noise space.
+  static_assert(static_cast<int>(NOISE_OFFSET) % BiomeAtlas::CELL_SIZE == 0,
+                "NOISE_OFFSET must be a multiple of BiomeAtlas::CELL_SIZE");
+  const int offsetCells = static_cast<int>(NOISE_OFFSET) / BiomeAtlas::CELL_SIZE;
+  std::vector<BiomeType> biomes;
+  sampleBiomeGrid(tileX * BiomeAtlas::TILE_CELLS + offsetCells, tileZ * BiomeAtlas::TILE_CELLS + offsetCells,
+                  BiomeAtlas::TILE_CELLS, BiomeAtlas::TILE_CELLS, static_cast<float>(BiomeAtlas::CELL_SIZE), biomes);
+
+  auto tile = std::make_shared<BiomeAtlas::Tile>();
+  std::transform(biomes.begin(), biomes.end(), tile->begin(), [](BiomeType b)
+                 { return static_cast<uint8_t>(b); });
+  atlas.store(m_seed, tileX, tileZ, tile);
+  return tile;
+}
+
+void TerrainGenerator::buildBiomeColors(int worldX, int worldZ, int chunks) const
+{
+  TerrainProfiler::Scope profile(TerrainProfiler::PASS_BIOME_COLORS);
+  const int size = BiomeColorGrid::inputSize(chunks);
+  const int originX = BiomeColorGrid::inputOrigin(worldX);
+  const int originZ = BiomeColorGrid::inputOrigin(worldZ);
+  std::vector<uint8_t> &cells = s_genBuffers.biomeColorCells;
+  cells.resize(static_cast<size_t>(size) * size);
+
+  // The window spans at most 2x2 tiles: copy it row segment by row segment
+  for (int z = 0; z < size; ++z)
+  {
+    const int cellZ = originZ + z;
+    const int tileZ = floorDiv(cellZ, BiomeAtlas::TILE_CELLS);
+    const int localZ = cellZ - tileZ * BiomeAtlas::TILE_CELLS;
+    for (int x = 0; x < size;)
+    {
+      const int cellX = originX + x;
+      const int tileX = floorDiv(cellX, BiomeAtlas::TILE_CELLS);
+      const int localX = cellX - tileX * BiomeAtlas::TILE_CELLS;
+      const int count = std::min(size - x, BiomeAtlas::TILE_CELLS - localX);
+      std::shared_ptr<const BiomeAtlas::Tile> tile = getBiomeTile(tileX, tileZ);
+      std::copy_n(tile->data() + localZ * BiomeAtlas::TILE_CELLS + localX, count, cells.data() + z * size + x);
+      x += count;
+    }
+  }
 
-  return determineBiome(temp, humid, weird, cont, erosion, pv, river, height);
+  s_genBuffers.biomeColors.build(m_seed, worldX, worldZ, chunks, cells.data());
 }
 
 void TerrainGenerator::getBiomeRegion(float centerX, float centerZ, float step,
                                       int width, int height,
                                       std::vector<BiomeType> &outBiomes) const
 {
-  const int count = width * height;
-  outBiomes.resize(count);
-
   // GenUniformGrid2D samples pixel (xi, yi) at noise coordinate (xStart + xi) * frequency.
   // We want that to equal worldX_of_pixel + NOISE_OFFSET, where
   //   worldX_of_pixel = centerX + (xi - width/2) * step
@@ -934,6 +1516,48 @@ void TerrainGenerator::getBiomeRegion(float centerX, float centerZ, float step,
   const int startX = static_cast<int>(std::round((centerX + NOISE_OFFSET) * invStep - width * 0.5f));
   const int startZ = static_cast<int>(std::round((centerZ + NOISE_OFFSET) * invStep - height * 0.5f));
 
+  if (step < BiomeAtlas::CELL_SIZE * 0.5f)
+  {
+    sampleBiomeGrid(startX, startZ, width, height, step, outBiomes);
+    return;
+  }
+
+  // Same pixel positions, each resolved to its nearest atlas cell. Rows walk
+  // through few tiles, so the current one is kept between pixels.
+  outBiomes.resize(static_cast<size_t>(width) * height);
+  std::shared_ptr<const BiomeAtlas::Tile> tile;
+  int tileX = 0;
+  int tileZ = 0;
+  const float invCell = 1.0f / BiomeAtlas::CELL_SIZE;
+  for (int yi = 0; yi < height; ++yi)
+  {
+    const float worldZ = static_cast<float>(startZ + yi) * step - NOISE_OFFSET;
+    const int cellZ = static_cast<int>(std::floor(worldZ * invCell + 0.5f));
+    for (int xi = 0; xi < width; ++xi)
+    {
+      const float worldX = static_cast<float>(startX + xi) * step - NOISE_OFFSET;
+      const int cellX = static_cast<int>(std::floor(worldX * invCell + 0.5f));
+      const int tx = floorDiv(cellX, BiomeAtlas::TILE_CELLS);
+      const int tz = floorDiv(cellZ, BiomeAtlas::TILE_CELLS);
+      if (!tile || tx != tileX || tz != tileZ)
+      {
+        tile = getBiomeTile(tx, tz);
+        tileX = tx;
+        tileZ = tz;
+      }
+      const int localX = cellX - tx * BiomeAtlas::TILE_CELLS;
+      const int localZ = cellZ - tz * BiomeAtlas::TILE_CELLS;
+      outBiomes[yi * width + xi] = static_cast<BiomeType>((*tile)[localZ * BiomeAtlas::TILE_CELLS + localX]);
+    }
+  }
+}
+
+void TerrainGenerator::sampleBiomeGrid(int startX, int startZ, int width, int height, float step,
+                                       std::vector<BiomeType> &outBiomes) const
+{
+  const int count = width * height;
+  outBiomes.resize(count);
+
   if (s_genBuffers.tempBuf.size() < static_cast<size_t>(count))
   {
     s_genBuffers.tempBuf.resize(count);
@@ -956,14 +1580,14 @@ void TerrainGenerator::getBiomeRegion(float centerX, float centerZ, float step,
   float* ridgeBuf = s_genBuffers.ridgeBuf.data();
 
   // GenUniformGrid2D processes batches with SIMD — far faster than individual GenSingle2D calls.
-  m_temperatureNoise->GenUniformGrid2D(tempBuf, startX, startZ, width, height, step, m_seed + 6000);
-  m_humidityNoise->GenUniformGrid2D(humidBuf, startX, startZ, width, height, step, m_seed + 7000);
-  m_weirdnessNoise->GenUniformGrid2D(weirdBuf, startX, startZ, width, height, step, m_seed + 8000);
-  m_continentalNoise->GenUniformGrid2D(contBuf, startX, startZ, width, height, step, m_seed);
-  m_erosionNoise->GenUniformGrid2D(erosionBuf, startX, startZ, width, height, step, m_seed + 1000);
-  m_peaksValleysNoise->GenUniformGrid2D(pvBuf, startX, startZ, width, height, step, m_seed + 2000);
-  m_ridgeNoise->GenUniformGrid2D(ridgeBuf, startX, startZ, width, height, step, m_seed + 3000);
-  m_riverNoise->GenUniformGrid2D(riverBuf, startX, startZ, width, height, step, m_seed + 9000);
+  genGrid2D(TerrainProfiler::NOISE_TEMPERATURE, m_graphs->temperature, tempBuf, startX, startZ, width, height, step, m_seed + 6000);
+  genGrid2D(TerrainProfiler::NOISE_HUMIDITY, m_graphs->humidity, humidBuf, startX, startZ, width, height, step, m_seed + 7000);
+  genGrid2D(TerrainProfiler::NOISE_WEIRDNESS, m_graphs->weirdness, weirdBuf, startX, startZ, width, height, step, m_seed + 8000);
+  genGrid2D(TerrainProfiler::NOISE_CONTINENTAL, m_graphs->continental, contBuf, startX, startZ, width, height, step, m_seed);
+  genGrid2D(TerrainProfiler::NOISE_EROSION, m_graphs->erosion, erosionBuf, startX, startZ, width, height, step, m_seed + 1000);
+  genGrid2D(TerrainProfiler::NOISE_PEAKS_VALLEYS, m_graphs->peaksValleys, pvBuf, startX, startZ, width, height, step, m_seed + 2000);
+  genGrid2D(TerrainProfiler::NOISE_RIDGE, m_graphs->ridge, ridgeBuf, startX, startZ, width, height, step, m_seed + 3000);
+  genGrid2D(TerrainProfiler::NOISE_RIVER, m_graphs->river, riverBuf, startX, startZ, width, height, step, m_seed + 9000);
 
   for (int i = 0; i < count; i++)
   {
@@ -1086,31 +1710,225 @@ int TerrainGenerator::calculateHeight(float continental, float erosion,
   return std::clamp(static_cast<int>(std::round(heightFloat)), 1, CHUNK_HEIGHT - HEIGHT_CEILING_MARGIN);
 }
 
-void TerrainGenerator::applyErosion(float *heightMap, int size) const
+// =============================================
+// EROSION TILES
+// =============================================
+
+// Erosion steps per tile. Both kinds of step read the neighbours of a cell's
+// neighbours, so a step carries information at most 2 cells.
+static constexpr int HYDRAULIC_ITERATIONS = 16;
+static constexpr int THERMAL_ITERATIONS = 2;
+
+// Tiles are simulated over their own columns plus this margin. Nothing from
+// outside the margin can reach the tile's columns within the steps above, so
+// they come out exactly as if the whole world had been eroded at once: tiles
+// need no blending where they meet.
+static constexpr int EROSION_TILE_MARGIN = 2 * (HYDRAULIC_ITERATIONS + THERMAL_ITERATIONS);
+static constexpr int EROSION_DOMAIN = ErosionTileCache::TILE_BLOCKS + 2 * EROSION_TILE_MARGIN;
+
+// Hydraulic erosion parameters (heights and water in blocks)
+static constexpr float RAIN_PER_STEP = 0.01f;
+static constexpr float EVAPORATION_RATE = 0.04f;   // Fraction of the water lost per step
+static constexpr float SEDIMENT_CAPACITY = 2.0f;   // Per block of moving water and block of drop
+static constexpr float MIN_CAPACITY_SLOPE = 0.05f; // Flat ground still carries a little
+static constexpr float DISSOLVE_RATE = 0.3f;       // Fraction of the spare capacity eroded per step
+static constexpr float DEPOSIT_RATE = 0.3f;        // Fraction of the excess sediment dropped per step
+static constexpr float MAX_DISSOLVE = 0.25f;       // Blocks eroded from a cell per step, at most
+
+void TerrainGenerator::prefetchErosionTile(int tileX, int tileZ) const
 {
-  if (size < 2)
-    return;
+  if (!ErosionTileCache::instance().contains(m_seed, tileX, tileZ))
+    getErosionTile(tileX, tileZ);
+}
 
-  // 1. Single Thermal Erosion pass (smooths overly steep slopes deterministically)
-  // We only run 1 iteration because our extended heightmap (overlap=2)
-  // can only safely supply deterministic neighborhood data for 1 convolution pass
-  // without creating mismatches at chunk boundaries.
-  const float talusAngle = 0.6f;  // Max allowed height diff between adjacent cells
-  const float thermalRate = 0.5f; // Fraction of material to move
+std::shared_ptr<const ErosionTileCache::Tile> TerrainGenerator::getErosionTile(int tileX, int tileZ) const
+{
+  return ErosionTileCache::instance().get(m_seed, tileX, tileZ,
+                                          [this](int x, int z, ErosionTileCache::Tile &out)
+                                          { buildErosionTile(x, z, out); });
+}
+
+void TerrainGenerator::fillErodedHeights(float *out, int worldX, int worldZ, int size) const
+{
+  constexpr int TILE = ErosionTileCache::TILE_BLOCKS;
 
-  float *tempMap;
-  std::vector<float> fallbackMap;
-  if (size <= 20)
+  // Copy the window one tile-sized piece at a time (at most 2x2 for a chunk apron)
+  for (int z = 0; z < size;)
   {
-    tempMap = s_genBuffers.erosionTempMap.data();
-    std::copy(heightMap, heightMap + size * size, tempMap);
+    const int tileZ = ErosionTileCache::tileOf(worldZ + z);
+    const int localZ = worldZ + z - tileZ * TILE;
+    const int rows = std::min(size - z, TILE - localZ);
+    for (int x = 0; x < size;)
+    {
+      const int tileX = ErosionTileCache::tileOf(worldX + x);
+      const int localX = worldX + x - tileX * TILE;
+      const int cols = std::min(size - x, TILE - localX);
+
+      std::shared_ptr<const ErosionTileCache::Tile> tile = getErosionTile(tileX, tileZ);
+      for (int r = 0; r < rows; ++r)
+        std::copy_n(tile->data() + (localZ + r) * TILE + localX, cols, out + (z + r) * size + x);
+      x += cols;
+    }
+    z += rows;
   }
-  else
+}
+
+void TerrainGenerator::buildErosionTile(int tileX, int tileZ, ErosionTileCache::Tile &out) const
+{
+  const int count = EROSION_DOMAIN * EROSION_DOMAIN;
+  for (std::vector<float> *buffer : {&s_genBuffers.contBuf, &s_genBuffers.erosionBuf, &s_genBuffers.pvBuf,
+                                     &s_genBuffers.ridgeBuf, &s_genBuffers.riverBuf})
   {
-    fallbackMap.assign(heightMap, heightMap + size * size);
-    tempMap = fallbackMap.data();
+    if (buffer->size() < static_cast<size_t>(count))
+      buffer->resize(count);
+  }
+  s_genBuffers.erosionHeightMap.resize(count);
+
+  // Same integer world positions and seeds as the chunk noise, so the
+  // uneroded heights are the ones generateChunk() used to start from
+  const float startX = static_cast<float>(tileX * ErosionTileCache::TILE_BLOCKS - EROSION_TILE_MARGIN) + NOISE_OFFSET;
+  const float startZ = static_cast<float>(tileZ * ErosionTileCache::TILE_BLOCKS - EROSION_TILE_MARGIN) + NOISE_OFFSET;
+  const int d = EROSION_DOMAIN;
+  genGrid2D(TerrainProfiler::NOISE_CONTINENTAL, m_graphs->continental, s_genBuffers.contBuf.data(), startX, startZ, d, d, 1.0f, m_seed);
+  genGrid2D(TerrainProfiler::NOISE_EROSION, m_graphs->erosion, s_genBuffers.erosionBuf.data(), startX, startZ, d, d, 1.0f, m_seed + 1000);
+  genGrid2D(TerrainProfiler::NOISE_PEAKS_VALLEYS, m_graphs->peaksValleys, s_genBuffers.pvBuf.data(), startX, startZ, d, d, 1.0f, m_seed + 2000);
+  genGrid2D(TerrainProfiler::NOISE_RIDGE, m_graphs->ridge, s_genBuffers.ridgeBuf.data(), startX, startZ, d, d, 1.0f, m_seed + 3000);
+  genGrid2D(TerrainProfiler::NOISE_RIVER, m_graphs->river, s_genBuffers.riverBuf.data(), startX, startZ, d, d, 1.0f, m_seed + 9000);
+
+  float *heightMap = s_genBuffers.erosionHeightMap.data();
+  for (int i = 0; i < count; ++i)
+  {
+    heightMap[i] = calculateHeightFloat(s_genBuffers.contBuf[i], s_genBuffers.erosionBuf[i],
+                                        s_genBuffers.pvBuf[i], s_genBuffers.ridgeBuf[i], s_genBuffers.riverBuf[i]);
+  }
+
+  {
+    TerrainProfiler::Scope scope(TerrainProfiler::PASS_EROSION);
+    applyHydraulicErosion(heightMap, d);
+    for (int i = 0; i < THERMAL_ITERATIONS; ++i)
+      applyThermalErosion(heightMap, d);
+  }
+
+  // Keep the tile's own columns only
+  for (int z = 0; z < ErosionTileCache::TILE_BLOCKS; ++z)
+  {
+    std::copy_n(heightMap + (z + EROSION_TILE_MARGIN) * d + EROSION_TILE_MARGIN, ErosionTileCache::TILE_BLOCKS,
+                out.data() + z * ErosionTileCache::TILE_BLOCKS);
+  }
+}
+
+void TerrainGenerator::applyHydraulicErosion(float *heightMap, int size) const
+{
+  // Grid-based water flow: every step it rains on each cell, water runs off to
+  // the lower neighbours in proportion to the drop of the water surface, and
+  // carries sediment up to a capacity that grows with the amount of water and
+  // the slope. Below capacity it dissolves ground, above it deposits.
+  // Each step reads the previous state only and cells are visited in a fixed
+  // order, so the result is fully deterministic.
+  const int count = size * size;
+  std::vector<float> &water = s_genBuffers.waterMap;
+  std::vector<float> &sediment = s_genBuffers.sedimentMap;
+  std::vector<float> &waterNext = s_genBuffers.waterNextMap;
+  std::vector<float> &sedimentNext = s_genBuffers.sedimentNextMap;
+  std::vector<float> &heightPrev = s_genBuffers.erosionTempMap;
+  water.assign(count, 0.0f);
+  sediment.assign(count, 0.0f);
+  heightPrev.resize(count);
+
+  for (int step = 0; step < HYDRAULIC_ITERATIONS; ++step)
+  {
+    std::copy(heightMap, heightMap + count, heightPrev.begin());
+    waterNext.assign(count, 0.0f);
+    sedimentNext.assign(count, 0.0f);
+
+    for (int z = 0; z < size; ++z)
+    {
+      for (int x = 0; x < size; ++x)
+      {
+        const int idx = z * size + x;
+        const float w = water[idx] + RAIN_PER_STEP;
+        const float level = heightPrev[idx] + w;
+
+        // Drop of the water surface towards each lower neighbour (edges have fewer)
+        const int neighbors[4] = {x > 0 ? idx - 1 : -1, x < size - 1 ? idx + 1 : -1,
+                                  z > 0 ? idx - size : -1, z < size - 1 ? idx + size : -1};
+        float drops[4] = {};
+        float totalDrop = 0.0f;
+        float slope = 0.0f;
+        for (int i = 0; i < 4; ++i)
+        {
+          if (neighbors[i] < 0)
+            continue;
+          const int n = neighbors[i];
+          const float drop = level - (heightPrev[n] + water[n] + RAIN_PER_STEP);
+          if (drop > 0.0f)
+          {
+            drops[i] = drop;
+            totalDrop += drop;
+            slope = std::max(slope, heightPrev[idx] - heightPrev[n]);
+          }
+        }
+
+        // Half the drop levels the surfaces; never more water than there is
+        const float outflow = std::min(w, totalDrop * 0.5f);
+        const float capacity = SEDIMENT_CAPACITY * outflow * std::max(slope, MIN_CAPACITY_SLOPE);
+
+        float carried = sediment[idx];
+        if (carried > capacity)
+        {
+          const float deposit = (carried - capacity) * DEPOSIT_RATE;
+          heightMap[idx] += deposit;
+          carried -= deposit;
+        }
+        else
+        {
+          const float dissolve = std::min((capacity - carried) * DISSOLVE_RATE, MAX_DISSOLVE);
+          heightMap[idx] -= dissolve;
+          carried += dissolve;
+        }
+
+        // Sediment leaves with the same fraction of the water
+        const float leaving = w > 0.0f ? outflow / w : 0.0f;
+        waterNext[idx] += w - outflow;
+        sedimentNext[idx] += carried * (1.0f - leaving);
+        if (outflow <= 0.0f)
+          continue;
+
+        for (int i = 0; i < 4; ++i)
+        {
+          if (drops[i] <= 0.0f)
+            continue;
+          const float share = drops[i] / totalDrop;
+          waterNext[neighbors[i]] += outflow * share;
+          sedimentNext[neighbors[i]] += carried * leaving * share;
+        }
+      }
+    }
+
+    for (int i = 0; i < count; ++i)
+      waterNext[i] *= 1.0f - EVAPORATION_RATE;
+    water.swap(waterNext);
+    sediment.swap(sedimentNext);
   }
 
+  // Whatever is still in suspension settles where it is
+  for (int i = 0; i < count; ++i)
+    heightMap[i] += sediment[i];
+}
+
+void TerrainGenerator::applyThermalErosion(float *heightMap, int size) const
+{
+  if (size < 2)
+    return;
+
+  // One thermal erosion pass (smooths overly steep slopes deterministically)
+  const float talusAngle = 0.6f;  // Max allowed height diff between adjacent cells
+  const float thermalRate = 0.5f; // Fraction of material to move
+
+  std::vector<float> &tempMapBuffer = s_genBuffers.erosionTempMap;
+  tempMapBuffer.assign(heightMap, heightMap + size * size);
+  const float *tempMap = tempMapBuffer.data();
+
   for (int z = 1; z < size - 1; ++z)
   {
     for (int x = 1; x < size - 1; ++x)
@@ -1141,9 +1959,6 @@ void TerrainGenerator::applyErosion(float *heightMap, int size) const
       }
     }
   }
-
-  // Hydraulic Erosion pass removed because particle simulation causes
-  // boundary mismatches across asynchronously generated chunks.
 }
 
 // =============================================
@@ -1152,6 +1967,7 @@ void TerrainGenerator::applyErosion(float *heightMap, int size) const
 
 void TerrainGenerator::generateVegetation(ChunkData &chunkData, int chunkX, int chunkZ)
 {
+  TerrainProfiler::Scope profile(TerrainProfiler::PASS_VEGETATION);
   float chunkXf = static_cast<float>(chunkX) + NOISE_OFFSET;
   float chunkZf = static_cast<float>(chunkZ) + NOISE_OFFSET;
 
@@ -1159,11 +1975,11 @@ void TerrainGenerator::generateVegetation(ChunkData &chunkData, int chunkX, int
   float *forestDensityResults = s_genBuffers.forestDensityResults.data();
 
   // Local tree-placement noise: high-frequency per-column variation
-  m_treeNoise->GenUniformGrid2D(treeNoiseResults, chunkXf, chunkZf,
-                                CHUNK_SIZE, CHUNK_SIZE, 1.0f, m_seed + 10000);
+  genGrid2D(TerrainProfiler::NOISE_TREE, m_graphs->tree, treeNoiseResults, chunkXf, chunkZf,
+            CHUNK_SIZE, CHUNK_SIZE, 1.0f, m_seed + 10000);
   // Forest-cluster noise: low-frequency, shapes large forest patches and clearings
-  m_forestDensityNoise->GenUniformGrid2D(forestDensityResults, chunkXf, chunkZf,
-                                         CHUNK_SIZE, CHUNK_SIZE, 1.0f, m_seed + 11000);
+  genGrid2D(TerrainProfiler::NOISE_FOREST_DENSITY, m_graphs->forestDensity, forestDensityResults, chunkXf, chunkZf,
+            CHUNK_SIZE, CHUNK_SIZE, 1.0f, m_seed + 11000);
 
   for (int localZ = 0; localZ < CHUNK_SIZE; ++localZ)
   {
@@ -1272,25 +2088,52 @@ void TerrainGenerator::placeTree(ChunkData &chunkData, int localX, int localZ,
   }
 }
 
+// Tree shapes, anchored at the bottom of the trunk. The place*Tree() functions
+// pick one of the variants below from the tree's hash; the variant index packs
+// the same hash fields the shapes used to be drawn from.
 void TerrainGenerator::placeOakTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ)
 {
   uint32_t h = treeHash(worldX, worldZ, m_seed + 100);
 
-  int trunkHeight = 4 + static_cast<int>(h & 3);       // 4–7 blocks
-  bool wideCanopy = ((h >> 2) & 7) == 0;               // ~12%: radius-3 canopy
-  int extraTopLayers = static_cast<int>((h >> 5) & 1); // 0 or 1 extra cap layer
-  int canopyMargin = wideCanopy ? 3 : 2;
+  // Trunk height 4 + (h & 3), ~12% radius-3 canopy, 0 or 1 extra cap layer
+  const size_t variant = (h & 3) | ((((h >> 2) & 7) == 0) ? 4u : 0u) | (((h >> 5) & 1) << 3);
+  stampStructure(chunkData, structureLibrary().oakTrees[variant], localX, baseY, localZ, true);
+}
 
-  if (localX < canopyMargin || localX >= CHUNK_SIZE - canopyMargin ||
-      localZ < canopyMargin || localZ >= CHUNK_SIZE - canopyMargin)
-  {
-    return;
-  }
+void TerrainGenerator::placeBirchTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ)
+{
+  uint32_t h = treeHash(worldX, worldZ, m_seed + 150);
 
+  // Trunk height 5 + (h & 3), 0 or 1 extra cap layer
+  const size_t variant = (h & 3) | (((h >> 2) & 1) << 2);
+  stampStructure(chunkData, structureLibrary().birchTrees[variant], localX, baseY, localZ, true);
+}
+
+void TerrainGenerator::placeSpruceTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ)
+{
+  uint32_t h = treeHash(worldX, worldZ, m_seed + 300);
+
+  // Trunk height 6 + h % 7, 20% fat variant, 75% bare bottom
+  const size_t variant = (h % 7) * 4 + ((((h >> 3) % 5) == 0) ? 2 : 0) + ((((h >> 6) & 3) != 0) ? 1 : 0);
+  stampStructure(chunkData, structureLibrary().spruceTrees[variant], localX, baseY, localZ, true);
+}
+
+void TerrainGenerator::placeJungleTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ)
+{
+  uint32_t h = treeHash(worldX, worldZ, m_seed + 400);
+
+  // Trunk height 8 + h % 9, canopy radius 3 or 4, 75% prop roots 2 or 3 blocks tall
+  const size_t roots = (((h >> 5) & 3) != 0) ? 1 + ((h >> 7) & 1) : 0;
+  const size_t variant = ((h % 9) * 2 + ((h >> 4) & 1)) * 3 + roots;
+  stampStructure(chunkData, structureLibrary().jungleTrees[variant], localX, baseY, localZ, true);
+}
+
+void TerrainGenerator::buildOakTree(StructureTemplate &shape, int trunkHeight, bool wideCanopy, int extraTopLayers)
+{
   for (int y = 0; y < trunkHeight; ++y)
-    setVoxelSafe(chunkData, localX, baseY + y, localZ, TextureType::OAK_LOG);
+    shape.set(0, y, 0, TextureType::OAK_LOG);
 
-  int topY = baseY + trunkHeight;
+  int topY = trunkHeight;
   int crownRadius = wideCanopy ? 3 : 2;
   // Bottom layers: crownRadius wide, corners trimmed
   // Top cap layers: radius 1
@@ -1311,29 +2154,19 @@ void TerrainGenerator::placeOakTree(ChunkData &chunkData, int localX, int localZ
         // Leave trunk column intact
         if (dx == 0 && dz == 0 && ly < topY)
           continue;
-        setVoxelSafe(chunkData, localX + dx, ly, localZ + dz, TextureType::OAK_LEAVES);
+        shape.set(dx, ly, dz, TextureType::OAK_LEAVES);
       }
     }
   }
 }
 
 // TODO: Replace OAK_LOG/OAK_LEAVES with BIRCH_LOG/BIRCH_LEAVES when texture assets are available
-void TerrainGenerator::placeBirchTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ)
+void TerrainGenerator::buildBirchTree(StructureTemplate &shape, int trunkHeight, int extraTopLayers)
 {
-  uint32_t h = treeHash(worldX, worldZ, m_seed + 150);
-
-  int trunkHeight = 5 + static_cast<int>(h & 3);       // 5–8 blocks (birches are tall and slender)
-  int extraTopLayers = static_cast<int>((h >> 2) & 1); // 0 or 1 extra cap layer
-
-  if (localX < 2 || localX >= CHUNK_SIZE - 2 || localZ < 2 || localZ >= CHUNK_SIZE - 2)
-  {
-    return;
-  }
-
   for (int y = 0; y < trunkHeight; ++y)
-    setVoxelSafe(chunkData, localX, baseY + y, localZ, TextureType::OAK_LOG);
+    shape.set(0, y, 0, TextureType::OAK_LOG);
 
-  int topY = baseY + trunkHeight;
+  int topY = trunkHeight;
   // Birch crown: slender (radius 2 min, radius 1 cap), no wide variant
   int leafBottom = topY - 3;
   int leafCapBase = topY + 1;
@@ -1352,34 +2185,22 @@ void TerrainGenerator::placeBirchTree(ChunkData &chunkData, int localX, int loca
           continue;
         if (dx == 0 && dz == 0 && ly < topY)
           continue;
-        setVoxelSafe(chunkData, localX + dx, ly, localZ + dz, TextureType::OAK_LEAVES);
+        shape.set(dx, ly, dz, TextureType::OAK_LEAVES);
       }
     }
   }
 }
 
 // TODO: Replace OAK_LOG/OAK_LEAVES with SPRUCE_LOG/SPRUCE_LEAVES when texture assets are available
-void TerrainGenerator::placeSpruceTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ)
+void TerrainGenerator::buildSpruceTree(StructureTemplate &shape, int trunkHeight, bool fatVariant, bool bareBottom)
 {
-  uint32_t h = treeHash(worldX, worldZ, m_seed + 300);
-
-  int trunkHeight = 6 + static_cast<int>(h % 7); // 6–12 blocks
-  bool fatVariant = ((h >> 3) % 5) == 0;         // 20%: each layer is one block wider
-  bool bareBottom = ((h >> 6) & 3) != 0;         // 75%: lower trunk is exposed (no bottom leaves)
   int maxLayer = bareBottom ? trunkHeight - 3 : trunkHeight - 1;
-  int canopyMargin = (maxLayer / 2) + (fatVariant ? 1 : 0);
-
-  if (localX < canopyMargin || localX >= CHUNK_SIZE - canopyMargin ||
-      localZ < canopyMargin || localZ >= CHUNK_SIZE - canopyMargin)
-  {
-    return;
-  }
 
   for (int y = 0; y < trunkHeight; ++y)
-    setVoxelSafe(chunkData, localX, baseY + y, localZ, TextureType::OAK_LOG);
+    shape.set(0, y, 0, TextureType::OAK_LOG);
 
   // Apex leaf block
-  setVoxelSafe(chunkData, localX, baseY + trunkHeight, localZ, TextureType::OAK_LEAVES);
+  shape.set(0, trunkHeight, 0, TextureType::OAK_LEAVES);
 
   // Stepped cone: every-other layer, working down from apex
   for (int layer = 0; layer <= maxLayer; ++layer)
@@ -1387,7 +2208,7 @@ void TerrainGenerator::placeSpruceTree(ChunkData &chunkData, int localX, int loc
     if (layer % 2 != 0)
       continue; // stepped — only even layers get leaves
 
-    int ly = baseY + trunkHeight - 1 - layer;
+    int ly = trunkHeight - 1 - layer;
     int radius = layer / 2;
     if (fatVariant && layer > 0)
       ++radius; // fat variant: bump radius on non-apex layers
@@ -1401,44 +2222,28 @@ void TerrainGenerator::placeSpruceTree(ChunkData &chunkData, int localX, int loc
         // Use a loose diamond shape at larger radii for a softer silhouette
         if (radius >= 3 && std::abs(dx) + std::abs(dz) > radius + 1)
           continue;
-        setVoxelSafe(chunkData, localX + dx, ly, localZ + dz, TextureType::OAK_LEAVES);
+        shape.set(dx, ly, dz, TextureType::OAK_LEAVES);
       }
     }
   }
 }
 
 // TODO: Replace OAK_LOG/OAK_LEAVES with JUNGLE_LOG/JUNGLE_LEAVES when texture assets are available
-void TerrainGenerator::placeJungleTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ)
+void TerrainGenerator::buildJungleTree(StructureTemplate &shape, int trunkHeight, int canopyRadius, int rootHeight)
 {
-  uint32_t h = treeHash(worldX, worldZ, m_seed + 400);
-
-  int trunkHeight = 8 + static_cast<int>(h % 9);         // 8–16 blocks — large variation
-  int canopyRadius = 3 + static_cast<int>((h >> 4) & 1); // 3 or 4
-  bool hasPropRoots = ((h >> 5) & 3) != 0;               // 75%: extra root-logs close to base
-
-  if (localX < canopyRadius || localX >= CHUNK_SIZE - canopyRadius ||
-      localZ < canopyRadius || localZ >= CHUNK_SIZE - canopyRadius)
-  {
-    return;
-  }
-
   for (int y = 0; y < trunkHeight; ++y)
-    setVoxelSafe(chunkData, localX, baseY + y, localZ, TextureType::OAK_LOG);
+    shape.set(0, y, 0, TextureType::OAK_LOG);
 
-  // Prop roots: 2-block-tall extra logs at the 4 diagonal corners of the base
-  if (hasPropRoots)
+  // Prop roots (rootHeight 0: none): extra logs on the 4 sides of the base
+  const int offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  for (auto &off : offsets)
   {
-    const int offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-    int rootHeight = 2 + static_cast<int>((h >> 7) & 1); // 2 or 3
-    for (auto &off : offsets)
-    {
-      for (int ry = 0; ry < rootHeight; ++ry)
-        setVoxelSafe(chunkData, localX + off[0], baseY + ry, localZ + off[1], TextureType::OAK_LOG);
-    }
+    for (int ry = 0; ry < rootHeight; ++ry)
+      shape.set(off[0], ry, off[1], TextureType::OAK_LOG);
   }
 
   // Spherical-ish canopy centred slightly below apex so it isn't too top-heavy
-  int topY = baseY + trunkHeight;
+  int topY = trunkHeight;
   int canopyCentreY = topY - 1;
 
   for (int ly = canopyCentreY - canopyRadius + 1; ly <= canopyCentreY + 2; ++ly)
@@ -1458,7 +2263,7 @@ void TerrainGenerator::placeJungleTree(ChunkData &chunkData, int localX, int loc
           continue;
         if (dx == 0 && dz == 0 && ly < topY)
           continue;
-        setVoxelSafe(chunkData, localX + dx, ly, localZ + dz, TextureType::OAK_LEAVES);
+        shape.set(dx, ly, dz, TextureType::OAK_LEAVES);
       }
     }
   }
@@ -1470,6 +2275,8 @@ void TerrainGenerator::placeCactus(ChunkData &chunkData, int localX, int localZ,
   uint32_t h = treeHash(worldX, worldZ, m_seed + 500);
   int height = 1 + static_cast<int>(h & 3); // 1–4 blocks (more natural variation than old 1–3)
 
+  // Unlike trees, cacti stay off the edge columns: the free-space check below
+  // cannot see the neighbouring chunks
   if (localX <= 0 || localX >= CHUNK_SIZE - 1 || localZ <= 0 || localZ >= CHUNK_SIZE - 1)
     return;
 
@@ -1496,6 +2303,156 @@ void TerrainGenerator::placeCactus(ChunkData &chunkData, int localX, int localZ,
   }
 }
 
+// =============================================
+// STRUCTURES
+// =============================================
+
+// Grid structure kinds of the world, in roll order (see setGridStructures())
+const std::vector<TerrainGenerator::GridStructureKind> &TerrainGenerator::worldGridStructures()
+{
+  static const std::vector<GridStructureKind> kinds;
+  return kinds;
+}
+
+const TerrainGenerator::StructureLibrary &TerrainGenerator::structureLibrary()
+{
+  static const StructureLibrary library = []
+  {
+    StructureLibrary lib;
+    auto add = [](std::vector<StructureTemplate> &variants, auto build)
+    {
+      variants.emplace_back();
+      build(variants.back());
+      variants.back().compile();
+    };
+
+    for (int i = 0; i < 16; ++i)
+      add(lib.oakTrees, [i](StructureTemplate &t)
+          { buildOakTree(t, 4 + (i & 3), ((i >> 2) & 1) != 0, (i >> 3) & 1); });
+    for (int i = 0; i < 8; ++i)
+      add(lib.birchTrees, [i](StructureTemplate &t)
+          { buildBirchTree(t, 5 + (i & 3), (i >> 2) & 1); });
+    for (int i = 0; i < 7 * 4; ++i)
+      add(lib.spruceTrees, [i](StructureTemplate &t)
+          { buildSpruceTree(t, 6 + i / 4, (i & 2) != 0, (i & 1) != 0); });
+    for (int i = 0; i < 9 * 2 * 3; ++i)
+      add(lib.jungleTrees, [i](StructureTemplate &t)
+          {
+            const int roots = i % 3;
+            buildJungleTree(t, 8 + i / 6, 3 + (i / 3) % 2, roots == 0 ? 0 : roots + 1); });
+    return lib;
+  }();
+  return library;
+}
+
+void TerrainGenerator::stampStructure(ChunkData &chunkData, const StructureTemplate &shape, int x, int y, int z,
+                                      bool spill) const
+{
+  for (const StructureSpan &span : shape.spans())
+  {
+    const int sy = y + span.y;
+    if (sy < 0 || sy >= CHUNK_HEIGHT)
+      continue;
+    const int sz = z + span.z;
+    const int x0 = x + span.x;
+    const int x1 = x0 + span.length;
+
+    const bool rowInChunk = sz >= 0 && sz < CHUNK_SIZE;
+    const int in0 = rowInChunk ? std::clamp(x0, 0, static_cast<int>(CHUNK_SIZE)) : x1;
+    const int in1 = rowInChunk ? std::clamp(x1, 0, static_cast<int>(CHUNK_SIZE)) : x1;
+    if (in0 < in1)
+    {
+      Voxel *row = chunkData.voxels.data() + getVoxelIndex(0, sy, sz);
+      for (int sx = in0; sx < in1; ++sx)
+        row[sx].type = span.type;
+    }
+
+    if (!spill)
+      continue;
+    for (int sx = x0; sx < x1; ++sx)
+    {
+      if (sx >= in0 && sx < in1)
+        continue;
+      chunkData.spill.push_back({static_cast<int8_t>(sx), static_cast<uint8_t>(sy),
+                                 static_cast<int8_t>(sz), span.type});
+    }
+  }
+}
+
+void TerrainGenerator::findStructures(int cellX, int cellZ, std::vector<StructurePlacement> &out) const
+{
+  constexpr int MAX_FOOTPRINT = 32;
+
+  out.clear();
+  if (m_gridStructures->empty())
+    return;
+
+  const uint32_t roll = treeHash(cellX, cellZ, m_seed + 20000);
+  float r = static_cast<float>(roll & 0xFFFF) / 65535.0f;
+  const GridStructureKind *kind = nullptr;
+  for (const GridStructureKind &candidate : *m_gridStructures)
+  {
+    if (r < candidate.chance)
+    {
+      kind = &candidate;
+      break;
+    }
+    r -= candidate.chance;
+  }
+  if (!kind)
+    return;
+
+  const std::vector<StructureTemplate> &variants = kind->variants;
+  const StructureTemplate &shape = variants[(roll >> 16) % variants.size()];
+  const glm::ivec3 size = shape.max() - shape.min() + 1;
+  const int footprint = std::max(size.x, size.z);
+  assert(footprint <= MAX_FOOTPRINT && footprint <= STRUCTURE_CELL);
+
+  // Anywhere the whole shape stays inside the cell
+  const uint32_t site = treeHash(cellX, cellZ, m_seed + 20001);
+  const int minX = cellX * STRUCTURE_CELL + static_cast<int>((site & 0xFFFF) % (STRUCTURE_CELL - size.x + 1));
+  const int minZ = cellZ * STRUCTURE_CELL + static_cast<int>((site >> 16) % (STRUCTURE_CELL - size.z + 1));
+
+  if (!kind->allowed(getBiomeAt(minX + size.x / 2, minZ + size.z / 2)))
+    return;
+
+  // Same rounded heights as the chunks' height maps
+  std::array<float, MAX_FOOTPRINT * MAX_FOOTPRINT> heights;
+  fillErodedHeights(heights.data(), minX, minZ, footprint);
+  int lowest = CHUNK_HEIGHT;
+  int highest = 0;
+  for (int z = 0; z < size.z; ++z)
+  {
+    for (int x = 0; x < size.x; ++x)
+    {
+      const int height = roundedColumnHeight(heights[z * footprint + x]);
+      lowest = std::min(lowest, height);
+      highest = std::max(highest, height);
+    }
+  }
+  if (highest - lowest > kind->maxSlope || lowest <= SEA_LEVEL + 1)
+    return;
+
+  out.push_back({&shape, minX - shape.min().x, lowest + 1, minZ - shape.min().z});
+}
+
+void TerrainGenerator::placeStructures(ChunkData &chunkData, int chunkX, int chunkZ) const
+{
+  TerrainProfiler::Scope profile(TerrainProfiler::PASS_STRUCTURES);
+  thread_local std::vector<StructurePlacement> placements;
+  findStructures(floorDiv(chunkX, STRUCTURE_CELL), floorDiv(chunkZ, STRUCTURE_CELL), placements);
+
+  for (const StructurePlacement &placement : placements)
+  {
+    const glm::ivec3 &lo = placement.shape->min();
+    const glm::ivec3 &hi = placement.shape->max();
+    if (placement.x + hi.x < chunkX || placement.x + lo.x >= chunkX + CHUNK_SIZE ||
+        placement.z + hi.z < chunkZ || placement.z + lo.z >= chunkZ + CHUNK_SIZE)
+      continue;
+    stampStructure(chunkData, *placement.shape, placement.x - chunkX, placement.y, placement.z - chunkZ, false);
+  }
+}
+
 // =============================================
 // VOXEL TYPE DETERMINATION
 // =============================================
@@ -1557,9 +2514,65 @@ TextureType TerrainGenerator::getVoxelTypeAt(int worldX, int worldY, int worldZ,
 // BORDER GENERATION
 // =============================================
 
+void TerrainGenerator::publishEdgeNoise(const ChunkData &chunkData, int chunkX, int chunkZ) const
+{
+  const NoiseSlab &slab = s_genBuffers.slab;
+  const float *caveResults = s_genBuffers.cave.data();
+  const float *ravineResults = s_genBuffers.ravine.data();
+  const float *surface3DResults = s_genBuffers.surface3D.data();
+  const int caveHeight = slab.caveHeight();
+  const int surfaceHeight = slab.surfaceHeight();
+
+  auto edges = std::make_shared<ChunkEdgeNoise>();
+  edges->carveMaxY = static_cast<int16_t>(slab.caveMaxY);
+  for (int e = 0; e < ChunkEdgeNoise::EDGE_COUNT; ++e)
+  {
+    for (int i = 0; i < CHUNK_SIZE; ++i)
+    {
+      int localX = i;
+      int localZ = i;
+      if (e == ChunkEdgeNoise::EDGE_MIN_Z)
+        localZ = 0;
+      else if (e == ChunkEdgeNoise::EDGE_MAX_Z)
+        localZ = CHUNK_SIZE - 1;
+      else if (e == ChunkEdgeNoise::EDGE_MIN_X)
+        localX = 0;
+      else
+        localX = CHUNK_SIZE - 1;
+
+      ChunkEdgeNoise::Column &column = edges->edges[e][i];
+
+      column.carveMask.fill(0u);
+      const int caveBase = localZ * caveHeight * CHUNK_SIZE + localX;
+      for (int y = slab.caveMinY; y <= slab.caveMaxY; ++y)
+      {
+        int noiseIndex = caveBase + (y - slab.caveMinY) * CHUNK_SIZE;
+        if (isCarved(caveResults[noiseIndex], ravineResults[noiseIndex], y))
+          column.carveMask[y >> 5] |= 1u << (y & 31);
+      }
+
+      // Window around the unperturbed surface height (heightMap still holds it
+      // at this point), limited to what the slab sampled
+      int windowMinY = std::clamp(chunkData.heightMap[getColumnIndex(localX, localZ)] - SURFACE_BAND_BELOW - SURFACE_CACHE_SLACK,
+                                  0, CHUNK_HEIGHT - ChunkEdgeNoise::SURFACE_SPAN);
+      int minY = std::max(windowMinY, slab.surfaceMinY);
+      int maxY = std::min(windowMinY + ChunkEdgeNoise::SURFACE_SPAN - 1, slab.surfaceMaxY);
+      column.surfaceMinY = static_cast<int16_t>(minY);
+      column.surfaceMaxY = static_cast<int16_t>(maxY);
+
+      const int surfaceBase = localZ * surfaceHeight * CHUNK_SIZE + localX;
+      for (int y = minY; y <= maxY; ++y)
+        column.surface3D[y - minY] = surface3DResults[surfaceBase + (y - slab.surfaceMinY) * CHUNK_SIZE];
+    }
+  }
+
+  ColumnNoiseCache::instance().store(m_seed, noiseSamplingVariant(), chunkX, chunkZ, std::move(edges));
+}
+
 void TerrainGenerator::generateChunkBorders(ChunkData &chunkData, int chunkX,
                                             int chunkZ)
 {
+  TerrainProfiler::Scope profile(TerrainProfiler::PASS_BORDERS);
   auto setBorderVoxel = [&](int lx, int ly, int lz, TextureType type)
   {
     if (lx >= -1 && lx <= CHUNK_SIZE && ly >= -1 && ly <= CHUNK_HEIGHT && lz >= -1 && lz <= CHUNK_SIZE)
@@ -1600,50 +2613,68 @@ void TerrainGenerator::generateChunkBorders(ChunkData &chunkData, int chunkX,
   float *bRavine = s_genBuffers.borderRavine.data();
   float *bSurface3D = s_genBuffers.borderSurface3D.data();
 
-  for (int s = 0; s < 8; ++s)
+  // We already generated the 20x20 extended heightmap/noises during `generateChunkBatch`
+  // The core chunk is at (x=2..17, z=2..17).
+  // The borders are at:
+  // South: lx=0..15, lz=-1 => extX=2..17, extZ=1
+  // North: lx=0..15, lz=16 => extX=2..17, extZ=18
+  // West:  lx=-1, lz=0..15 => extX=1,     extZ=2..17
+  // East:  lx=16, lz=0..15 => extX=18,    extZ=2..17
+  const float *extHeightMap = s_genBuffers.extendedHeightMap.data();
+  const float *temperatureResults = s_genBuffers.temperature.data();
+  const float *humidityResults = s_genBuffers.humidity.data();
+  const float *weirdnessResults = s_genBuffers.weirdness.data();
+  const float *continentalResults = s_genBuffers.continental.data();
+  const float *riverResults = s_genBuffers.river.data();
+  const float *erosionResults = s_genBuffers.erosion.data();
+  const float *peaksValleysResults = s_genBuffers.peaksValleys.data();
+  const int EXTENDED_SIZE = 20;
+
+  const ColumnNoiseCache &noiseCache = ColumnNoiseCache::instance();
+
+  struct BorderColumn
   {
-    const auto &strip = strips[s];
-    float startX = static_cast<float>(chunkX + strip.lxStart) + NOISE_OFFSET;
-    float startZ = static_cast<float>(chunkZ + strip.lzStart) + NOISE_OFFSET;
+    int lx;
+    int lz;
+    int height;
+    BiomeType biome;
+    float temperature;
+    bool isMountain;
+    const ChunkEdgeNoise::Column *cached;
+  };
+  std::array<BorderColumn, CHUNK_SIZE> columns;
 
-    // Batch 3D noise for cave/ravine across the full strip volume
-    m_caveNoise->GenUniformGrid3D(bCave, startX, 0.0f, startZ,
-                                  strip.xSize, CHUNK_HEIGHT, strip.zSize, 1.0f, m_seed + 4000);
-    m_ravineNoise->GenUniformGrid3D(bRavine, startX, 0.0f, startZ,
-                                    strip.xSize, CHUNK_HEIGHT, strip.zSize, 1.0f, m_seed + 5000);
-    m_surface3DNoise->GenUniformGrid3D(bSurface3D, startX, 0.0f, startZ,
-                                       strip.xSize, CHUNK_HEIGHT, strip.zSize, 1.0f, m_seed + 6000);
+  // Same vertical bounds as the chunk body: they already cover the shell
+  const NoiseSlab &slab = s_genBuffers.slab;
+  const int caveHeight = slab.caveHeight();
+  const int surfaceHeight = slab.surfaceHeight();
 
+  for (int s = 0; s < 8; ++s)
+  {
+    const auto &strip = strips[s];
     int numColumns = strip.xSize * strip.zSize; // CHUNK_SIZE (16) or 1 array Size
 
-    // We already generated the 20x20 extended heightmap/noises during `generateChunkBatch`
-    // The core chunk is at (x=2..17, z=2..17).
-    // The borders are at:
-    // South: lx=0..15, lz=-1 => extX=2..17, extZ=1
-    // North: lx=0..15, lz=16 => extX=2..17, extZ=18
-    // West:  lx=-1, lz=0..15 => extX=1,     extZ=2..17
-    // East:  lx=16, lz=0..15 => extX=18,    extZ=2..17
-
-    float *extHeightMap = s_genBuffers.extendedHeightMap.data();
-    float *temperatureResults = s_genBuffers.temperature.data();
-    float *humidityResults = s_genBuffers.humidity.data();
-    float *weirdnessResults = s_genBuffers.weirdness.data();
-    float *continentalResults = s_genBuffers.continental.data();
-    float *riverResults = s_genBuffers.river.data();
-    float *erosionResults = s_genBuffers.erosion.data();
-    float *peaksValleysResults = s_genBuffers.peaksValleys.data();
-    const int EXTENDED_SIZE = 20;
-
+    // Every strip lies inside a single neighbour, as one of its edge columns
+    int neighbourDX = strip.lxStart < 0 ? -1 : (strip.lxStart >= CHUNK_SIZE ? 1 : 0);
+    int neighbourDZ = strip.lzStart < 0 ? -1 : (strip.lzStart >= CHUNK_SIZE ? 1 : 0);
+    // Inside generateRegion() the shell is already in the region volume
+    const bool fromRegion = s_genBuffers.region.covers(chunkX, chunkZ);
+    std::shared_ptr<const ChunkEdgeNoise> neighbourNoise;
+    if (!fromRegion)
+      neighbourNoise = noiseCache.find(m_seed, noiseSamplingVariant(), chunkX + neighbourDX * CHUNK_SIZE, chunkZ + neighbourDZ * CHUNK_SIZE);
+    bool useCache = neighbourNoise != nullptr;
+
+    // Resolve height and biome first: the cached surface3D window has to
+    // cover every mountain column before the strip can skip sampling.
     for (int j = 0; j < numColumns; ++j)
     {
-      int lx = strip.lxStart + (strip.xSize > 1 ? j : 0);
-      int lz = strip.lzStart + (strip.zSize > 1 ? j : 0);
+      BorderColumn &col = columns[j];
+      col.lx = strip.lxStart + (strip.xSize > 1 ? j : 0);
+      col.lz = strip.lzStart + (strip.zSize > 1 ? j : 0);
 
-      int extX = lx + 2;
-      int extZ = lz + 2;
-      int extIndex = extZ * EXTENDED_SIZE + extX;
+      int extIndex = (col.lz + 2) * EXTENDED_SIZE + (col.lx + 2);
 
-      int height = std::clamp(static_cast<int>(std::round(extHeightMap[extIndex])), 1, static_cast<int>(CHUNK_HEIGHT - HEIGHT_CEILING_MARGIN));
+      col.height = roundedColumnHeight(extHeightMap[extIndex]);
 
       float cont = std::clamp(continentalResults[extIndex], -1.0f, 1.0f);
       float temp = std::clamp(temperatureResults[extIndex], -1.0f, 1.0f);
@@ -1653,42 +2684,105 @@ void TerrainGenerator::generateChunkBorders(ChunkData &chunkData, int chunkX,
       float erosion = std::clamp(erosionResults[extIndex], -1.0f, 1.0f);
       float pv = std::clamp(peaksValleysResults[extIndex], -1.0f, 1.0f);
 
-      BiomeType biome = determineBiome(temp, humid, weird, cont, erosion, pv, riverVal, height);
-      float temperature = temp;
+      col.biome = determineBiome(temp, humid, weird, cont, erosion, pv, riverVal, col.height);
+      col.temperature = temp;
+      col.isMountain = (col.biome == BIOME_MOUNTAINS || col.biome == BIOME_SNOWY_MOUNTAINS);
+      col.cached = nullptr;
 
-      bool isMountain = (biome == BIOME_MOUNTAINS || biome == BIOME_SNOWY_MOUNTAINS);
+      if (useCache)
+      {
+        // Position of this column inside the neighbour chunk
+        int nx = col.lx - neighbourDX * CHUNK_SIZE;
+        int nz = col.lz - neighbourDZ * CHUNK_SIZE;
+        if (nx == 0)
+          col.cached = &neighbourNoise->edges[ChunkEdgeNoise::EDGE_MIN_X][nz];
+        else if (nx == CHUNK_SIZE - 1)
+          col.cached = &neighbourNoise->edges[ChunkEdgeNoise::EDGE_MAX_X][nz];
+        else if (nz == 0)
+          col.cached = &neighbourNoise->edges[ChunkEdgeNoise::EDGE_MIN_Z][nx];
+        else
+          col.cached = &neighbourNoise->edges[ChunkEdgeNoise::EDGE_MAX_Z][nx];
+
+        // Solid voxels (the only ones carved) reach height + SURFACE_BAND_ABOVE on mountains
+        int solidMaxY = col.height + (col.isMountain ? SURFACE_BAND_ABOVE : 0);
+        if (!neighbourNoise->coversCarve(solidMaxY) ||
+            (col.isMountain &&
+             !col.cached->coversSurface(std::max(0, col.height - SURFACE_BAND_BELOW),
+                                        std::min(CHUNK_HEIGHT - 1, col.height + SURFACE_BAND_ABOVE))))
+        {
+          useCache = false;
+        }
+      }
+    }
+    bool stripHasMountain = false;
+    for (int j = 0; j < numColumns; ++j)
+      stripHasMountain |= columns[j].isMountain;
+
+    if (fromRegion)
+    {
+      const GenBuffers::RegionNoise &region = s_genBuffers.region;
+      sliceRegionBox(region.cave, region.slab.caveMinY, chunkX, chunkZ, strip.lxStart, strip.lzStart,
+                     strip.xSize, strip.zSize, slab.caveMinY, slab.caveMaxY, bCave);
+      sliceRegionBox(region.ravine, region.slab.caveMinY, chunkX, chunkZ, strip.lxStart, strip.lzStart,
+                     strip.xSize, strip.zSize, slab.caveMinY, slab.caveMaxY, bRavine);
+      if (stripHasMountain)
+        sliceRegionBox(region.surface3D, region.slab.surfaceMinY, chunkX, chunkZ, strip.lxStart, strip.lzStart,
+                       strip.xSize, strip.zSize, slab.surfaceMinY, slab.surfaceMaxY, bSurface3D);
+    }
+    else
+    {
+      noiseCache.recordLookup(useCache);
+    }
+
+    if (!fromRegion && !useCache)
+    {
+      const int startX = chunkX + strip.lxStart;
+      const int startZ = chunkZ + strip.lzStart;
+
+      // Batch 3D noise for cave/ravine across the strip's slab
+      sampleNoise3D(NOISE_3D_CAVE, bCave, startX, slab.caveMinY, startZ, strip.xSize, caveHeight, strip.zSize);
+      sampleNoise3D(NOISE_3D_RAVINE, bRavine, startX, slab.caveMinY, startZ, strip.xSize, caveHeight, strip.zSize);
+      if (stripHasMountain)
+        sampleNoise3D(NOISE_3D_SURFACE, bSurface3D, startX, slab.surfaceMinY, startZ, strip.xSize, surfaceHeight, strip.zSize);
+    }
+
+    for (int j = 0; j < numColumns; ++j)
+    {
+      const BorderColumn &col = columns[j];
+      const ChunkEdgeNoise::Column *cached = useCache ? col.cached : nullptr;
+      int noiseX = (strip.xSize > 1) ? j : 0;
+      int noiseZ = (strip.zSize > 1) ? j : 0;
 
       for (int y = 0; y < CHUNK_HEIGHT; ++y)
       {
-        int noiseX = (strip.xSize > 1) ? j : 0;
-        int noiseZ = (strip.zSize > 1) ? j : 0;
-        int noiseIdx = noiseZ * (CHUNK_HEIGHT * strip.xSize) + y * strip.xSize + noiseX;
-
-        float density = static_cast<float>(height - y);
-        if (isMountain && density > -8.0f && density < 12.0f) {
+        float density = static_cast<float>(col.height - y);
+        if (col.isMountain && density > -8.0f && density < 12.0f) {
            float distToSurface = std::abs(density);
            float blend = std::max(0.0f, 1.0f - distToSurface / 12.0f);
-           density += bSurface3D[noiseIdx] * 8.0f * blend;
+           float surface3DVal = cached ? cached->surfaceAt(y)
+                                       : bSurface3D[noiseZ * (surfaceHeight * strip.xSize) + (y - slab.surfaceMinY) * strip.xSize + noiseX];
+           density += surface3DVal * 8.0f * blend;
         }
 
         TextureType type;
         if (density >= 0.0f) {
-            type = getVoxelTypeAt(chunkX + lx, y, chunkZ + lz, height, biome, temperature, density);
-            
+            type = getVoxelTypeAt(chunkX + col.lx, y, chunkZ + col.lz, col.height, col.biome, col.temperature, density);
+
             if (type != TextureType::AIR && type != TextureType::BEDROCK && type != TextureType::WATER)
             {
-              float hRatio = std::clamp(static_cast<float>(y - SEA_LEVEL) / 64.0f, 0.0f, 1.0f);
-              if (bCave[noiseIdx] > 0.6f + hRatio * 0.35f || bRavine[noiseIdx] > 0.8f + hRatio * 0.15f)
+              int caveIdx = noiseZ * (caveHeight * strip.xSize) + (y - slab.caveMinY) * strip.xSize + noiseX;
+              bool carved = cached ? cached->isCarved(y) : isCarved(bCave[caveIdx], bRavine[caveIdx], y);
+              if (carved)
               {
                 type = TextureType::AIR;
               }
             }
         } else {
-            type = getVoxelTypeAt(chunkX + lx, y, chunkZ + lz, height, biome, temperature, density);
+            type = getVoxelTypeAt(chunkX + col.lx, y, chunkZ + col.lz, col.height, col.biome, col.temperature, density);
         }
 
         if (type != TextureType::AIR)
-          setBorderVoxel(lx, y, lz, type);
+          setBorderVoxel(col.lx, y, col.lz, type);
       }
     }
   }
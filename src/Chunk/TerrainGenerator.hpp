@@ -7,6 +7,21 @@
 #include <memory>
 
 #include <utils.hpp>
+#include <Chunk/BiomeAtlas.hpp>
+#include <Chunk/BiomeColorField.hpp>
+#include <Chunk/ErosionTileCache.hpp>
+#include <Chunk/StructureTemplate.hpp>
+
+// Vegetation voxel placed outside the chunk that grew it, in that chunk's local
+// coordinates: x and z lie in [-CHUNK_SIZE, 2 * CHUNK_SIZE), i.e. in one of the
+// 8 neighbours.
+struct SpillVoxel
+{
+  int8_t x;
+  uint8_t y;
+  int8_t z;
+  uint8_t type;
+};
 
 struct ChunkData
 {
@@ -21,9 +36,43 @@ struct ChunkData
   // Height map for quick access
   std::array<int, CHUNK_SIZE * CHUNK_SIZE> heightMap;
 
-  // Precomputed packed RGBA biome colors per column (for mesh generation)
-  std::array<uint32_t, CHUNK_SIZE * CHUNK_SIZE> grassColors;
-  std::array<uint32_t, CHUNK_SIZE * CHUNK_SIZE> foliageColors;
+  // Blended biome colors at the column corners (for mesh generation)
+  BiomeColorField colors;
+
+  // Filled by decorateChunk(): the part of this chunk's trees that belongs to
+  // neighbouring chunks. Not applied to anything by the generator itself.
+  std::vector<SpillVoxel> spill;
+};
+
+// A structure picked by the placement grid: its shape and the world position
+// of its anchor
+struct StructurePlacement
+{
+  const StructureTemplate *shape;
+  int x;
+  int y;
+  int z;
+};
+
+// Top of every column of a chunk, as generateSurface() sees it from the 2D
+// noise stack alone. Enough to draw a distant chunk as one quad per column.
+struct SurfaceData
+{
+  std::array<uint8_t, CHUNK_SIZE * CHUNK_SIZE> topY;    // Highest non-air voxel
+  std::array<uint8_t, CHUNK_SIZE * CHUNK_SIZE> topType; // Its TextureType
+  // Blended biome colors at the column corners, as in ChunkData
+  BiomeColorField colors;
+};
+static_assert(CHUNK_HEIGHT <= 256, "SurfaceData::topY holds a Y coordinate in a byte");
+
+// Optional wall-clock breakdown of a generateChunk() call, in milliseconds.
+// Filled only when a pointer is passed, so the game path pays nothing for it.
+struct ChunkGenTimings
+{
+  float batchMs{0.0f};      // generateChunkBatch: noise, heights, columns, ores
+  float vegetationMs{0.0f}; // decorateChunk
+  float bordersMs{0.0f};    // generateChunkBorders
+  size_t noise3DSamples{0}; // cave/ravine/surface3D evaluations, body + border strips
 };
 
 // Biome properties for terrain generation
@@ -54,62 +103,129 @@ public:
   static constexpr float NOISE_OFFSET = 10000.0f;
 
   explicit TerrainGenerator(int seed = 1337);
-  ChunkData generateChunk(int chunkX, int chunkZ);
+  // generateTerrain() followed by decorateChunk(): one chunk on its own, with
+  // its trees' out-of-chunk voxels left in ChunkData::spill
+  ChunkData generateChunk(int chunkX, int chunkZ, ChunkGenTimings *timings = nullptr);
+
+  // Generation is split in two stages. generateTerrain() only needs the chunk's
+  // own noise. decorateChunk() places vegetation on that terrain; whatever
+  // crosses the chunk edge is appended to chunkData.spill for the caller to
+  // hand to the neighbours (see spillReplaces()). It then stamps the chunk's
+  // part of the grid structures (see findStructures()), which needs no spill.
+  ChunkData generateTerrain(int chunkX, int chunkZ, ChunkGenTimings *timings = nullptr);
+  void decorateChunk(ChunkData &chunkData, int chunkX, int chunkZ);
+
+  // Whether a spilled vegetation voxel may replace `current` in the neighbour
+  // it lands in. It only fills air and water, and a log beats leaves, so the
+  // result does not depend on the order neighbours are decorated in.
+  static bool spillReplaces(uint8_t current, uint8_t incoming)
+  {
+    if (current == AIR || current == WATER)
+      return true;
+    return current == OAK_LEAVES && incoming == OAK_LOG;
+  }
+
+  // Heights, biomes and top blocks only, from the 2D noise and the erosion
+  // tiles: no 3D noise, no voxels. Tops match the voxels generateTerrain()
+  // makes for the same chunk except where caves, overhangs or the mountain
+  // surface noise reshape the surface, and vegetation is left out.
+  SurfaceData generateSurface(int chunkX, int chunkZ);
+
+  // Structure placement grid: cells of STRUCTURE_CELL_CHUNKS x STRUCTURE_CELL_CHUNKS
+  // chunks, each holding at most one structure that lies entirely inside it.
+  // A chunk belongs to exactly one cell, so decorateChunk() only looks at the
+  // structures of that cell, and stamps its own part of each without spill.
+  static constexpr int STRUCTURE_CELL_CHUNKS = 4;
+  static constexpr int STRUCTURE_CELL = STRUCTURE_CELL_CHUNKS * CHUNK_SIZE;
+
+  // A kind of structure the grid can put in a cell. A cell rolls once and
+  // takes the first kind whose cumulative chance covers the roll; its site is
+  // then kept only if the kind accepts the biome and the ground is flat enough
+  // over the footprint.
+  struct GridStructureKind
+  {
+    std::vector<StructureTemplate> variants; // Compiled
+    float chance;
+    int maxSlope; // Largest height difference over the footprint
+    bool (*allowed)(BiomeType biome);
+  };
+
+  // Kinds the grid rolls for, in order. The world has none yet (villages and
+  // the like go in worldGridStructures()); `kinds` must outlive the generator.
+  void setGridStructures(const std::vector<GridStructureKind> &kinds) { m_gridStructures = &kinds; }
 
-  // Getter for thread-local generator to avoid redundant node graph setup
+  // Structures of the grid cell (cellX, cellZ), in cells. Only depends on the
+  // seed, the grid kinds and the cell, whichever chunk asks.
+  void findStructures(int cellX, int cellZ, std::vector<StructurePlacement> &out) const;
+
+  // Largest region generateRegion() accepts, in chunks per side
+  static constexpr int MAX_REGION_CHUNKS = 4;
+
+  // Generate an n x n block of chunks whose first chunk origin is at world
+  // block coordinates (regionX, regionZ). Every noise layer is sampled once for
+  // the whole block and sliced per chunk, so the result is identical to calling
+  // generateChunk() on each of them (generateTerrain() if decorate is false).
+  // Returned in row-major order (z, then x).
+  std::vector<ChunkData> generateRegion(int regionX, int regionZ, int n, bool decorate = true);
+
+  // Generator owned by the calling thread, for its scratch state. Node graphs
+  // are shared per seed, so a new seed only costs one graph setup in total.
   static TerrainGenerator &getThreadLocal(int seed);
 
   // Getter for seed to enable thread-safe generation
   int getSeed() const { return m_seed; }
 
-  // Get biome at world position (for cross-chunk queries)
+  // Build the ErosionTileCache tile (tileX, tileZ) of this seed unless it is
+  // cached already, so the chunks on it don't have to wait for the erosion pass.
+  void prefetchErosionTile(int tileX, int tileZ) const;
+
+  // 3D noise layers whose sampling resolution can be chosen independently
+  enum Noise3DLayer
+  {
+    NOISE_3D_CAVE = 0,
+    NOISE_3D_RAVINE,
+    NOISE_3D_SURFACE,
+    NOISE_3D_LAYER_COUNT
+  };
+
+  // Full evaluates the noise at every voxel. Coarse evaluates it on a
+  // world-aligned lattice (COARSE_STEP_XZ x COARSE_STEP_Y x COARSE_STEP_XZ) and
+  // interpolates trilinearly, which is much cheaper for low-frequency layers.
+  // Values only depend on world position in both modes, so chunks, borders and
+  // regions stay seamless whatever the mode.
+  enum class NoiseSampling
+  {
+    Full,
+    Coarse
+  };
+  static constexpr int COARSE_STEP_XZ = 4;
+  static constexpr int COARSE_STEP_Y = 8;
+
+  void setNoiseSampling(Noise3DLayer layer, NoiseSampling sampling);
+  NoiseSampling getNoiseSampling(Noise3DLayer layer) const { return m_noiseSampling[layer]; }
+
+  // Get biome at world position (for cross-chunk queries). Resolved from
+  // BiomeAtlas, i.e. the biome of the nearest BiomeAtlas::CELL_SIZE cell.
   BiomeType getBiomeAt(int worldX, int worldZ) const;
 
   // Batch biome sampling for map visualization (uses GenUniformGrid2D for SIMD efficiency).
   // centerX/Z are world-space coordinates, step is world units per pixel,
   // width/height are the output dimensions. outBiomes is filled in row-major order.
+  // From step >= BiomeAtlas::CELL_SIZE / 2 pixels are read from BiomeAtlas,
+  // closer zooms sample the noise directly.
   void getBiomeRegion(float centerX, float centerZ, float step,
                       int width, int height, std::vector<BiomeType> &outBiomes) const;
 
   // Get biome configuration
   static const BiomeConfig &getBiomeConfig(BiomeType biome);
 
-  // Pack a float RGB color into a uint32_t RGBA (alpha = 255)
-  static inline uint32_t packColor(const glm::vec3 &c)
-  {
-    uint32_t r = static_cast<uint32_t>(c.r * 255.0f);
-    uint32_t g = static_cast<uint32_t>(c.g * 255.0f);
-    uint32_t b = static_cast<uint32_t>(c.b * 255.0f);
-    return r | (g << 8) | (b << 16) | (255u << 24);
-  }
-
 private:
   // =============================================
   // NOISE GENERATORS
   // =============================================
 
-  // Terrain shape noise
-  FastNoise::SmartNode<FastNoise::Generator> m_continentalNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_erosionNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_peaksValleysNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_ridgeNoise;
-
-  // Biome noise
-  FastNoise::SmartNode<FastNoise::Generator> m_temperatureNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_humidityNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_weirdnessNoise; // For rare biomes
-  FastNoise::SmartNode<FastNoise::Generator> m_riverNoise;
-
-  // Cave and structure noise
-  FastNoise::SmartNode<FastNoise::Generator> m_caveNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_ravineNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_surface3DNoise;
-
-  // Vegetation noise
-  FastNoise::SmartNode<FastNoise::Generator> m_treeNoise;
-  FastNoise::SmartNode<FastNoise::Generator> m_forestDensityNoise; // Large-scale forest cluster noise
-
   // Ore generation
+  static constexpr int ORE_TEMPLATES_PER_ORE = 64;
   struct OreDef
   {
     TextureType type;
@@ -118,11 +234,51 @@ private:
     int clusterSize;
     int clustersPerChunk;
     int seedOffset;
+
+    // ORE_TEMPLATES_PER_ORE cluster shapes, built once per seed by
+    // compileOreTemplates(): template t owns offsets [templateStart[t],
+    // templateStart[t + 1]) of the flat arrays, unique and relative to the
+    // cluster start.
+    std::vector<int8_t> offsetX{};
+    std::vector<int8_t> offsetY{};
+    std::vector<int8_t> offsetZ{};
+    std::array<uint16_t, ORE_TEMPLATES_PER_ORE + 1> templateStart{};
+  };
+
+  // Everything that only depends on the seed. Built once per seed by
+  // getNoiseGraphs() and shared read-only by all of that seed's generators
+  // (FastNoise nodes can be sampled from several threads at once).
+  struct NoiseGraphs
+  {
+    // Terrain shape noise
+    FastNoise::SmartNode<FastNoise::Generator> continental;
+    FastNoise::SmartNode<FastNoise::Generator> erosion;
+    FastNoise::SmartNode<FastNoise::Generator> peaksValleys;
+    FastNoise::SmartNode<FastNoise::Generator> ridge;
+
+    // Biome noise
+    FastNoise::SmartNode<FastNoise::Generator> temperature;
+    FastNoise::SmartNode<FastNoise::Generator> humidity;
+    FastNoise::SmartNode<FastNoise::Generator> weirdness; // For rare biomes
+    FastNoise::SmartNode<FastNoise::Generator> river;
+
+    // Cave and structure noise
+    FastNoise::SmartNode<FastNoise::Generator> cave;
+    FastNoise::SmartNode<FastNoise::Generator> ravine;
+    FastNoise::SmartNode<FastNoise::Generator> surface3D;
+
+    // Vegetation noise
+    FastNoise::SmartNode<FastNoise::Generator> tree;
+    FastNoise::SmartNode<FastNoise::Generator> forestDensity; // Large-scale forest cluster noise
+
+    std::vector<OreDef> ores;
   };
-  std::vector<OreDef> m_ores;
+  std::shared_ptr<const NoiseGraphs> m_graphs;
 
   // Generation parameters
   int m_seed;
+  std::array<NoiseSampling, NOISE_3D_LAYER_COUNT> m_noiseSampling;
+  const std::vector<GridStructureKind> *m_gridStructures;
 
   // Biome configurations (static)
   static std::array<BiomeConfig, BIOME_COUNT> s_biomeConfigs;
@@ -131,26 +287,56 @@ private:
   // =============================================
   // SETUP METHODS
   // =============================================
-  void setupNoiseGenerators();
-  void setupTerrainNoise();
-  void setupBiomeNoise();
-  void setupCaveNoise();
-  void setupVegetationNoise();
-  void setupOres();
+  // The seed's shared graphs, built on first use
+  static std::shared_ptr<const NoiseGraphs> getNoiseGraphs(int seed);
+  static void setupTerrainNoise(NoiseGraphs &graphs);
+  static void setupBiomeNoise(NoiseGraphs &graphs);
+  static void setupCaveNoise(NoiseGraphs &graphs);
+  static void setupVegetationNoise(NoiseGraphs &graphs);
+  static void setupOres(NoiseGraphs &graphs, int seed);
+  static void compileOreTemplates(NoiseGraphs &graphs, int seed);
 
   // =============================================
   // GENERATION METHODS
   // =============================================
 
   // Core terrain generation
+  void sampleChunkNoise2D(int chunkX, int chunkZ);
+  void sampleChunkNoise3D(int chunkX, int chunkZ);
+  // Fill out (laid out z, y, x) with one 3D layer over a world-space box, at the layer's sampling mode
+  void sampleNoise3D(Noise3DLayer layer, float *out, int worldX, int minY, int worldZ,
+                     int xSize, int ySize, int zSize);
+  // 2D noise, eroded heights, biomes and the vertical slab the 3D noise is needed for
+  void generateColumnData(ChunkData &chunkData, int chunkX, int chunkZ);
   void generateChunkBatch(ChunkData &chunkData, int chunkX, int chunkZ);
+  // Stamps every ore's cluster templates into the chunk's STONE voxels
+  void placeOres(ChunkData &chunkData, int chunkX, int chunkZ) const;
   void generateChunkBorders(ChunkData &chunkData, int chunkX, int chunkZ);
+  // Stores this chunk's edge-column 3D noise in ColumnNoiseCache for the neighbours' border pass
+  void publishEdgeNoise(const ChunkData &chunkData, int chunkX, int chunkZ) const;
+  // Biomes of a (startX + i) * step grid in noise space, as shown by the biome map
+  void sampleBiomeGrid(int startX, int startZ, int width, int height, float step,
+                       std::vector<BiomeType> &outBiomes) const;
+  // BiomeAtlas tile of this seed, sampled on first touch
+  std::shared_ptr<const BiomeAtlas::Tile> getBiomeTile(int tileX, int tileZ) const;
+  // Blurs the atlas biome colours around chunks x chunks chunks from world
+  // block (worldX, worldZ) into the calling thread's BiomeColorGrid
+  void buildBiomeColors(int worldX, int worldZ, int chunks) const;
+  // One bit per coarse-sampled layer, keys ColumnNoiseCache entries
+  uint32_t noiseSamplingVariant() const;
 
   // Height calculation
   int calculateHeight(float continental, float erosion, float peaksValleys,
                       float ridge, float riverVal) const;
   float calculateHeightFloat(float continental, float erosion, float peaksValleys, float ridge, float riverVal) const;
-  void applyErosion(float *heightMap, int size) const;
+
+  // Erosion, run once per ErosionTileCache tile over its columns plus a margin
+  void buildErosionTile(int tileX, int tileZ, ErosionTileCache::Tile &out) const;
+  std::shared_ptr<const ErosionTileCache::Tile> getErosionTile(int tileX, int tileZ) const;
+  // Eroded heights of a size x size window starting at world column (worldX, worldZ)
+  void fillErodedHeights(float *out, int worldX, int worldZ, int size) const;
+  void applyHydraulicErosion(float *heightMap, int size) const;
+  void applyThermalErosion(float *heightMap, int size) const;
 
   // Biome determination
   BiomeType determineBiome(float temperature, float humidity, float weirdness,
@@ -165,6 +351,29 @@ private:
   void placeJungleTree(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ);
   void placeCactus(ChunkData &chunkData, int localX, int localZ, int baseY, int worldX, int worldZ);
 
+  static const std::vector<GridStructureKind> &worldGridStructures();
+
+  // Structures. Every shape variant is compiled once, at first use; the
+  // place*Tree() functions only pick a variant from the tree's hash.
+  struct StructureLibrary
+  {
+    std::vector<StructureTemplate> oakTrees;    // Index: trunk height, wide canopy, extra cap layer
+    std::vector<StructureTemplate> birchTrees;  // Index: trunk height, extra cap layer
+    std::vector<StructureTemplate> spruceTrees; // Index: trunk height, fat variant, bare bottom
+    std::vector<StructureTemplate> jungleTrees; // Index: trunk height, canopy radius, prop roots
+  };
+  static const StructureLibrary &structureLibrary();
+  static void buildOakTree(StructureTemplate &shape, int trunkHeight, bool wideCanopy, int extraTopLayers);
+  static void buildBirchTree(StructureTemplate &shape, int trunkHeight, int extraTopLayers);
+  static void buildSpruceTree(StructureTemplate &shape, int trunkHeight, bool fatVariant, bool bareBottom);
+  static void buildJungleTree(StructureTemplate &shape, int trunkHeight, int canopyRadius, int rootHeight);
+
+  // Writes a template anchored at chunk-local (x, y, z). Voxels outside the
+  // chunk go to chunkData.spill when `spill` is set and are dropped otherwise.
+  void stampStructure(ChunkData &chunkData, const StructureTemplate &shape, int x, int y, int z, bool spill) const;
+  // Stamps the part of the grid structures of the chunk's cell that lies in the chunk
+  void placeStructures(ChunkData &chunkData, int chunkX, int chunkZ) const;
+
   // Per-tree deterministic RNG from world position
   static inline uint32_t treeHash(int worldX, int worldZ, int seed)
   {
@@ -196,12 +405,15 @@ private:
     return z * CHUNK_SIZE + x;
   }
 
-  // Safe voxel setting (bounds checking)
+  // Vegetation voxel setting: out-of-chunk voxels go to chunkData.spill
   inline bool setVoxelSafe(ChunkData &chunkData, int x, int y, int z, TextureType type)
   {
-    if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE ||
-        y < 0 || y >= CHUNK_HEIGHT)
+    if (y < 0 || y >= CHUNK_HEIGHT)
+      return false;
+    if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE)
     {
+      chunkData.spill.push_back({static_cast<int8_t>(x), static_cast<uint8_t>(y),
+                                 static_cast<int8_t>(z), static_cast<uint8_t>(type)});
       return false;
     }
     chunkData.voxels[getVoxelIndex(x, y, z)].type = type;
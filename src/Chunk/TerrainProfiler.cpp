@@ -0,0 +1,70 @@
+#include "TerrainProfiler.hpp"
+
+std::atomic<bool> TerrainProfiler::s_enabled{true};
+std::atomic<TerrainProfiler::ThreadBlock *> TerrainProfiler::s_blocks{nullptr};
+
+const char *TerrainProfiler::name(Counter counter)
+{
+	static constexpr const char *NAMES[COUNTER_COUNT] = {
+		"Continental",
+		"Erosion",
+		"Peaks & valleys",
+		"Ridge",
+		"Temperature",
+		"Humidity",
+		"Weirdness",
+		"River",
+		"Cave",
+		"Ravine",
+		"Surface 3D",
+		"Tree",
+		"Forest density",
+		"Heights",
+		"Erosion tiles",
+		"Biome colours",
+		"Column fill",
+		"Ores",
+		"Borders",
+		"Vegetation",
+		"Structures",
+	};
+	return counter >= 0 && counter < COUNTER_COUNT ? NAMES[counter] : "?";
+}
+
+TerrainProfiler::Totals TerrainProfiler::totals()
+{
+	Totals totals;
+	for (ThreadBlock *block = s_blocks.load(std::memory_order_acquire); block; block = block->next)
+	{
+		for (int i = 0; i < COUNTER_COUNT; ++i)
+		{
+			totals.nanoseconds[i] += block->nanoseconds[i].load(std::memory_order_relaxed);
+			totals.calls[i] += block->calls[i].load(std::memory_order_relaxed);
+		}
+	}
+	return totals;
+}
+
+void TerrainProfiler::add(Counter counter, int64_t nanoseconds)
+{
+	ThreadBlock &block = threadBlock();
+	// Only this thread writes the block: a plain load and store is enough
+	block.nanoseconds[counter].store(block.nanoseconds[counter].load(std::memory_order_relaxed) + static_cast<uint64_t>(nanoseconds),
+									 std::memory_order_relaxed);
+	block.calls[counter].store(block.calls[counter].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+TerrainProfiler::ThreadBlock &TerrainProfiler::threadBlock()
+{
+	// Never freed: one block per thread that ever generated terrain
+	thread_local ThreadBlock *block = []
+	{
+		ThreadBlock *created = new ThreadBlock();
+		created->next = s_blocks.load(std::memory_order_relaxed);
+		while (!s_blocks.compare_exchange_weak(created->next, created, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+		return created;
+	}();
+	return *block;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// Wall-clock time spent in each noise node and each terrain generation pass,
+/// summed over every generating thread.
+///
+/// Each thread writes its own block of counters (single writer, relaxed
+/// atomics, no read-modify-write), so counting costs two clock reads per
+/// scope and never contends. totals() sums the blocks without locking; a
+/// thread's block is kept after it exits, so totals never go backwards.
+class TerrainProfiler
+{
+public:
+	enum Counter
+	{
+		// One FastNoise node each: GenUniformGrid2D/3D and GenPositionArray3D calls
+		NOISE_CONTINENTAL,
+		NOISE_EROSION,
+		NOISE_PEAKS_VALLEYS,
+		NOISE_RIDGE,
+		NOISE_TEMPERATURE,
+		NOISE_HUMIDITY,
+		NOISE_WEIRDNESS,
+		NOISE_RIVER,
+		NOISE_CAVE,
+		NOISE_RAVINE,
+		NOISE_SURFACE_3D,
+		NOISE_TREE,
+		NOISE_FOREST_DENSITY,
+		NOISE_COUNT,
+
+		// Generation passes, the noise calls made inside them included
+		PASS_HEIGHTS = NOISE_COUNT, // 2D noise, eroded heights and biomes of a chunk
+		PASS_EROSION,				// Hydraulic and thermal erosion of an erosion tile
+		PASS_BIOME_COLORS,			// Blurring the atlas biome colours of a chunk or region
+		PASS_COLUMN_FILL,
+		PASS_ORES,
+		PASS_BORDERS,
+		PASS_VEGETATION,
+		PASS_STRUCTURES,
+		COUNTER_COUNT
+	};
+
+	struct Totals
+	{
+		std::array<uint64_t, COUNTER_COUNT> nanoseconds{};
+		std::array<uint64_t, COUNTER_COUNT> calls{};
+	};
+
+	static const char *name(Counter counter);
+
+	/// Disabled scopes skip the clock entirely
+	static void setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+	static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	static Totals totals();
+
+	/// Charges the lifetime of the scope to a counter of the calling thread
+	class Scope
+	{
+	public:
+		explicit Scope(Counter counter)
+			: m_counter(counter), m_active(isEnabled())
+		{
+			if (m_active)
+				m_start = std::chrono::steady_clock::now();
+		}
+		~Scope()
+		{
+			if (m_active)
+				add(m_counter, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+		}
+
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	private:
+		Counter m_counter;
+		bool m_active;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+private:
+	struct ThreadBlock
+	{
+		std::array<std::atomic<uint64_t>, COUNTER_COUNT> nanoseconds{};
+		std::array<std::atomic<uint64_t>, COUNTER_COUNT> calls{};
+		ThreadBlock *next = nullptr;
+	};
+
+	static void add(Counter counter, int64_t nanoseconds);
+	/// The calling thread's block, pushed onto s_blocks on first use
+	static ThreadBlock &threadBlock();
+
+	static std::atomic<bool> s_enabled;
+	static std::atomic<ThreadBlock *> s_blocks;
+};
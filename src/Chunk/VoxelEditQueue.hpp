@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// One voxel written into a chunk by someone else, in that chunk's local coordinates
+struct VoxelEdit
+{
+	uint8_t x;
+	uint8_t y;
+	uint8_t z;
+	uint8_t type;
+};
+
+/// Lock-free multi-producer, single-consumer queue of VoxelEdit batches.
+///
+/// Any thread can push a batch without locking (the vegetation stage of a
+/// neighbouring chunk, typically). The owner takes everything queued so far in
+/// one go. Batches come out in no particular order, so whatever applies them
+/// has to be order-independent.
+class VoxelEditQueue
+{
+public:
+	VoxelEditQueue() = default;
+	~VoxelEditQueue() { clear(); }
+
+	VoxelEditQueue(const VoxelEditQueue &) = delete;
+	VoxelEditQueue &operator=(const VoxelEditQueue &) = delete;
+
+	/// Not thread-safe: only for relocating an idle owner (ChunkPool storage).
+	VoxelEditQueue(VoxelEditQueue &&other) noexcept
+		: m_head(other.m_head.exchange(nullptr))
+	{
+	}
+	VoxelEditQueue &operator=(VoxelEditQueue &&other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			m_head.store(other.m_head.exchange(nullptr));
+		}
+		return *this;
+	}
+
+	/// Thread-safe and lock-free. Empty batches are ignored.
+	void push(std::vector<VoxelEdit> edits)
+	{
+		if (edits.empty())
+			return;
+
+		Node *node = new Node{std::move(edits), m_head.load(std::memory_order_relaxed)};
+		while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	bool empty() const { return m_head.load(std::memory_order_acquire) == nullptr; }
+
+	/// Appends every queued edit to out and empties the queue. Only one thread
+	/// may take at a time; pushes can run concurrently.
+	void take(std::vector<VoxelEdit> &out)
+	{
+		Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+		while (node)
+		{
+			out.insert(out.end(), node->edits.begin(), node->edits.end());
+			Node *next = node->next;
+			delete node;
+			node = next;
+		}
+	}
+
+	/// Same threading rules as take()
+	void clear()
+	{
+		Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+		while (node)
+		{
+			Node *next = node->next;
+			delete node;
+			node = next;
+		}
+	}
+
+private:
+	struct Node
+	{
+		std::vector<VoxelEdit> edits;
+		Node *next;
+	};
+
+	// Batches are only ever removed all at once, so the push CAS cannot suffer from ABA
+	std::atomic<Node *> m_head{nullptr};
+};
@@ -422,6 +422,7 @@ void Engine::updateWorldState()
 		chunkManager->processChunkLoading(currentRenderSettings, loadBudget);
 		chunkManager->processFinishedJobs();
 		chunkManager->generatePendingVoxels(camera, currentRenderSettings, seed, genBudget);
+		chunkManager->decoratePendingChunks(camera, currentRenderSettings, genBudget);
 		chunkManager->meshPendingChunks(camera, currentRenderSettings, meshBudget);
 		chunkManager->uploadPendingMeshes(uploadBudget);
 	}
@@ -66,6 +66,7 @@ struct RenderTiming
 	float chunkRendering{0.0f};
 	float uiRendering{0.0f}; // For ImGui rendering pass
 	float totalFrame{0.0f};
+	float columnCacheHitRate{0.0f}; // Border strips served from ColumnNoiseCache (0..1)
 };
 
 struct PostProcessSettings
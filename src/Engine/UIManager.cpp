@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <Chunk/ChunkPool.hpp>
+#include <Chunk/MeshCache.hpp>
 
 UIManager::UIManager(Engine *engineInstance, SDL_Window *window, int &windowWidth, int &windowHeight)
 	: engine(engineInstance), sdlWindow(window), winWidth(windowWidth), winHeight(windowHeight)
@@ -128,6 +129,12 @@ void UIManager::update()
 			ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "  Overflow: %zu", pool->overflowCount());
 		else
 			ImGui::Text("  Overflow: %zu", pool->overflowCount());
+
+		const MeshCache &cache = engine->getChunkManager()->getMeshCache();
+		ImGui::Text("Mesh Cache Stats:");
+		ImGui::Text("  Chunks: %zu", cache.size());
+		ImGui::Text("  Memory: %.1f / %.0f MiB", cache.bytes() / (1024.0 * 1024.0), cache.capacityBytes() / (1024.0 * 1024.0));
+		ImGui::Text("  Hit rate: %.1f%% (%llu hits)", cache.hitRate() * 100.0f, static_cast<unsigned long long>(cache.hits()));
 	}
 
 	ImGui::Separator();
@@ -172,6 +179,7 @@ void UIManager::update()
 
 			ImGui::EndTable();
 		}
+		ImGui::Text("Column noise cache hit rate: %.1f%%", renderTiming.columnCacheHitRate * 100.0f);
 	}
 
 	ImGui::End(); // End "ft_vox" window
@@ -179,6 +187,7 @@ void UIManager::update()
 	handleServerControls();
 	handleShaderParametersWindow(); // Added call
 	renderBiomeMap();				// This also calls updateBiomeMap if needed
+	renderTerrainProfile();
 }
 
 void UIManager::render()
@@ -582,3 +591,83 @@ void UIManager::renderBiomeMap()
 
 	ImGui::End();
 }
+
+void UIManager::renderTerrainProfile()
+{
+	TerrainProfileSettings &profile = terrainProfile;
+
+	// Sample the totals even when the window is collapsed, so the history is
+	// ready when it is opened
+	const double now = SDL_GetTicks() / 1000.0;
+	if (profile.lastSampleTime < 0.0)
+	{
+		profile.lastTotals = TerrainProfiler::totals();
+		profile.lastSampleTime = now;
+	}
+	else if (now - profile.lastSampleTime >= TerrainProfileSettings::SAMPLE_INTERVAL)
+	{
+		const TerrainProfiler::Totals totals = TerrainProfiler::totals();
+		const double elapsed = now - profile.lastSampleTime;
+		for (int i = 0; i < TerrainProfiler::COUNTER_COUNT; ++i)
+		{
+			const double ms = static_cast<double>(totals.nanoseconds[i] - profile.lastTotals.nanoseconds[i]) * 1e-6;
+			profile.current[i] = static_cast<float>(ms / elapsed);
+			profile.history[i][profile.historyOffset] = profile.current[i];
+		}
+		profile.historyOffset = (profile.historyOffset + 1) % TerrainProfileSettings::HISTORY;
+		profile.lastTotals = totals;
+		profile.lastSampleTime = now;
+	}
+
+	ImGui::Begin("Terrain Profile");
+
+	bool enabled = TerrainProfiler::isEnabled();
+	if (ImGui::Checkbox("Enabled", &enabled))
+		TerrainProfiler::setEnabled(enabled);
+	ImGui::SameLine();
+	ImGui::TextDisabled("(ms of worker time per second)");
+
+	// Shares are of the group total: passes include the noise they call
+	auto renderGroup = [&](const char *title, int first, int last)
+	{
+		float groupTotal = 0.0f;
+		for (int i = first; i < last; ++i)
+			groupTotal += profile.current[i];
+
+		if (!ImGui::CollapsingHeader(title, ImGuiTreeNodeFlags_DefaultOpen))
+			return;
+		if (!ImGui::BeginTable(title, 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+			return;
+		ImGui::TableSetupColumn("Counter");
+		ImGui::TableSetupColumn("ms/s");
+		ImGui::TableSetupColumn("Share");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+		ImGui::TableHeadersRow();
+
+		for (int i = first; i < last; ++i)
+		{
+			const auto counter = static_cast<TerrainProfiler::Counter>(i);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(TerrainProfiler::name(counter));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", profile.current[i]);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f%%", groupTotal > 0.0f ? profile.current[i] / groupTotal * 100.0f : 0.0f);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(profile.lastTotals.calls[i]));
+			ImGui::TableNextColumn();
+			ImGui::PushID(i);
+			ImGui::PlotHistogram("##history", profile.history[i].data(), TerrainProfileSettings::HISTORY,
+								 profile.historyOffset, nullptr, 0.0f, FLT_MAX, ImVec2(160.0f, 18.0f));
+			ImGui::PopID();
+		}
+		ImGui::EndTable();
+	};
+
+	renderGroup("Noise nodes", 0, TerrainProfiler::NOISE_COUNT);
+	renderGroup("Passes", TerrainProfiler::PASS_HEIGHTS, TerrainProfiler::COUNTER_COUNT);
+
+	ImGui::End();
+}
@@ -15,6 +15,7 @@
 #include <Shader/Shader.hpp>
 #include <Network/Server.hpp>
 #include <Network/Client.hpp>
+#include <Chunk/TerrainProfiler.hpp>
 #include <utils.hpp>
 
 // Forward declarations
@@ -32,6 +33,19 @@ struct BiomeMapSettings
 	glm::vec2 lastPlayerPos{0.0f, 0.0f};
 };
 
+/// Rolling history of TerrainProfiler totals, in ms of worker time per second
+struct TerrainProfileSettings
+{
+	static constexpr int HISTORY = 120;
+	static constexpr double SAMPLE_INTERVAL = 0.5; // Seconds between samples
+
+	TerrainProfiler::Totals lastTotals;
+	double lastSampleTime{-1.0};
+	std::array<float, TerrainProfiler::COUNTER_COUNT> current{};
+	std::array<std::array<float, HISTORY>, TerrainProfiler::COUNTER_COUNT> history{};
+	int historyOffset{0}; // Oldest sample of every ring
+};
+
 class UIManager
 {
 public:
@@ -48,6 +62,7 @@ public:
 	void handleShaderParametersWindow();
 	void renderBiomeMap();
 	void updateBiomeMap();
+	void renderTerrainProfile();
 
 	RenderSettings &getRenderSettings() { return renderSettings; }
 	const RenderSettings &getRenderSettings() const { return renderSettings; }
@@ -80,6 +95,7 @@ private:
 	char ipInputBuffer[128] = "127.0.0.1";
 
 	BiomeMapSettings biomeMap;
+	TerrainProfileSettings terrainProfile;
 
 	// Biome map background generation
 	std::future<void> m_biomeMapFuture;
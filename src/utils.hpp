@@ -34,55 +34,68 @@ struct Voxel
 	uint8_t type; // Supports up to 256 block types (0-255)
 };
 
-struct Vertex
+/// Chunk mesh quad, 16 bytes, read by the vertex shader from a shader storage
+/// buffer (vertex pulling): every chunk draws the same index pattern, four
+/// vertices per quad, and vertex gl_VertexID expands corner gl_VertexID % 4 of
+/// quad gl_VertexID / 4. Corners 0-3 are start, start + U, start + U + V and
+/// start + V, with U and V the face's axes (normal axis + 1 and + 2, mod 3).
+/// Positions are local to the chunk, whose origin the shaders get per draw.
+/// Texture coordinates come from the local position along the face's axes,
+/// so a merged quad tiles as often as it is wide.
+struct ChunkQuad
 {
-	glm::vec3 position;
-	uint32_t packedData; // 0-2: normal, 3-10: textureIndex, 11: useBiomeColor, 12-13: AO
-	glm::vec2 texCoord;
-	uint32_t packedBiomeColor; // RGBA8
+	uint32_t position;	// 0-4: x, 5-13: y, 14-18: z of corner 0, 19-21: normal, 22-29: AO of corners 0-3 (2 bits each)
+	uint32_t material;	// 0-7: textureIndex, 8: useBiomeColor, 16-23: size along U - 1, 24-31: size along V - 1
+	uint32_t colors[2]; // Biome colours (RGB565): corners 0 and 1, then corners 2 and 3
 
-	bool operator==(const Vertex &other) const
+	static ChunkQuad pack(const glm::ivec3 &start, uint32_t normal, const uint32_t (&ao)[4], int sizeU, int sizeV,
+						  uint32_t textureIndex, bool useBiomeColor, const uint16_t (&color)[4])
 	{
-		return position == other.position &&
-			   packedData == other.packedData &&
-			   texCoord == other.texCoord &&
-			   packedBiomeColor == other.packedBiomeColor;
+		ChunkQuad q;
+		q.position = static_cast<uint32_t>(start.x) | (static_cast<uint32_t>(start.y) << 5) | (static_cast<uint32_t>(start.z) << 14) |
+					 ((normal & 0x7u) << 19);
+		for (int i = 0; i < 4; ++i)
+			q.position |= (ao[i] & 0x3u) << (22 + 2 * i);
+		q.material = (textureIndex & 0xFFu) | (useBiomeColor ? (1u << 8) : 0u) |
+					 (static_cast<uint32_t>(sizeU - 1) << 16) | (static_cast<uint32_t>(sizeV - 1) << 24);
+		q.colors[0] = color[0] | (static_cast<uint32_t>(color[1]) << 16);
+		q.colors[1] = color[2] | (static_cast<uint32_t>(color[3]) << 16);
+		return q;
 	}
+
+	glm::ivec3 start() const
+	{
+		return {static_cast<int>(position & 0x1Fu), static_cast<int>((position >> 5) & 0x1FFu), static_cast<int>((position >> 14) & 0x1Fu)};
+	}
+	uint32_t normal() const { return (position >> 19) & 0x7u; }
+	uint32_t ao(int corner) const { return (position >> (22 + 2 * corner)) & 0x3u; }
+	uint32_t textureIndex() const { return material & 0xFFu; }
+	bool useBiomeColor() const { return (material >> 8) & 0x1u; }
+	int sizeU() const { return static_cast<int>((material >> 16) & 0xFFu) + 1; }
+	int sizeV() const { return static_cast<int>(material >> 24) + 1; }
+	uint16_t color(int corner) const { return static_cast<uint16_t>(colors[corner >> 1] >> (16 * (corner & 1))); }
+
+	bool operator==(const ChunkQuad &other) const = default;
 };
+static_assert(sizeof(ChunkQuad) == 16, "ChunkQuad must match the shaders' uvec4");
 
 inline void hash_combine(std::size_t &seed, uint32_t v)
 {
 	seed ^= std::hash<uint32_t>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
-struct VertexHasher
-{
-	std::size_t operator()(const Vertex &vertex) const
-	{
-		size_t seed = 0;
-		uint32_t px, py, pz, tx, ty;
-		std::memcpy(&px, &vertex.position.x, 4);
-		std::memcpy(&py, &vertex.position.y, 4);
-		std::memcpy(&pz, &vertex.position.z, 4);
-		std::memcpy(&tx, &vertex.texCoord.x, 4);
-		std::memcpy(&ty, &vertex.texCoord.y, 4);
-
-		hash_combine(seed, px);
-		hash_combine(seed, py);
-		hash_combine(seed, pz);
-		hash_combine(seed, vertex.packedData);
-		hash_combine(seed, tx);
-		hash_combine(seed, ty);
-		hash_combine(seed, vertex.packedBiomeColor);
-		return seed;
-	}
-};
-
 static constexpr int CHUNK_SIZE = 16;										// Size of a chunk in voxels
 static constexpr int CHUNK_HEIGHT = 256;									// Height of a chunk in voxels
 static constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE; // Total number of voxels in a chunk
 static constexpr int CHUNK_RADIUS = 16;										// Radius of a chunk in world units
 
+// Vertical sections: a chunk is meshed, uploaded and drawn per section, so an
+// edit only remeshes the sections it touches. Bit s of a section mask is section s
+static constexpr int SECTION_SIZE = 16;										// Layers per section
+static constexpr int SECTION_COUNT = CHUNK_HEIGHT / SECTION_SIZE;
+static constexpr uint32_t ALL_SECTIONS = (1u << SECTION_COUNT) - 1;
+static_assert(CHUNK_HEIGHT % SECTION_SIZE == 0 && SECTION_COUNT < 32, "Sections tile the chunk and fit a 32-bit mask");
+
 // Biome types based on temperature and humidity
 enum BiomeType
 {
@@ -210,6 +223,7 @@ static const std::map<TextureType, std::string> textureTypeString = {
 enum ChunkState
 {
 	UNLOADED,
+	TERRAIN, // Terrain generated, waiting for the vegetation stage
 	GENERATED,
 	MESHED
 };
@@ -0,0 +1,32 @@
+#pragma once
+
+// Shared by the check executables: the seed they generate terrain with, failure
+// reporting, and the runner their main() hands the checks to.
+
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+
+/// World seed of every check that generates terrain
+constexpr int SEED = 1337;
+
+/// Reports `what` as a failure unless `condition` holds, and returns `condition`
+inline bool expect(bool condition, const char *what)
+{
+	if (!condition)
+		std::cerr << "[TEST] FAILED: " << what << '\n';
+	return condition;
+}
+
+/// Runs every check, including the ones after a failure, so that a single run
+/// lists all failures. Returns the exit code for main().
+inline int runChecks(const char *name, std::initializer_list<std::function<bool()>> checks)
+{
+	bool ok = true;
+	for (const std::function<bool()> &check : checks)
+		ok &= check();
+	if (!ok)
+		return 1;
+	std::cout << "[TEST] " << name << " checks passed\n";
+	return 0;
+}
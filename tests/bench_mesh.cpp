@@ -0,0 +1,647 @@
+// Headless benchmark for chunk meshing.
+//
+// Generates a square grid of chunks once, then meshes every one of them with
+// buildChunkMesh() and with the slice mesher it replaced (kept below as the
+// baseline), single-threaded, and reports per-chunk latency percentiles,
+// throughput and quad counts for both. A third run re-meshes what a voxel
+// edit at the surface of each chunk dirties (buildSectionMeshes() over
+// sectionsTouchedBy()), against meshing the whole chunk. Also reports how
+// the chunks' sections are stored (see ChunkSection).
+//
+// Usage: bench_mesh [--seed N] [--radius R] [--origin X Z] [--repeat K]
+//   --radius R   grid of (2R+1)^2 chunks around the origin chunk (default 4)
+//   --origin X Z origin in chunk coordinates (default 0 0)
+//   --repeat K   how many times every chunk is meshed by each mesher (default 5)
+
+#include <Chunk/ChunkMesher.hpp>
+#include <Chunk/TerrainGenerator.hpp>
+#include <Renderer/TextureManager.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	struct BenchConfig
+	{
+		int seed = 1337;
+		int radius = 4;
+		int originX = 0;
+		int originZ = 0;
+		int repeat = 5;
+	};
+
+	struct MeshBuffers
+	{
+		std::vector<ChunkQuad> quads;
+		std::vector<ChunkQuad> waterQuads;
+	};
+
+	struct RunResult
+	{
+		std::vector<float> perChunkUs;
+		double wallSeconds = 0.0;
+		size_t quads = 0; // Over one pass of the grid
+	};
+
+	void printUsage(const char *argv0)
+	{
+		std::cout << "Usage: " << argv0 << " [--seed N] [--radius R] [--origin X Z] [--repeat K]\n";
+	}
+
+	bool parseArgs(int argc, char **argv, BenchConfig &cfg)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			auto next = [&](int &out) -> bool
+			{
+				if (i + 1 >= argc)
+					return false;
+				out = std::atoi(argv[++i]);
+				return true;
+			};
+
+			if (std::strcmp(argv[i], "--seed") == 0)
+			{
+				if (!next(cfg.seed))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--radius") == 0)
+			{
+				if (!next(cfg.radius))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--origin") == 0)
+			{
+				if (!next(cfg.originX) || !next(cfg.originZ))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--repeat") == 0)
+			{
+				if (!next(cfg.repeat))
+					return false;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		cfg.radius = std::max(cfg.radius, 0);
+		cfg.repeat = std::max(cfg.repeat, 1);
+		return true;
+	}
+
+	// The mesher Chunk::generateMesh() used before buildChunkMesh(): walks
+	// every cell of every slice and looks both voxels up through a bounds-checked
+	// helper. Same output rules, so both meshers are timed on the same work.
+	void sliceMesh(const ChunkMeshInput &input, std::vector<ChunkQuad> &quads, std::vector<ChunkQuad> &waterQuads)
+	{
+		quads.clear();
+		waterQuads.clear();
+
+		static thread_local std::vector<uint8_t> mask;
+
+		// Checks local voxels and the precomputed neighbor shell
+		auto getVoxelDataForMeshing = [&](int lx, int ly, int lz) -> TextureType
+		{
+			if (static_cast<uint32_t>(lx) < CHUNK_SIZE && static_cast<uint32_t>(ly) < CHUNK_HEIGHT &&
+					static_cast<uint32_t>(lz) < CHUNK_SIZE)
+			{
+				return static_cast<TextureType>((*input.sections)[ly / SECTION_SIZE].get(lx, ly % SECTION_SIZE, lz));
+			}
+			// Check the neighbor shell for out-of-bounds coordinates relevant to
+			// meshing.
+			if (lx >= -1 && lx <= CHUNK_SIZE && ly >= -1 && ly <= CHUNK_HEIGHT &&
+					lz >= -1 && lz <= CHUNK_SIZE)
+			{
+				if (!input.shell)
+					return AIR;
+				size_t shellIndex = (ly + 1) * 18 * 18 + (lz + 1) * 18 + (lx + 1);
+				return static_cast<TextureType>(input.shell[shellIndex]);
+			}
+			return AIR; // Default to AIR if not in chunk and not in precomputed shell
+		};
+
+		const int dims[] = {CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE};
+
+		// Iterate over dimensions (X, Y, Z)
+		for (int d = 0; d < 3; ++d)
+		{
+			int u = (d + 1) % 3; // First axis in the plane of the face
+			int v = (d + 2) % 3; // Second axis in the plane of the face
+
+			glm::ivec3 x = {0, 0, 0}; // Current voxel coordinate during slice iteration
+			glm::ivec3 q = {0, 0,
+											0}; // Normal direction for the face (points from x to x+q)
+			q[d] = 1;
+
+			// Ensure mask is large enough for the current slice
+			if (mask.size() < static_cast<size_t>(dims[u] * dims[v]))
+			{
+				mask.resize(dims[u] * dims[v]);
+			}
+
+			// Iterate over each slice of the chunk along dimension 'd'
+			// x[d] ranges from -1 (representing boundary before chunk) to dims[d]-1
+			// (last voxel layer) A face exists between slice x[d] and slice x[d]+1
+			for (x[d] = -1; x[d] < dims[d]; ++x[d])
+			{
+				std::fill(mask.begin(), mask.begin() + (dims[u] * dims[v]), 0); // Reset mask for each slice
+
+				// Iterate over the plane (u, v)
+				for (x[u] = 0; x[u] < dims[u]; ++x[u])
+				{
+					for (x[v] = 0; x[v] < dims[v]; ++x[v])
+					{
+
+						if (mask[x[u] * dims[v] + x[v]])
+						{
+							continue; // Already processed this part of the slice
+						}
+
+						// Get types of voxels on either side of the potential face
+						// Voxel at x is on one side, voxel at x+q is on the other.
+						// Use the new helper function that checks the neighbor shell
+						TextureType type1 = getVoxelDataForMeshing(x[0], x[1], x[2]);
+						TextureType type2 =
+								getVoxelDataForMeshing(x[0] + q[0], x[1] + q[1], x[2] + q[2]);
+
+						TextureType quad_type = AIR;
+						glm::ivec3 quad_normal_dir = {0, 0, 0};
+						glm::ivec3 quad_origin_voxel_coord = {
+								0, 0, 0}; // Min corner of the voxel this quad's face belongs to
+
+						// Only generate faces for voxels that are inside this chunk.
+						// Border/shell voxels are used solely for occlusion checks — the
+						// neighboring chunk is responsible for rendering its own faces.
+						bool type1InChunk = (x[0] >= 0 && x[0] < CHUNK_SIZE &&
+																x[1] >= 0 && x[1] < CHUNK_HEIGHT &&
+																x[2] >= 0 && x[2] < CHUNK_SIZE);
+						glm::ivec3 xq = x + q;
+						bool type2InChunk = (xq[0] >= 0 && xq[0] < CHUNK_SIZE &&
+																xq[1] >= 0 && xq[1] < CHUNK_HEIGHT &&
+																xq[2] >= 0 && xq[2] < CHUNK_SIZE);
+
+						if (type1 != AIR && type1InChunk &&
+								(type2 == AIR ||
+								(TextureManager::isTransparent(type2) && type1 != type2)))
+						{
+							// Face belongs to type1, pointing towards type2
+							quad_type = type1;
+							quad_normal_dir = q;
+							quad_origin_voxel_coord = x;
+						}
+						else if (type2 != AIR && type2InChunk &&
+										(type1 == AIR || (TextureManager::isTransparent(type1) &&
+																			type1 != type2)))
+						{
+							// Face belongs to type2, pointing towards type1
+							quad_type = type2;
+							quad_normal_dir = {-q[0], -q[1], -q[2]};
+							quad_origin_voxel_coord = xq;
+						}
+						else
+						{
+							continue; // No visible face here, or types are the same opaque.
+						}
+
+						if (quad_type == AIR)
+							continue;
+
+						// Check if this block type needs biome color — used to prevent
+						// greedy merging across biome color boundaries
+						bool isBiomeColoredType =
+								(quad_type == GRASS_TOP || quad_type == GRASS_SIDE ||
+								quad_type == OAK_LEAVES);
+
+						// Vertices take the blended color of the column corner they sit
+						// on, so a merged quad is only right where the color is flat: it
+						// may grow along the origin column (i.e. along Y), or over columns
+						// whose four corners all hold the origin column's color. Water uses
+						// a constant color, so it never splits.
+						const auto &colorCorners = (quad_type == OAK_LEAVES) ? input.colors->foliage : input.colors->grass;
+						auto flatColumnColor = [&](const glm::ivec3 &coord) -> int32_t
+						{
+							const int i = coord[2] * BiomeColorField::SIZE + coord[0];
+							const uint16_t color = colorCorners[i];
+							const bool flat = colorCorners[i + 1] == color &&
+																colorCorners[i + BiomeColorField::SIZE] == color &&
+																colorCorners[i + BiomeColorField::SIZE + 1] == color;
+							return flat ? color : -1;
+						};
+						const int32_t originBiomeColor = isBiomeColoredType ? flatColumnColor(quad_origin_voxel_coord) : 0;
+						auto canMergeBiomeColor = [&](const glm::ivec3 &coord)
+						{
+							if (coord[0] == quad_origin_voxel_coord[0] && coord[2] == quad_origin_voxel_coord[2])
+								return true;
+							return originBiomeColor >= 0 && flatColumnColor(coord) == originBiomeColor;
+						};
+
+						// Calculate width (w) of the quad along dimension u
+						int w;
+						for (w = 1; x[u] + w < dims[u]; ++w)
+						{
+							if (mask[(x[u] + w) * dims[v] + x[v]])
+								break;
+
+							glm::ivec3 next_pos_u_slice = x;
+							next_pos_u_slice[u] +=
+									w; // Next voxel in u-direction in current slice
+
+							// Use the new helper function
+							TextureType check_type1 = getVoxelDataForMeshing(
+									next_pos_u_slice[0], next_pos_u_slice[1], next_pos_u_slice[2]);
+							TextureType check_type2 = getVoxelDataForMeshing(
+									next_pos_u_slice[0] + q[0], next_pos_u_slice[1] + q[1],
+									next_pos_u_slice[2] + q[2]);
+
+							if (quad_normal_dir == q)
+							{ // Face is for a block like type1
+								if (check_type1 != quad_type ||
+										!(check_type2 == AIR ||
+											(TextureManager::isTransparent(check_type2) &&
+											check_type1 != check_type2)))
+									break;
+							}
+							else
+							{ // Face is for a block like type2
+								if (check_type2 != quad_type ||
+										!(check_type1 == AIR ||
+											(TextureManager::isTransparent(check_type1) &&
+											check_type2 != check_type1)))
+									break;
+							}
+
+							// Prevent merging across biome color boundaries
+							if (isBiomeColoredType)
+							{
+								glm::ivec3 candidateVoxel = (quad_normal_dir == q)
+																								? next_pos_u_slice
+																								: next_pos_u_slice + q;
+								if (!canMergeBiomeColor(candidateVoxel))
+									break;
+							}
+						}
+
+						// Calculate height (h) of the quad along dimension v
+						int h;
+						bool h_break = false;
+						for (h = 1; x[v] + h < dims[v]; ++h)
+						{
+							for (int k = 0; k < w;
+									++k)
+							{ // Check all cells in the current row of width w
+								if (mask[(x[u] + k) * dims[v] + (x[v] + h)])
+								{
+									h_break = true;
+									break;
+								}
+
+								glm::ivec3 next_pos_v_slice = x;
+								next_pos_v_slice[u] += k;
+								next_pos_v_slice[v] += h;
+
+								// Use the new helper function
+								TextureType check_type1 = getVoxelDataForMeshing(
+										next_pos_v_slice[0], next_pos_v_slice[1],
+										next_pos_v_slice[2]);
+								TextureType check_type2 = getVoxelDataForMeshing(
+										next_pos_v_slice[0] + q[0], next_pos_v_slice[1] + q[1],
+										next_pos_v_slice[2] + q[2]);
+
+								if (quad_normal_dir == q)
+								{
+									if (check_type1 != quad_type ||
+											!(check_type2 == AIR ||
+												(TextureManager::isTransparent(check_type2) &&
+												check_type1 != check_type2)))
+									{
+										h_break = true;
+										break;
+									}
+								}
+								else
+								{
+									if (check_type2 != quad_type ||
+											!(check_type1 == AIR ||
+												(TextureManager::isTransparent(check_type1) &&
+												check_type2 != check_type1)))
+									{
+										h_break = true;
+										break;
+									}
+								}
+
+								// Prevent merging across biome color boundaries
+								if (isBiomeColoredType)
+								{
+									glm::ivec3 candidateVoxel = (quad_normal_dir == q)
+																									? next_pos_v_slice
+																									: next_pos_v_slice + q;
+									if (!canMergeBiomeColor(candidateVoxel))
+									{
+										h_break = true;
+										break;
+									}
+								}
+							}
+							if (h_break)
+								break;
+						}
+
+						// Add quad to mesh
+						glm::vec3
+								s_coord_float; // Min corner of the quad in local chunk grid space
+						s_coord_float[d] = static_cast<float>(
+								x[d] + 1.0f); // Corrected: Face is always at x[d]+1
+						s_coord_float[u] = static_cast<float>(x[u]);
+						s_coord_float[v] = static_cast<float>(x[v]);
+
+						glm::vec3 quad_width_vec = {0, 0, 0};
+						quad_width_vec[u] = static_cast<float>(w);
+						glm::vec3 quad_height_vec = {0, 0, 0};
+						quad_height_vec[v] = static_cast<float>(h);
+
+						glm::vec3 v0_local = s_coord_float;
+						glm::vec3 v1_local = s_coord_float + quad_width_vec;
+						glm::vec3 v2_local = s_coord_float + quad_width_vec + quad_height_vec;
+						glm::vec3 v3_local = s_coord_float + quad_height_vec;
+
+						// Determine if this block type needs biome-specific coloring
+						bool needsBiomeColoring =
+								(quad_type == GRASS_TOP || quad_type == GRASS_SIDE ||
+								quad_type == OAK_LEAVES || quad_type == WATER);
+
+						float texture_idx_val = static_cast<float>(quad_type);
+						if (quad_type == GRASS_SIDE)
+						{
+							if (quad_normal_dir.y > 0.9f)
+								texture_idx_val = static_cast<float>(GRASS_TOP);
+							else if (quad_normal_dir.y < -0.9f)
+								texture_idx_val = static_cast<float>(DIRT);
+							// else remains GRASS_SIDE
+						}
+						else if (quad_type == OAK_LOG)
+						{
+							if (std::abs(quad_normal_dir.y) > 0.9f)
+								texture_idx_val = static_cast<float>(OAK_LOG_TOP);
+							// else remains OAK_LOG
+						}
+
+						glm::vec3 quad_vertices_local[4] = {v0_local, v1_local, v2_local, v3_local};
+
+						int normalIdx = 0;
+						if (quad_normal_dir.x > 0)
+							normalIdx = 0;
+						else if (quad_normal_dir.x < 0)
+							normalIdx = 1;
+						else if (quad_normal_dir.y > 0)
+							normalIdx = 2;
+						else if (quad_normal_dir.y < 0)
+							normalIdx = 3;
+						else if (quad_normal_dir.z > 0)
+							normalIdx = 4;
+						else if (quad_normal_dir.z < 0)
+							normalIdx = 5;
+
+
+						// Grass and leaves read their color per vertex, below
+						const uint16_t packedColor = (quad_type == WATER) ? WATER_COLOR : 0;
+
+						auto calculateAO = [&](const glm::vec3 &localPos, int cornerIdx) -> uint32_t
+						{
+							int pd = (int)std::round(localPos[d]);
+							int pu = (int)std::round(localPos[u]);
+							int pv = (int)std::round(localPos[v]);
+
+							int layerD = (quad_normal_dir[d] > 0) ? pd : pd - 1;
+
+							// Baseline lookup: both face axes move by du, so samples lie on the
+							// diagonal (ChunkMesher's cornerAO keeps the same result)
+							auto isSolid = [&](int du, [[maybe_unused]] int dv)
+							{
+								return !TextureManager::isTransparent(getVoxelDataForMeshing(
+										(d == 0 ? layerD : (u == 0 ? pu + du : pv + du)),
+										(d == 1 ? layerD : (u == 1 ? pu + du : pv + du)),
+										(d == 2 ? layerD : (u == 2 ? pu + du : pv + du))));
+							};
+
+							bool q1 = isSolid(0, 0);
+							bool q2 = isSolid(-1, 0);
+							bool q3 = isSolid(-1, -1);
+							bool q4 = isSolid(0, -1);
+
+							bool s1, s2, c;
+							if (cornerIdx == 0)
+							{
+								s1 = q2;
+								s2 = q4;
+								c = q3;
+							}
+							else if (cornerIdx == 1)
+							{
+								s1 = q1;
+								s2 = q3;
+								c = q4;
+							}
+							else if (cornerIdx == 2)
+							{
+								s1 = q2;
+								s2 = q4;
+								c = q1;
+							}
+							else
+							{
+								s1 = q1;
+								s2 = q3;
+								c = q2;
+							}
+
+							if (s1 && s2)
+								return 0;
+							return 3 - (s1 + s2 + c);
+						};
+
+						// Determine which mesh buffer this quad goes to
+						bool isWater = (quad_type == WATER);
+						auto &targetQuads = isWater ? waterQuads : quads;
+
+						uint32_t ao[4];
+						uint16_t cornerColors[4];
+						for (int i = 0; i < 4; ++i)
+						{
+							const glm::vec3 &localPos = quad_vertices_local[i];
+							ao[i] = calculateAO(localPos, i);
+
+							const int cornerX = static_cast<int>(std::round(localPos.x));
+							const int cornerZ = static_cast<int>(std::round(localPos.z));
+							cornerColors[i] = packedColor;
+							if (isBiomeColoredType)
+							{
+								const int corner = cornerZ * BiomeColorField::SIZE + cornerX;
+								cornerColors[i] = (quad_type == OAK_LEAVES) ? input.colors->foliage[corner] : input.colors->grass[corner];
+							}
+						}
+						// Quads are drawn through a shared index pattern: no winding to emit
+						targetQuads.push_back(ChunkQuad::pack(glm::ivec3(v0_local), normalIdx, ao, w, h,
+															  static_cast<uint32_t>(texture_idx_val), needsBiomeColoring, cornerColors));
+
+						// Mark processed cells in the mask
+						for (int iw = 0; iw < w; ++iw)
+						{
+							for (int ih = 0; ih < h; ++ih)
+							{
+								mask[(x[u] + iw) * dims[v] + (x[v] + ih)] = 1;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	template <typename Mesher>
+	RunResult run(const BenchConfig &cfg, const std::vector<ChunkData> &chunks,
+				  const std::vector<ChunkSections> &sections, Mesher &&mesher)
+	{
+		RunResult result;
+		result.perChunkUs.reserve(chunks.size() * cfg.repeat);
+		MeshBuffers buffers;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < cfg.repeat; ++r)
+		{
+			for (size_t i = 0; i < chunks.size(); ++i)
+			{
+				const ChunkData &chunk = chunks[i];
+				ChunkMeshInput input{};
+				input.sections = &sections[i];
+				input.shell = chunk.borderVoxels.data();
+				input.colors = &chunk.colors;
+
+				auto t0 = std::chrono::steady_clock::now();
+				mesher(input, buffers.quads, buffers.waterQuads);
+				auto t1 = std::chrono::steady_clock::now();
+
+				result.perChunkUs.push_back(std::chrono::duration<float, std::micro>(t1 - t0).count());
+				if (r == 0)
+					result.quads += buffers.quads.size() + buffers.waterQuads.size();
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		result.wallSeconds = std::chrono::duration<double>(end - start).count();
+		return result;
+	}
+
+	/// What Chunk::generateMesh() does after one edit: the sections an edit at
+	/// the top of the chunk's middle column touches
+	void editMesh(const ChunkMeshInput &input, std::vector<ChunkQuad> &quads, std::vector<ChunkQuad> &waterQuads)
+	{
+		static SectionMeshes sections;
+		int y = CHUNK_HEIGHT - 1;
+		while (y > 0 && (*input.sections)[y / SECTION_SIZE].get(8, y % SECTION_SIZE, 8) == AIR)
+			--y;
+		const uint32_t touched = sectionsTouchedBy(y);
+		buildSectionMeshes(input, touched, sections);
+
+		quads.clear();
+		waterQuads.clear();
+		for (int s = 0; s < SECTION_COUNT; ++s)
+		{
+			if (!(touched >> s & 1))
+				continue;
+			quads.insert(quads.end(), sections[s].quads.begin(), sections[s].quads.end());
+			waterQuads.insert(waterQuads.end(), sections[s].waterQuads.begin(), sections[s].waterQuads.end());
+		}
+	}
+
+	float percentile(std::vector<float> values, float p)
+	{
+		if (values.empty())
+			return 0.0f;
+		std::sort(values.begin(), values.end());
+		size_t idx = static_cast<size_t>(p * static_cast<float>(values.size() - 1) + 0.5f);
+		return values[std::min(idx, values.size() - 1)];
+	}
+
+	void report(const char *label, const RunResult &run, size_t chunkCount)
+	{
+		double sum = 0.0;
+		for (float us : run.perChunkUs)
+			sum += us;
+		const double mean = run.perChunkUs.empty() ? 0.0 : sum / run.perChunkUs.size();
+
+		std::cout << "[BENCH] " << std::left << std::setw(6) << label << std::right << std::fixed
+				  << std::setprecision(1)
+				  << " p50 " << std::setw(8) << percentile(run.perChunkUs, 0.50f) << " us"
+				  << "  p99 " << std::setw(8) << percentile(run.perChunkUs, 0.99f) << " us"
+				  << "  mean " << std::setw(8) << mean << " us"
+				  << "  " << std::setw(9) << (run.wallSeconds > 0.0 ? run.perChunkUs.size() / run.wallSeconds : 0.0)
+				  << " chunks/s"
+				  << "  " << std::setw(6) << (chunkCount ? static_cast<double>(run.quads) / chunkCount : 0.0)
+				  << " quads/chunk\n";
+	}
+}
+
+int main(int argc, char **argv)
+{
+	BenchConfig cfg;
+	if (!parseArgs(argc, argv, cfg))
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	TerrainGenerator &generator = TerrainGenerator::getThreadLocal(cfg.seed);
+	std::vector<ChunkData> chunks;
+	for (int dz = -cfg.radius; dz <= cfg.radius; ++dz)
+		for (int dx = -cfg.radius; dx <= cfg.radius; ++dx)
+			chunks.push_back(generator.generateChunk((cfg.originX + dx) * CHUNK_SIZE, (cfg.originZ + dz) * CHUNK_SIZE));
+
+	std::cout << "[BENCH] seed " << cfg.seed << ", " << (2 * cfg.radius + 1) << "x" << (2 * cfg.radius + 1)
+			  << " chunks around (" << cfg.originX << ", " << cfg.originZ << "), repeat " << cfg.repeat << '\n';
+
+	std::vector<ChunkSections> sections(chunks.size());
+	size_t kinds[3] = {0, 0, 0};
+	size_t bytes = 0;
+	for (size_t i = 0; i < chunks.size(); ++i)
+	{
+		assignSections(sections[i], chunks[i].voxels.data());
+		for (const ChunkSection &section : sections[i])
+		{
+			++kinds[static_cast<int>(section.kind())];
+			bytes += sizeof(ChunkSection) + section.storageBytes();
+		}
+	}
+	std::cout << "[BENCH] sections: " << kinds[0] << " empty, " << kinds[1] << " uniform, " << kinds[2]
+			  << " mixed; " << bytes / chunks.size() / 1024 << " KiB of voxels per chunk (flat: "
+			  << CHUNK_VOLUME * sizeof(Voxel) / 1024 << " KiB)\n";
+
+	// Warm-up: thread-local workspaces and the output buffers' capacity
+	BenchConfig once = cfg;
+	once.repeat = 1;
+	run(once, chunks, sections, buildChunkMesh);
+	run(once, chunks, sections, sliceMesh);
+	run(once, chunks, sections, editMesh);
+
+	const RunResult slice = run(cfg, chunks, sections, sliceMesh);
+	const RunResult binary = run(cfg, chunks, sections, buildChunkMesh);
+	const RunResult edit = run(cfg, chunks, sections, editMesh);
+	report("slice", slice, chunks.size());
+	report("binary", binary, chunks.size());
+	report("edit", edit, chunks.size());
+
+	const double speedup = binary.wallSeconds > 0.0 ? slice.wallSeconds / binary.wallSeconds : 0.0;
+	std::cout << "[BENCH] binary mesher: " << std::setprecision(1) << speedup << "x the slice mesher's throughput\n";
+	const double editSpeedup = edit.wallSeconds > 0.0 ? binary.wallSeconds / edit.wallSeconds : 0.0;
+	std::cout << "[BENCH] edit re-mesh: " << std::setprecision(1) << editSpeedup << "x faster than meshing the whole chunk\n";
+	return 0;
+}
@@ -0,0 +1,405 @@
+// Headless benchmark for TerrainGenerator::generateChunk.
+//
+// Generates a fixed square grid of chunks for a fixed seed, first on a single
+// thread and then spread across N worker threads (each one going through
+// TerrainGenerator::getThreadLocal like the ChunkManager jobs do), and reports
+// per-chunk latency percentiles and throughput for every generation phase.
+//
+// Usage: bench_terrain [--seed N] [--radius R] [--origin X Z] [--threads T] [--repeat K] [--region N]
+//                      [--coarse LAYERS]
+//   --radius R   grid of (2R+1)^2 chunks around the origin chunk (default 8)
+//   --origin X Z origin in chunk coordinates (default 0 0)
+//   --threads T  worker count for the multi-threaded run (default: hardware concurrency)
+//   --repeat K   how many times every chunk of the grid is generated (default 1)
+//   --region N   also time generateRegion() with N x N regions covering the grid
+//                (default 4, 0 to skip)
+//   --coarse L   comma-separated 3D layers to sample with NoiseSampling::Coarse
+//                (cave, ravine, surface or all), then report how many voxels
+//                differ from full-resolution sampling over the grid
+
+#include <Chunk/TerrainGenerator.hpp>
+#include <Chunk/ColumnNoiseCache.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct BenchConfig
+	{
+		int seed = 1337;
+		int radius = 8;
+		int originX = 0;
+		int originZ = 0;
+		int threads = 0;
+		int repeat = 1;
+		int region = TerrainGenerator::MAX_REGION_CHUNKS;
+		std::array<TerrainGenerator::NoiseSampling, TerrainGenerator::NOISE_3D_LAYER_COUNT> sampling{};
+
+		bool anyCoarse() const
+		{
+			return std::find(sampling.begin(), sampling.end(), TerrainGenerator::NoiseSampling::Coarse) != sampling.end();
+		}
+	};
+
+	struct ChunkSample
+	{
+		ChunkGenTimings phases;
+		float totalMs;
+	};
+
+	struct RunResult
+	{
+		std::vector<ChunkSample> samples;
+		double wallSeconds = 0.0;
+	};
+
+	void printUsage(const char *argv0)
+	{
+		std::cout << "Usage: " << argv0
+				  << " [--seed N] [--radius R] [--origin X Z] [--threads T] [--repeat K] [--region N]"
+				  << " [--coarse cave,ravine,surface|all]\n";
+	}
+
+	bool parseLayers(const char *list, BenchConfig &cfg)
+	{
+		std::string layers(list);
+		size_t begin = 0;
+		while (begin <= layers.size())
+		{
+			size_t end = std::min(layers.find(',', begin), layers.size());
+			std::string name = layers.substr(begin, end - begin);
+			if (name == "cave")
+				cfg.sampling[TerrainGenerator::NOISE_3D_CAVE] = TerrainGenerator::NoiseSampling::Coarse;
+			else if (name == "ravine")
+				cfg.sampling[TerrainGenerator::NOISE_3D_RAVINE] = TerrainGenerator::NoiseSampling::Coarse;
+			else if (name == "surface")
+				cfg.sampling[TerrainGenerator::NOISE_3D_SURFACE] = TerrainGenerator::NoiseSampling::Coarse;
+			else if (name == "all")
+				cfg.sampling.fill(TerrainGenerator::NoiseSampling::Coarse);
+			else
+				return false;
+			begin = end + 1;
+		}
+		return true;
+	}
+
+	bool parseArgs(int argc, char **argv, BenchConfig &cfg)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			auto next = [&](int &out) -> bool
+			{
+				if (i + 1 >= argc)
+					return false;
+				out = std::atoi(argv[++i]);
+				return true;
+			};
+
+			if (std::strcmp(argv[i], "--seed") == 0)
+			{
+				if (!next(cfg.seed))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--radius") == 0)
+			{
+				if (!next(cfg.radius))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--origin") == 0)
+			{
+				if (!next(cfg.originX) || !next(cfg.originZ))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--threads") == 0)
+			{
+				if (!next(cfg.threads))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--repeat") == 0)
+			{
+				if (!next(cfg.repeat))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--region") == 0)
+			{
+				if (!next(cfg.region))
+					return false;
+			}
+			else if (std::strcmp(argv[i], "--coarse") == 0)
+			{
+				if (i + 1 >= argc || !parseLayers(argv[++i], cfg))
+					return false;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		cfg.radius = std::max(cfg.radius, 0);
+		cfg.repeat = std::max(cfg.repeat, 1);
+		cfg.region = std::clamp(cfg.region, 0, TerrainGenerator::MAX_REGION_CHUNKS);
+		if (cfg.threads <= 0)
+			cfg.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+		return true;
+	}
+
+	// Chunk origins in world block coordinates, as passed by Chunk::generateTerrain.
+	std::vector<glm::ivec2> buildGrid(const BenchConfig &cfg)
+	{
+		std::vector<glm::ivec2> grid;
+		grid.reserve(static_cast<size_t>(2 * cfg.radius + 1) * (2 * cfg.radius + 1) * cfg.repeat);
+		for (int r = 0; r < cfg.repeat; ++r)
+			for (int dz = -cfg.radius; dz <= cfg.radius; ++dz)
+				for (int dx = -cfg.radius; dx <= cfg.radius; ++dx)
+					grid.emplace_back((cfg.originX + dx) * CHUNK_SIZE, (cfg.originZ + dz) * CHUNK_SIZE);
+		return grid;
+	}
+
+	TerrainGenerator &configuredGenerator(const BenchConfig &cfg)
+	{
+		TerrainGenerator &generator = TerrainGenerator::getThreadLocal(cfg.seed);
+		for (int layer = 0; layer < TerrainGenerator::NOISE_3D_LAYER_COUNT; ++layer)
+			generator.setNoiseSampling(static_cast<TerrainGenerator::Noise3DLayer>(layer), cfg.sampling[layer]);
+		return generator;
+	}
+
+	ChunkSample generateTimed(TerrainGenerator &generator, const glm::ivec2 &pos)
+	{
+		ChunkSample sample{};
+		ChunkData data = generator.generateChunk(pos.x, pos.y, &sample.phases);
+		sample.totalMs = sample.phases.batchMs + sample.phases.vegetationMs + sample.phases.bordersMs;
+
+		// Keep the result observable so the call cannot be optimised away.
+		static std::atomic<uint32_t> sink{0};
+		sink.fetch_add(data.voxels[CHUNK_SIZE * CHUNK_SIZE * 64].type, std::memory_order_relaxed);
+		return sample;
+	}
+
+	RunResult runSingleThreaded(const BenchConfig &cfg, const std::vector<glm::ivec2> &grid)
+	{
+		RunResult result;
+		result.samples.reserve(grid.size());
+		TerrainGenerator &generator = configuredGenerator(cfg);
+
+		auto start = std::chrono::steady_clock::now();
+		for (const glm::ivec2 &pos : grid)
+			result.samples.push_back(generateTimed(generator, pos));
+		auto end = std::chrono::steady_clock::now();
+
+		result.wallSeconds = std::chrono::duration<double>(end - start).count();
+		return result;
+	}
+
+	RunResult runMultiThreaded(const BenchConfig &cfg, const std::vector<glm::ivec2> &grid)
+	{
+		RunResult result;
+		result.samples.resize(grid.size());
+		std::atomic<size_t> nextIndex{0};
+
+		auto worker = [&]()
+		{
+			TerrainGenerator &generator = configuredGenerator(cfg);
+			for (size_t i = nextIndex.fetch_add(1); i < grid.size(); i = nextIndex.fetch_add(1))
+				result.samples[i] = generateTimed(generator, grid[i]);
+		};
+
+		auto start = std::chrono::steady_clock::now();
+		std::vector<std::thread> threads;
+		threads.reserve(cfg.threads);
+		for (int t = 0; t < cfg.threads; ++t)
+			threads.emplace_back(worker);
+		for (std::thread &thread : threads)
+			thread.join();
+		auto end = std::chrono::steady_clock::now();
+
+		result.wallSeconds = std::chrono::duration<double>(end - start).count();
+		return result;
+	}
+
+	float percentile(std::vector<float> values, float p)
+	{
+		if (values.empty())
+			return 0.0f;
+		std::sort(values.begin(), values.end());
+		size_t idx = static_cast<size_t>(p * static_cast<float>(values.size() - 1) + 0.5f);
+		return values[std::min(idx, values.size() - 1)];
+	}
+
+	void printPhase(const char *name, const std::vector<float> &values, double threadCount)
+	{
+		double sum = 0.0;
+		for (float v : values)
+			sum += v;
+		double mean = values.empty() ? 0.0 : sum / values.size();
+		// Per-phase throughput: how many chunks/s this phase alone could sustain
+		// with the same number of workers.
+		double chunksPerSec = sum > 0.0 ? values.size() * threadCount / (sum / 1000.0) : 0.0;
+
+		std::cout << "  " << std::left << std::setw(12) << name << std::right
+				  << std::fixed << std::setprecision(3)
+				  << " p50 " << std::setw(8) << percentile(values, 0.50f) << " ms"
+				  << "  p99 " << std::setw(8) << percentile(values, 0.99f) << " ms"
+				  << "  mean " << std::setw(8) << mean << " ms"
+				  << std::setprecision(1)
+				  << "  " << std::setw(9) << chunksPerSec << " chunks/s\n";
+	}
+
+	void report(const char *label, int threads, const RunResult &run, uint64_t cacheHits, uint64_t cacheMisses)
+	{
+		std::vector<float> batch, vegetation, borders, total;
+		batch.reserve(run.samples.size());
+		vegetation.reserve(run.samples.size());
+		borders.reserve(run.samples.size());
+		total.reserve(run.samples.size());
+		for (const ChunkSample &s : run.samples)
+		{
+			batch.push_back(s.phases.batchMs);
+			vegetation.push_back(s.phases.vegetationMs);
+			borders.push_back(s.phases.bordersMs);
+			total.push_back(s.totalMs);
+		}
+
+		double overall = run.wallSeconds > 0.0 ? run.samples.size() / run.wallSeconds : 0.0;
+		std::cout << "[BENCH] " << label << " (" << threads << " thread" << (threads > 1 ? "s" : "") << "): "
+				  << run.samples.size() << " chunks in " << std::fixed << std::setprecision(3)
+				  << run.wallSeconds << " s, " << std::setprecision(1) << overall << " chunks/s\n";
+		printPhase("batch", batch, threads);
+		printPhase("vegetation", vegetation, threads);
+		printPhase("borders", borders, threads);
+		printPhase("total", total, threads);
+
+		// Reference: cave + ravine + surface3D over the full 16x256x16 body and
+		// the 66 border columns, as sampled before the per-column slab.
+		constexpr double fullSamples = 3.0 * (CHUNK_VOLUME + 66.0 * CHUNK_HEIGHT);
+		double samples = 0.0;
+		for (const ChunkSample &s : run.samples)
+			samples += static_cast<double>(s.phases.noise3DSamples);
+		samples = run.samples.empty() ? 0.0 : samples / run.samples.size();
+		std::cout << "  3D noise samples: " << std::setprecision(0) << samples << " per chunk ("
+				  << std::setprecision(1) << 100.0 * samples / fullSamples << "% of full volume)\n";
+
+		uint64_t lookups = cacheHits + cacheMisses;
+		std::cout << "  column noise cache: " << cacheHits << "/" << lookups << " border strips hit ("
+				  << std::setprecision(1) << (lookups ? 100.0 * cacheHits / lookups : 0.0) << "%)\n";
+	}
+
+	// Region-batched generation over the same area, rounded up to whole regions.
+	// Phases are not split here: one sample is the cost of a region divided by
+	// its chunk count.
+	void runRegions(const BenchConfig &cfg)
+	{
+		const int n = cfg.region;
+		const int side = 2 * cfg.radius + 1;
+		const int regionsPerSide = (side + n - 1) / n;
+		TerrainGenerator &generator = configuredGenerator(cfg);
+
+		std::vector<float> perChunkMs;
+		size_t chunkCount = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < cfg.repeat; ++r)
+		{
+			for (int rz = 0; rz < regionsPerSide; ++rz)
+			{
+				for (int rx = 0; rx < regionsPerSide; ++rx)
+				{
+					int regionX = (cfg.originX - cfg.radius + rx * n) * CHUNK_SIZE;
+					int regionZ = (cfg.originZ - cfg.radius + rz * n) * CHUNK_SIZE;
+
+					auto t0 = std::chrono::steady_clock::now();
+					std::vector<ChunkData> chunks = generator.generateRegion(regionX, regionZ, n);
+					auto t1 = std::chrono::steady_clock::now();
+
+					perChunkMs.push_back(std::chrono::duration<float, std::milli>(t1 - t0).count() / chunks.size());
+					chunkCount += chunks.size();
+				}
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+		double wallSeconds = std::chrono::duration<double>(end - start).count();
+
+		std::cout << "[BENCH] region " << n << "x" << n << " (1 thread): " << chunkCount << " chunks in "
+				  << std::fixed << std::setprecision(3) << wallSeconds << " s, " << std::setprecision(1)
+				  << (wallSeconds > 0.0 ? chunkCount / wallSeconds : 0.0) << " chunks/s\n";
+		printPhase("per chunk", perChunkMs, 1);
+	}
+
+	// Quality of the coarse layers: voxels whose type differs from a
+	// full-resolution generator over one pass of the grid.
+	void compareWithFull(const BenchConfig &cfg)
+	{
+		TerrainGenerator &coarse = configuredGenerator(cfg);
+		TerrainGenerator full(cfg.seed);
+
+		uint64_t differing = 0;
+		uint64_t total = 0;
+		for (int dz = -cfg.radius; dz <= cfg.radius; ++dz)
+		{
+			for (int dx = -cfg.radius; dx <= cfg.radius; ++dx)
+			{
+				int chunkX = (cfg.originX + dx) * CHUNK_SIZE;
+				int chunkZ = (cfg.originZ + dz) * CHUNK_SIZE;
+				ChunkData a = coarse.generateChunk(chunkX, chunkZ);
+				ChunkData b = full.generateChunk(chunkX, chunkZ);
+				for (size_t i = 0; i < a.voxels.size(); ++i)
+					differing += a.voxels[i].type != b.voxels[i].type;
+				total += a.voxels.size();
+			}
+		}
+
+		std::cout << "[BENCH] coarse vs full: " << differing << "/" << total << " voxels differ ("
+				  << std::fixed << std::setprecision(3) << (total ? 100.0 * differing / total : 0.0) << "%)\n";
+	}
+
+	template <typename Run>
+	void runAndReport(const char *label, int threads, Run &&run)
+	{
+		// The cache is process-wide: start each run cold so runs are comparable.
+		ColumnNoiseCache &cache = ColumnNoiseCache::instance();
+		cache.clear();
+		uint64_t hitsBefore = cache.hits();
+		uint64_t missesBefore = cache.misses();
+		RunResult result = run();
+		report(label, threads, result, cache.hits() - hitsBefore, cache.misses() - missesBefore);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	BenchConfig cfg;
+	if (!parseArgs(argc, argv, cfg))
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	std::vector<glm::ivec2> grid = buildGrid(cfg);
+	std::cout << "[BENCH] seed " << cfg.seed << ", " << (2 * cfg.radius + 1) << "x" << (2 * cfg.radius + 1)
+			  << " chunks around (" << cfg.originX << ", " << cfg.originZ << "), repeat " << cfg.repeat << '\n';
+
+	// Warm-up: builds the thread-local generator and scratch buffers so the
+	// first measured chunk does not pay for node graph setup.
+	configuredGenerator(cfg).generateChunk(cfg.originX * CHUNK_SIZE, cfg.originZ * CHUNK_SIZE);
+
+	runAndReport("single-threaded", 1, [&]
+				 { return runSingleThreaded(cfg, grid); });
+	if (cfg.threads > 1)
+		runAndReport("multi-threaded", cfg.threads, [&]
+					 { return runMultiThreaded(cfg, grid); });
+	if (cfg.region > 0)
+		runRegions(cfg);
+	if (cfg.anyCoarse())
+		compareWithFull(cfg);
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+// Free-list sub-allocator checks (the bookkeeping behind MeshArena).
+//
+// 1. Basics: best fit, exhaustion, merging of freed neighbours, growth.
+// 2. Random: thousands of allocations and frees against an occupancy map:
+//    blocks never overlap or leave the arena, the used count matches, and
+//    freeing everything leaves one block the size of the arena.
+
+#include <Chunk/ArenaAllocator.hpp>
+#include "TestSuite.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr uint32_t RANDOM_CAPACITY = 1u << 16;
+	constexpr int RANDOM_STEPS = 200000;
+
+	struct Block
+	{
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	bool testBasics()
+	{
+		bool ok = true;
+		ArenaAllocator arena(100);
+		ok &= expect(arena.allocate(0) == ArenaAllocator::INVALID, "empty allocation succeeds");
+		ok &= expect(arena.allocate(101) == ArenaAllocator::INVALID, "allocation larger than the arena succeeds");
+
+		const uint32_t a = arena.allocate(10);
+		const uint32_t b = arena.allocate(20);
+		const uint32_t c = arena.allocate(30);
+		ok &= expect(a == 0 && b == 10 && c == 30, "first allocations are not packed from offset 0");
+		ok &= expect(arena.used() == 60 && arena.largestFreeBlock() == 40, "used or free space is wrong");
+
+		arena.free(a, 10);
+		arena.free(c, 30);
+		ok &= expect(arena.freeBlockCount() == 2, "a block freed next to the end did not merge with it");
+		arena.free(b, 20);
+		ok &= expect(arena.freeBlockCount() == 1 && arena.largestFreeBlock() == 100, "freed neighbours did not merge");
+
+		// Free blocks [0, 10) and [40, 100): best fit puts 8 units in the small one
+		const uint32_t d = arena.allocate(10);
+		const uint32_t e = arena.allocate(30);
+		const uint32_t f = arena.allocate(10);
+		arena.free(d, 10);
+		arena.free(f, 10);
+		ok &= expect(e == 10 && arena.allocate(8) == d, "best fit did not take the smallest block that fits");
+		ok &= expect(arena.allocate(61) == ArenaAllocator::INVALID, "allocation larger than any free block succeeds");
+
+		// Growth extends the free block at the end
+		arena.grow(150);
+		ok &= expect(arena.capacity() == 150, "grow() did not change the capacity");
+		ok &= expect(arena.allocate(110) == 40, "grown space did not merge with the free end of the arena");
+		ok &= expect(arena.used() == 8 + 30 + 110 && arena.largestFreeBlock() == 2, "used count is wrong after growth");
+		return ok;
+	}
+
+	bool testRandom()
+	{
+		std::mt19937 rng(1337);
+		ArenaAllocator arena(RANDOM_CAPACITY);
+		std::vector<uint8_t> owned(RANDOM_CAPACITY, 0);
+		std::vector<Block> live;
+		uint64_t used = 0;
+		long failures = 0;
+		long errors = 0;
+
+		for (int step = 0; step < RANDOM_STEPS && errors == 0; ++step)
+		{
+			const bool allocate = live.empty() || rng() % 100 < 55;
+			if (allocate)
+			{
+				// Mostly small meshes, now and then a large one
+				const uint32_t size = (rng() % 16 == 0) ? 1 + rng() % 4096 : 1 + rng() % 256;
+				const uint32_t offset = arena.allocate(size);
+				if (offset == ArenaAllocator::INVALID)
+				{
+					++failures;
+					continue;
+				}
+				if (offset + size > RANDOM_CAPACITY)
+				{
+					++errors;
+					std::cerr << "[TEST] block [" << offset << ", " << offset + size << ") leaves the arena\n";
+					continue;
+				}
+				for (uint32_t i = offset; i < offset + size; ++i)
+				{
+					if (owned[i])
+					{
+						++errors;
+						std::cerr << "[TEST] unit " << i << " handed out twice\n";
+						break;
+					}
+					owned[i] = 1;
+				}
+				live.push_back({offset, size});
+				used += size;
+			}
+			else
+			{
+				const size_t pick = rng() % live.size();
+				const Block block = live[pick];
+				live[pick] = live.back();
+				live.pop_back();
+				arena.free(block.offset, block.size);
+				for (uint32_t i = block.offset; i < block.offset + block.size; ++i)
+					owned[i] = 0;
+				used -= block.size;
+			}
+			if (arena.used() != used)
+			{
+				++errors;
+				std::cerr << "[TEST] used() says " << arena.used() << ", " << used << " are allocated\n";
+			}
+		}
+
+		for (const Block &block : live)
+			arena.free(block.offset, block.size);
+		std::cout << "[TEST] Random: " << RANDOM_STEPS << " steps, " << failures << " allocations did not fit, "
+				  << errors << " errors\n";
+		bool ok = expect(errors == 0, "the allocator handed out overlapping or out-of-range blocks");
+		ok &= expect(arena.used() == 0 && arena.freeBlockCount() == 1 && arena.largestFreeBlock() == RANDOM_CAPACITY,
+					 "freeing every block did not restore one free block");
+		return ok;
+	}
+}
+
+int main()
+{
+	return runChecks("Arena allocator", {testBasics, testRandom});
+}
@@ -0,0 +1,163 @@
+// Blended biome colour checks.
+//
+// 1. Seams: corners on a chunk edge hold the same colour in both chunks.
+// 2. Regions: generateRegion() samples its shared grid to exactly what each
+//    chunk gets on its own.
+// 3. Blend: neighbouring corners never differ by more than the box blur
+//    allows, although the per-biome colours themselves change abruptly.
+
+#include <Chunk/TerrainGenerator.hpp>
+#include "TestSuite.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr int GRID = 32;		 // GRID x GRID chunks
+	constexpr int FIRST_CHUNK = -16; // Chunk coordinate of the first row and column
+	constexpr int REGION_CHUNKS = 2;
+
+	constexpr int SIZE = BiomeColorField::SIZE;
+
+	int channel(uint32_t rgba, int c)
+	{
+		return static_cast<int>((rgba >> (8 * c)) & 0xFF);
+	}
+
+	bool testSeams(const std::vector<SurfaceData> &surfaces)
+	{
+		int mismatches = 0;
+		for (int cz = 0; cz < GRID; ++cz)
+		{
+			for (int cx = 0; cx < GRID; ++cx)
+			{
+				const BiomeColorField &colors = surfaces[cz * GRID + cx].colors;
+				for (int i = 0; i < SIZE; ++i)
+				{
+					if (cx + 1 < GRID)
+					{
+						const BiomeColorField &right = surfaces[cz * GRID + cx + 1].colors;
+						mismatches += colors.grass[i * SIZE + SIZE - 1] != right.grass[i * SIZE];
+						mismatches += colors.foliage[i * SIZE + SIZE - 1] != right.foliage[i * SIZE];
+					}
+					if (cz + 1 < GRID)
+					{
+						const BiomeColorField &below = surfaces[(cz + 1) * GRID + cx].colors;
+						mismatches += colors.grass[(SIZE - 1) * SIZE + i] != below.grass[i];
+						mismatches += colors.foliage[(SIZE - 1) * SIZE + i] != below.foliage[i];
+					}
+				}
+			}
+		}
+
+		std::cout << "[TEST] Seams: " << mismatches << " edge corners differ between neighbours\n";
+		return expect(mismatches == 0, "the colour field is not continuous across chunks");
+	}
+
+	bool testRegion(TerrainGenerator &generator, const std::vector<SurfaceData> &surfaces)
+	{
+		const int regionX = FIRST_CHUNK * CHUNK_SIZE;
+		const int regionZ = FIRST_CHUNK * CHUNK_SIZE;
+		const std::vector<ChunkData> region = generator.generateRegion(regionX, regionZ, REGION_CHUNKS, false);
+
+		int mismatches = 0;
+		for (int cz = 0; cz < REGION_CHUNKS; ++cz)
+			for (int cx = 0; cx < REGION_CHUNKS; ++cx)
+				mismatches += region[cz * REGION_CHUNKS + cx].colors != surfaces[cz * GRID + cx].colors;
+
+		std::cout << "[TEST] Region: " << mismatches << " of " << REGION_CHUNKS * REGION_CHUNKS
+				  << " chunks differ from their own generation\n";
+		return expect(mismatches == 0, "the region grid does not match per-chunk colours");
+	}
+
+	bool testBlend(const std::vector<SurfaceData> &surfaces)
+	{
+		// Largest jump between two biome colours, and the largest step the blur
+		// lets through: the jump spread over the box width, plus one RGB565 step
+		int paletteJump = 0;
+		for (int a = 0; a < BIOME_COUNT; ++a)
+		{
+			for (int b = 0; b < BIOME_COUNT; ++b)
+			{
+				const BiomeConfig &ca = TerrainGenerator::getBiomeConfig(static_cast<BiomeType>(a));
+				const BiomeConfig &cb = TerrainGenerator::getBiomeConfig(static_cast<BiomeType>(b));
+				for (int c = 0; c < 3; ++c)
+				{
+					paletteJump = std::max(paletteJump, static_cast<int>(std::lround(std::abs(ca.grassColor[c] - cb.grassColor[c]) * 255.0f)));
+					paletteJump = std::max(paletteJump, static_cast<int>(std::lround(std::abs(ca.foliageColor[c] - cb.foliageColor[c]) * 255.0f)));
+				}
+			}
+		}
+		const int boxWidth = (2 * BiomeColorGrid::BLUR_RADIUS + 1) * BiomeAtlas::CELL_SIZE;
+		const int allowedStep = (paletteJump + boxWidth - 1) / boxWidth + 9;
+
+		int maxStep = 0;
+		long blended = 0; // Corners whose grass colour is no biome's own colour
+		for (const SurfaceData &surface : surfaces)
+		{
+			const BiomeColorField &colors = surface.colors;
+			for (int z = 0; z < SIZE; ++z)
+			{
+				for (int x = 0; x < SIZE; ++x)
+				{
+					const uint32_t grass = colors.grassAt(x, z);
+					bool pure = false;
+					for (int b = 0; b < BIOME_COUNT && !pure; ++b)
+					{
+						const glm::vec3 &g = TerrainGenerator::getBiomeConfig(static_cast<BiomeType>(b)).grassColor;
+						pure = BiomeColorField::toRGBA8(BiomeColorField::fromRGB(g.r, g.g, g.b)) == grass;
+					}
+					blended += !pure;
+
+					for (int c = 0; c < 3; ++c)
+					{
+						if (x + 1 < SIZE)
+						{
+							maxStep = std::max(maxStep, std::abs(channel(grass, c) - channel(colors.grassAt(x + 1, z), c)));
+							maxStep = std::max(maxStep, std::abs(channel(colors.foliageAt(x, z), c) - channel(colors.foliageAt(x + 1, z), c)));
+						}
+						if (z + 1 < SIZE)
+						{
+							maxStep = std::max(maxStep, std::abs(channel(grass, c) - channel(colors.grassAt(x, z + 1), c)));
+							maxStep = std::max(maxStep, std::abs(channel(colors.foliageAt(x, z), c) - channel(colors.foliageAt(x, z + 1), c)));
+						}
+					}
+				}
+			}
+		}
+
+		std::cout << "[TEST] Blend: " << blended << " blended corners, largest step " << maxStep
+				  << " (allowed " << allowedStep << ", hard edges up to " << paletteJump << ")\n";
+		bool ok = true;
+		if (blended == 0)
+		{
+			std::cerr << "[TEST] FAILED: no biome border in the sampled area\n";
+			ok = false;
+		}
+		if (maxStep > allowedStep)
+		{
+			std::cerr << "[TEST] FAILED: colours change faster than the blur allows\n";
+			ok = false;
+		}
+		return ok;
+	}
+}
+
+int main()
+{
+	TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+
+	// One chunk at a time: each one blurs its own window of atlas cells
+	std::vector<SurfaceData> surfaces;
+	surfaces.reserve(GRID * GRID);
+	for (int cz = 0; cz < GRID; ++cz)
+		for (int cx = 0; cx < GRID; ++cx)
+			surfaces.push_back(generator.generateSurface((FIRST_CHUNK + cx) * CHUNK_SIZE, (FIRST_CHUNK + cz) * CHUNK_SIZE));
+
+	return runChecks("Biome colour", {[&] { return testSeams(surfaces); },
+									  [&] { return testRegion(generator, surfaces); },
+									  [&] { return testBlend(surfaces); }});
+}
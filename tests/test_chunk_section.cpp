@@ -0,0 +1,161 @@
+// Palette-compressed section storage checks.
+//
+// 1. Assign: voxels of 1 to 27 types come back unchanged through get() and
+//    decodeLayer(), on the fewest bits their types need; one type is uniform.
+// 2. Edits: random set() calls against a flat copy, growing a uniform section
+//    through every index width; the air and see-through counts follow.
+// 3. Generated terrain: voxel bytes per chunk against the flat layout.
+
+#include <Chunk/ChunkSection.hpp>
+#include <Chunk/TerrainGenerator.hpp>
+#include <Renderer/TextureManager.hpp>
+#include "TestSuite.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr int EDITS = 20000;
+	constexpr int GRID = 6; // GRID x GRID generated chunks
+	constexpr int TYPES = AIR + 1;
+
+	/// The section holds `voxels`, read one by one and a layer at a time
+	bool matches(const ChunkSection &section, const std::vector<uint8_t> &voxels)
+	{
+		for (int y = 0; y < SECTION_SIZE; ++y)
+		{
+			uint8_t layer[ChunkSection::LAYER];
+			section.decodeLayer(y, layer);
+			for (int i = 0; i < ChunkSection::LAYER; ++i)
+			{
+				const uint8_t type = voxels[y * ChunkSection::LAYER + i];
+				if (layer[i] != type || section.get(i % CHUNK_SIZE, y, i / CHUNK_SIZE) != type)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	bool countsMatch(const ChunkSection &section, const std::vector<uint8_t> &voxels)
+	{
+		bool empty = true;
+		bool solid = true;
+		for (uint8_t type : voxels)
+		{
+			empty &= type == AIR;
+			solid &= type != AIR && !TextureManager::isTransparent(static_cast<TextureType>(type));
+		}
+		return section.isEmpty() == empty && section.isSolid() == solid;
+	}
+
+	bool testAssign()
+	{
+		bool ok = true;
+		std::mt19937 rng(SEED);
+		for (int types = 1; types <= TYPES; ++types)
+		{
+			std::vector<uint8_t> voxels(ChunkSection::VOLUME);
+			for (uint8_t &type : voxels)
+				type = static_cast<uint8_t>(TYPES - 1 - static_cast<int>(rng() % types));
+
+			ChunkSection section;
+			section.assign(reinterpret_cast<const Voxel *>(voxels.data()));
+			const int bits = types == 1 ? 0 : types <= 2 ? 1 : types <= 4 ? 2 : types <= 16 ? 4 : 8;
+			ok &= expect(matches(section, voxels), "assigned voxels do not come back");
+			ok &= expect(section.indexBits() == bits, "assigned voxels are not on the fewest bits");
+			ok &= expect(countsMatch(section, voxels), "empty or solid is wrong after assign");
+		}
+
+		ChunkSection air;
+		ok &= expect(air.kind() == ChunkSection::Kind::EMPTY && air.storageBytes() == 0, "a new section is not empty");
+		std::vector<uint8_t> stone(ChunkSection::VOLUME, STONE);
+		ChunkSection solid;
+		solid.assign(reinterpret_cast<const Voxel *>(stone.data()));
+		ok &= expect(solid.kind() == ChunkSection::Kind::UNIFORM && solid.storageBytes() == 0, "one type is not uniform");
+		ok &= expect(solid.isSolid() && !solid.isEmpty(), "uniform stone is not solid");
+		return ok;
+	}
+
+	bool testEdits()
+	{
+		bool ok = true;
+		std::mt19937 rng(SEED);
+		std::vector<uint8_t> voxels(ChunkSection::VOLUME, STONE);
+		ChunkSection section;
+		section.fill(STONE);
+
+		// New types come in slowly, so every width is used for a while
+		int widths = 0;
+		int lastBits = section.indexBits();
+		for (int n = 0; n < EDITS; ++n)
+		{
+			const int types = 2 + n * (TYPES - 1) / EDITS;
+			const uint8_t type = static_cast<uint8_t>(rng() % types == 0 ? static_cast<unsigned>(AIR) : rng() % types);
+			const int x = static_cast<int>(rng() % CHUNK_SIZE);
+			const int y = static_cast<int>(rng() % SECTION_SIZE);
+			const int z = static_cast<int>(rng() % CHUNK_SIZE);
+			section.set(x, y, z, type);
+			voxels[(y * CHUNK_SIZE + z) * CHUNK_SIZE + x] = type;
+
+			if (section.indexBits() != lastBits)
+			{
+				++widths;
+				lastBits = section.indexBits();
+				ok &= expect(matches(section, voxels), "voxels change when the index width grows");
+				section.releaseRetired();
+			}
+			if (n % 1000 == 0)
+				ok &= expect(matches(section, voxels), "an edited voxel does not come back");
+		}
+		ok &= expect(matches(section, voxels), "an edited voxel does not come back");
+		ok &= expect(countsMatch(section, voxels), "empty or solid is wrong after edits");
+		ok &= expect(widths == 4, "edits did not go through every index width");
+
+		ChunkSection moved = std::move(section);
+		ok &= expect(matches(moved, voxels), "a moved section lost its voxels");
+		ok &= expect(section.isEmpty() && section.isUniform(), "a moved-from section is not empty");
+
+		std::cout << "[TEST] Edits: " << EDITS << " edits through " << widths << " index widths, "
+				  << moved.storageBytes() << " bytes at " << moved.indexBits() << " bits\n";
+		return ok;
+	}
+
+	bool testGenerated()
+	{
+		TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+		size_t bytes = 0;
+		int widths[9] = {};
+		for (int cz = 0; cz < GRID; ++cz)
+		{
+			for (int cx = 0; cx < GRID; ++cx)
+			{
+				const ChunkData data = generator.generateChunk((cx - GRID / 2) * CHUNK_SIZE, (cz - GRID / 2) * CHUNK_SIZE);
+				ChunkSections sections;
+				assignSections(sections, data.voxels.data());
+				for (int s = 0; s < SECTION_COUNT; ++s)
+				{
+					std::vector<uint8_t> voxels(ChunkSection::VOLUME);
+					std::memcpy(voxels.data(), data.voxels.data() + s * ChunkSection::VOLUME, voxels.size());
+					if (!matches(sections[s], voxels))
+						return expect(false, "a generated section does not come back");
+					++widths[sections[s].indexBits()];
+					bytes += sizeof(ChunkSection) + sections[s].storageBytes();
+				}
+			}
+		}
+
+		const double ratio = static_cast<double>(CHUNK_VOLUME) * GRID * GRID / static_cast<double>(bytes);
+		std::cout << "[TEST] Generated: " << widths[0] << " uniform, " << widths[1] << "/" << widths[2] << "/"
+				  << widths[4] << "/" << widths[8] << " sections on 1/2/4/8 bits, "
+				  << bytes / (GRID * GRID) << " bytes per chunk (" << ratio << "x smaller than flat)\n";
+		return expect(ratio >= 4.0, "generated chunks are not 4x smaller than flat voxels");
+	}
+}
+
+int main()
+{
+	return runChecks("Chunk section", {testAssign, testEdits, testGenerated});
+}
@@ -0,0 +1,175 @@
+// Checks fillColumn() against the per-voxel classification it replaced in
+// generateChunkBatch (density, getVoxelTypeAt rules, carve test), over as many
+// columns as a few hundred chunks with varied heights, biomes and noise.
+// Both sides are folded into an FNV-1a hash and must match exactly.
+//
+// This only covers the kernel. generateChunk() output, end to end, is compared
+// with the checked-in hashes by test_terrain_golden; `ctest -L terrain` runs both.
+
+#include <Chunk/ColumnFill.hpp>
+#include <Chunk/TerrainGenerator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr int CHUNK_COUNT = 300;
+
+	// getVoxelTypeAt() as generateChunkBatch called it, voxel by voxel
+	TextureType referenceType(const ColumnFillInput &c, int y, float density)
+	{
+		if (y <= TerrainGenerator::BEDROCK_LEVEL)
+			return BEDROCK;
+
+		if (density == -1.0f)
+			density = static_cast<float>(c.height - y);
+
+		if (density >= 0.0f)
+		{
+			const BiomeConfig &config = TerrainGenerator::getBiomeConfig(c.biome);
+			if (density < 1.0f)
+			{
+				if (y <= TerrainGenerator::SEA_LEVEL + 2 && config.surfaceBlock != STONE)
+					return config.underwaterBlock;
+
+				if (c.biome == BIOME_MOUNTAINS || c.biome == BIOME_SNOWY_MOUNTAINS || config.hasSnow)
+				{
+					float snowLine = 160.0f + c.temperature * 10.0f;
+					uint32_t hash = ((uint32_t)c.worldX * 374761393 + (uint32_t)c.worldZ * 668265263) ^ (uint32_t)c.seed;
+					float dither = static_cast<float>(hash & 0xFFFF) / 65535.0f;
+					if (y > snowLine + (dither - 0.5f) * 15.0f)
+						return SNOW;
+				}
+				return config.surfaceBlock;
+			}
+			if (density < static_cast<float>(config.subsurfaceDepth + 1))
+			{
+				if (y <= TerrainGenerator::SEA_LEVEL + 2 && config.subsurfaceBlock != STONE)
+					return config.underwaterBlock;
+				return config.subsurfaceBlock;
+			}
+			return STONE;
+		}
+
+		if (y <= TerrainGenerator::SEA_LEVEL)
+			return (c.biome == BIOME_FROZEN_OCEAN && y == TerrainGenerator::SEA_LEVEL) ? GLASS : WATER;
+		return AIR;
+	}
+
+	int referenceFill(const ColumnFillInput &c, uint8_t *out)
+	{
+		const bool isMountain = c.biome == BIOME_MOUNTAINS || c.biome == BIOME_SNOWY_MOUNTAINS;
+		int actualMaxHeight = 0;
+		for (int y = 0; y < CHUNK_HEIGHT; ++y)
+		{
+			float density = static_cast<float>(c.height - y);
+			if (isMountain && density > -8.0f && density < 12.0f)
+			{
+				float blend = std::max(0.0f, 1.0f - std::abs(density) / 12.0f);
+				density += c.surface3D[(y - c.surfaceMinY) * c.surfaceStride] * 8.0f * blend;
+			}
+
+			TextureType type = referenceType(c, y, density);
+			if (density >= 0.0f && type != BEDROCK && type != WATER)
+			{
+				int caveIndex = (y - c.caveMinY) * c.caveStride;
+				if (isCarved(c.cave[caveIndex], c.ravine[caveIndex], y))
+					type = AIR;
+			}
+
+			if (type != AIR && type != WATER)
+				actualMaxHeight = std::max(actualMaxHeight, y);
+			out[y] = static_cast<uint8_t>(type);
+		}
+		return actualMaxHeight;
+	}
+
+	void mix(uint64_t &hash, uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			hash ^= (value >> (8 * i)) & 0xFF;
+			hash *= 1099511628211ull;
+		}
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> heightDist(1, CHUNK_HEIGHT - 32);
+	std::uniform_int_distribution<int> biomeDist(0, BIOME_COUNT - 1);
+
+	// Column noise over the whole height, slab bounds vary per column like the
+	// real slab does (only its lower/upper cut matters to the kernel)
+	std::vector<float> cave(CHUNK_HEIGHT), ravine(CHUNK_HEIGHT), surface3D(CHUNK_HEIGHT);
+	uint8_t expected[CHUNK_HEIGHT];
+	uint8_t actual[CHUNK_HEIGHT];
+
+	uint64_t expectedHash = 1469598103934665603ull;
+	uint64_t actualHash = 1469598103934665603ull;
+	int mismatches = 0;
+
+	for (int column = 0; column < CHUNK_COUNT * CHUNK_SIZE * CHUNK_SIZE; ++column)
+	{
+		ColumnFillInput c{};
+		c.worldX = column % 4096 - 2048;
+		c.worldZ = column / 4096 - 16;
+		c.height = heightDist(rng);
+		c.biome = static_cast<BiomeType>(biomeDist(rng));
+		c.temperature = noise(rng);
+		c.seed = 1337;
+
+		// Every 8th column uses values on a 1/8 grid, so exact thresholds and
+		// the density == -1 fallback actually get hit.
+		const bool quantized = column % 8 == 0;
+		for (int y = 0; y < CHUNK_HEIGHT; ++y)
+		{
+			cave[y] = quantized ? std::round(noise(rng) * 8.0f) / 8.0f : noise(rng);
+			ravine[y] = quantized ? std::round(noise(rng) * 8.0f) / 8.0f : noise(rng);
+			surface3D[y] = quantized ? std::round(noise(rng) * 8.0f) / 8.0f : noise(rng);
+		}
+
+		c.caveMinY = TerrainGenerator::BEDROCK_LEVEL + 1;
+		c.caveMaxY = std::min(CHUNK_HEIGHT - 1, c.height + 7);
+		c.cave = cave.data() + c.caveMinY;
+		c.ravine = ravine.data() + c.caveMinY;
+		c.caveStride = 1;
+		c.surfaceMinY = std::max(0, c.height - 11);
+		c.surfaceMaxY = std::min(CHUNK_HEIGHT - 1, c.height + 7);
+		c.surface3D = surface3D.data() + c.surfaceMinY;
+		c.surfaceStride = 1;
+
+		int expectedTop = referenceFill(c, expected);
+		int actualTop = fillColumn(c, actual);
+
+		mix(expectedHash, static_cast<uint32_t>(expectedTop));
+		mix(actualHash, static_cast<uint32_t>(actualTop));
+		for (int y = 0; y < CHUNK_HEIGHT; ++y)
+		{
+			mix(expectedHash, expected[y]);
+			mix(actualHash, actual[y]);
+		}
+		if (expectedTop != actualTop || !std::equal(expected, expected + CHUNK_HEIGHT, actual))
+		{
+			if (mismatches++ < 5)
+				std::cerr << "Mismatch at column " << column << " (biome " << c.biome << ", height " << c.height << ")\n";
+		}
+	}
+
+	std::cout << "[TEST] fillColumn: " << CHUNK_COUNT << " chunks of columns, reference hash " << std::hex
+			  << expectedHash << ", kernel hash " << actualHash << std::dec << '\n';
+	if (expectedHash != actualHash || mismatches > 0)
+	{
+		std::cerr << "[TEST] FAILED: " << mismatches << " columns differ from the reference\n";
+		return 1;
+	}
+	std::cout << "[TEST] fillColumn matches the per-voxel reference\n";
+	return 0;
+}
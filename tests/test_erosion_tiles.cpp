@@ -0,0 +1,144 @@
+// Erosion tile checks.
+//
+// 1. ErosionTileCache: threads asking for the same missing tile at once get
+//    the same tile, built a single time.
+// 2. Rebuilding an evicted tile, on another thread, gives the same heights bit
+//    for bit: chunks generated before and after an eviction must agree.
+// 3. Seams: the border shell of a chunk must hold the same voxels as the edge
+//    column of the neighbour it mirrors, both across a tile seam and inside a
+//    tile (ores aside, the shell does not place them).
+
+#include <Chunk/TerrainGenerator.hpp>
+#include <Chunk/ErosionTileCache.hpp>
+#include "TestSuite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int THREADS = 8;
+
+	bool testSingleBuild()
+	{
+		ErosionTileCache cache(4);
+		std::atomic<int> builds{0};
+		ErosionTileCache::Builder build = [&builds](int tileX, int tileZ, ErosionTileCache::Tile &out)
+		{
+			builds.fetch_add(1);
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			out.fill(static_cast<float>(tileX * 1000 + tileZ));
+		};
+
+		std::vector<std::shared_ptr<const ErosionTileCache::Tile>> tiles(THREADS);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < THREADS; ++t)
+			threads.emplace_back([&, t]
+								 { tiles[t] = cache.get(SEED, 3, -2, build); });
+		for (std::thread &thread : threads)
+			thread.join();
+
+		bool ok = builds.load() == 1;
+		for (const auto &tile : tiles)
+			ok &= tile == tiles[0] && (*tile)[0] == 2998.0f;
+
+		// Past capacity the least recently used tile goes
+		for (int i = 0; i < 4; ++i)
+			cache.get(SEED, i, 0, build);
+		ok &= cache.size() == cache.capacity() && !cache.contains(SEED, 3, -2);
+
+		std::cout << "[TEST] ErosionTileCache: " << THREADS << " concurrent requests, " << builds.load() - 4 << " build\n";
+		return expect(ok, "tile built more than once or not shared");
+	}
+
+	std::shared_ptr<const ErosionTileCache::Tile> cachedTile(int tileX, int tileZ)
+	{
+		TerrainGenerator::getThreadLocal(SEED).prefetchErosionTile(tileX, tileZ);
+		return ErosionTileCache::instance().get(SEED, tileX, tileZ, [](int, int, ErosionTileCache::Tile &) {});
+	}
+
+	bool testRebuild()
+	{
+		ErosionTileCache::instance().clear();
+		const ErosionTileCache::Tile first = *cachedTile(-1, 2);
+
+		ErosionTileCache::instance().clear();
+		ErosionTileCache::Tile second{};
+		std::thread other([&second]
+						  { second = *cachedTile(-1, 2); });
+		other.join();
+
+		const bool ok = std::memcmp(first.data(), second.data(), sizeof(first)) == 0;
+		std::cout << "[TEST] Rebuilt tile " << (ok ? "matches" : "differs") << '\n';
+		return expect(ok, "erosion tiles are not deterministic");
+	}
+
+	uint8_t withoutOre(uint8_t type)
+	{
+		switch (type)
+		{
+		case COAL_ORE:
+		case IRON_ORE:
+		case COPPER_ORE:
+		case GOLD_ORE:
+		case LAPIS_ORE:
+		case REDSTONE_ORE:
+		case DIAMOND_ORE:
+		case EMERALD_ORE:
+			return STONE;
+		default:
+			return type;
+		}
+	}
+
+	// Compares the east shell of the chunk at chunkX with the west column of
+	// the chunk at chunkX + 1, and the other way round. Returns the mismatches.
+	int seamMismatches(TerrainGenerator &generator, int chunkX, int chunkZ)
+	{
+		const ChunkData west = generator.generateTerrain(chunkX * CHUNK_SIZE, chunkZ * CHUNK_SIZE);
+		const ChunkData east = generator.generateTerrain((chunkX + 1) * CHUNK_SIZE, chunkZ * CHUNK_SIZE);
+
+		auto voxel = [](const ChunkData &data, int x, int y, int z)
+		{ return withoutOre(data.voxels[y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x].type); };
+		auto shell = [](const ChunkData &data, int x, int y, int z)
+		{ return data.borderVoxels[(y + 1) * 18 * 18 + (z + 1) * 18 + (x + 1)]; };
+
+		int mismatches = 0;
+		for (int y = 0; y < CHUNK_HEIGHT; ++y)
+		{
+			for (int z = 0; z < CHUNK_SIZE; ++z)
+			{
+				mismatches += shell(west, CHUNK_SIZE, y, z) != voxel(east, 0, y, z);
+				mismatches += shell(east, -1, y, z) != voxel(west, CHUNK_SIZE - 1, y, z);
+			}
+		}
+		return mismatches;
+	}
+
+	bool testSeams()
+	{
+		TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+		bool ok = true;
+		for (int chunkX : {ErosionTileCache::TILE_CHUNKS - 1, ErosionTileCache::TILE_CHUNKS / 2 - 1, -1})
+		{
+			int mismatches = 0;
+			for (int chunkZ = 0; chunkZ < ErosionTileCache::TILE_CHUNKS; ++chunkZ)
+				mismatches += seamMismatches(generator, chunkX, chunkZ);
+
+			const bool tileSeam = ErosionTileCache::tileOf(chunkX * CHUNK_SIZE) != ErosionTileCache::tileOf((chunkX + 1) * CHUNK_SIZE);
+			std::cout << "[TEST] Chunks " << chunkX << '|' << chunkX + 1 << (tileSeam ? " (tile seam)" : "")
+					  << ": " << mismatches << " shell voxels differ\n";
+			ok &= mismatches == 0;
+		}
+		return expect(ok, "border shells disagree with their neighbours");
+	}
+}
+
+int main()
+{
+	return runChecks("Erosion tile", {testSingleBuild, testRebuild, testSeams});
+}
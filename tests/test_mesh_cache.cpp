@@ -0,0 +1,172 @@
+// Mesh cache checks.
+//
+// 1. Packing: the section meshes of generated chunks come back unchanged
+//    through packQuads() / unpackQuads(), in fewer bytes.
+// 2. Entries: a take() with the seed and edit generation of the store hits
+//    and hands the voxels back; any other misses and drops the entry.
+// 3. Bounds: the oldest entries go once the bytes held would exceed the
+//    capacity, and dropBeyond() drops the far ones; bytes held follow.
+
+#include <Chunk/ChunkMesher.hpp>
+#include <Chunk/MeshCache.hpp>
+#include <Chunk/TerrainGenerator.hpp>
+#include "TestSuite.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr int GRID = 6; // GRID x GRID generated chunks
+
+	std::unique_ptr<CachedChunk> makeEntry(const ChunkData &data)
+	{
+		auto entry = std::make_unique<CachedChunk>();
+		assignSections(entry->sections, data.voxels.data());
+		entry->colors = data.colors;
+
+		ChunkMeshInput input{};
+		input.sections = &entry->sections;
+		input.shell = data.borderVoxels.data();
+		input.colors = &data.colors;
+		SectionMeshes meshes;
+		buildSectionMeshes(input, ALL_SECTIONS, meshes);
+		for (int s = 0; s < SECTION_COUNT; ++s)
+		{
+			packQuads(meshes[s].quads, entry->opaque[s]);
+			packQuads(meshes[s].waterQuads, entry->water[s]);
+		}
+		return entry;
+	}
+
+	bool testPacking(TerrainGenerator &generator)
+	{
+		bool ok = true;
+		size_t quads = 0;
+		size_t packedBytes = 0;
+		for (int cz = 0; cz < GRID; ++cz)
+		{
+			for (int cx = 0; cx < GRID; ++cx)
+			{
+				const ChunkData data = generator.generateChunk((cx - GRID / 2) * CHUNK_SIZE, (cz - GRID / 2) * CHUNK_SIZE);
+				ChunkSections sections;
+				assignSections(sections, data.voxels.data());
+				ChunkMeshInput input{};
+				input.sections = &sections;
+				input.shell = data.borderVoxels.data();
+				input.colors = &data.colors;
+				SectionMeshes meshes;
+				buildSectionMeshes(input, ALL_SECTIONS, meshes);
+
+				for (const SectionMesh &mesh : meshes)
+				{
+					for (const std::vector<ChunkQuad> *list : {&mesh.quads, &mesh.waterQuads})
+					{
+						std::vector<uint8_t> packed;
+						std::vector<ChunkQuad> unpacked;
+						packQuads(*list, packed);
+						unpackQuads(packed, unpacked);
+						ok &= expect(unpacked == *list, "packed quads do not come back");
+						quads += list->size();
+						packedBytes += packed.size();
+					}
+				}
+			}
+		}
+
+		// Every colour case, sizes past 16, and a texture change after a repeat
+		const uint32_t ao[4] = {3, 2, 1, 0};
+		const uint16_t none[4] = {0, 0, 0, 0};
+		const uint16_t flat[4] = {0x1234, 0x1234, 0x1234, 0x1234};
+		const uint16_t gradient[4] = {0x1234, 0x1234, 0x1234, 0x4321};
+		const std::vector<ChunkQuad> cases = {
+			ChunkQuad::pack({1, 2, 3}, 0, ao, 1, 1, STONE, false, none),
+			ChunkQuad::pack({4, 5, 6}, 1, ao, 1, 1, STONE, false, none),
+			ChunkQuad::pack({7, 255, 9}, 2, ao, 16, 16, GRASS_TOP, true, flat),
+			ChunkQuad::pack({0, 0, 0}, 3, ao, 40, 2, GRASS_TOP, true, gradient),
+			ChunkQuad::pack({15, 100, 15}, 4, ao, 2, 3, OAK_LEAVES, true, flat)};
+		std::vector<uint8_t> packed;
+		std::vector<ChunkQuad> unpacked;
+		packQuads(cases, packed);
+		unpackQuads(packed, unpacked);
+		ok &= expect(unpacked == cases, "packed colour cases do not come back");
+
+		const double ratio = static_cast<double>(quads * sizeof(ChunkQuad)) / static_cast<double>(packedBytes);
+		std::cout << "[TEST] Packing: " << quads << " quads in " << packedBytes << " bytes (" << ratio
+				  << "x smaller)\n";
+		return ok && expect(ratio >= 2.0, "packed quads are not 2x smaller");
+	}
+
+	bool testEntries(TerrainGenerator &generator)
+	{
+		bool ok = true;
+		const ChunkData data = generator.generateChunk(0, 0);
+		MeshCache cache(size_t(64) << 20);
+		const glm::ivec3 pos(3, 0, -2);
+
+		cache.store(pos, SEED, 0, makeEntry(data));
+		ok &= expect(cache.size() == 1 && cache.bytes() > 0 && cache.contains(pos), "a stored entry is not held");
+		std::unique_ptr<CachedChunk> back = cache.take(pos, SEED, 0);
+		ok &= expect(back != nullptr && cache.hits() == 1, "an entry is not taken back");
+		ok &= expect(cache.size() == 0 && cache.bytes() == 0 && !cache.contains(pos), "a taken entry is still held");
+		if (back)
+		{
+			bool same = true;
+			for (int y = 0; y < CHUNK_HEIGHT; ++y)
+				for (int z = 0; z < CHUNK_SIZE; ++z)
+					for (int x = 0; x < CHUNK_SIZE; ++x)
+						same &= back->sections[y / SECTION_SIZE].get(x, y % SECTION_SIZE, z) ==
+								data.voxels[(y * CHUNK_SIZE + z) * CHUNK_SIZE + x].type;
+			ok &= expect(same && back->colors == data.colors, "a taken entry lost its voxels or colours");
+		}
+
+		ok &= expect(cache.take(pos, SEED, 0) == nullptr, "an entry is taken twice");
+		cache.store(pos, SEED, 4, makeEntry(data));
+		ok &= expect(cache.take(pos, SEED, 5) == nullptr, "an entry of an older edit generation is taken");
+		ok &= expect(cache.size() == 0, "a stale entry is kept");
+		cache.store(pos, SEED, 4, makeEntry(data));
+		ok &= expect(cache.take(pos, SEED + 1, 4) == nullptr, "an entry of another seed is taken");
+		cache.store(pos, SEED, 4, makeEntry(data));
+		cache.store(pos, SEED, 6, makeEntry(data));
+		ok &= expect(cache.size() == 1 && cache.take(pos, SEED, 6) != nullptr, "a store does not replace the entry");
+		ok &= expect(cache.hits() == 2 && cache.misses() == 3, "hits or misses are miscounted");
+		return ok;
+	}
+
+	bool testBounds(TerrainGenerator &generator)
+	{
+		bool ok = true;
+		const ChunkData data = generator.generateChunk(0, 0);
+		const size_t entryBytes = makeEntry(data)->bytes();
+
+		// Room for 4 entries: storing 6 drops the first 2
+		MeshCache cache(entryBytes * 4 + entryBytes / 2);
+		for (int i = 0; i < 6; ++i)
+			cache.store(glm::ivec3(i, 0, 0), SEED, 0, makeEntry(data));
+		ok &= expect(cache.size() == 4 && cache.bytes() == entryBytes * 4, "the capacity is not kept");
+		ok &= expect(!cache.take(glm::ivec3(1, 0, 0), SEED, 0) && cache.take(glm::ivec3(2, 0, 0), SEED, 0),
+					 "the oldest entries are not the ones evicted");
+
+		// Chunk centres at x = 56, 72 and 88: 80 blocks from the origin keeps the first two
+		cache.dropBeyond(glm::vec3(0.0f), 80.0f);
+		ok &= expect(cache.size() == 2 && cache.bytes() == entryBytes * 2, "dropBeyond() kept a far entry");
+		cache.clear();
+		ok &= expect(cache.size() == 0 && cache.bytes() == 0, "clear() kept an entry");
+
+		MeshCache tiny(entryBytes / 2);
+		tiny.store(glm::ivec3(0), SEED, 0, makeEntry(data));
+		ok &= expect(tiny.size() == 0, "an entry larger than the capacity is kept");
+
+		std::cout << "[TEST] Bounds: " << entryBytes << " bytes per cached chunk\n";
+		return ok;
+	}
+}
+
+int main()
+{
+	TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+
+	return runChecks("Mesh cache", {[&] { return testPacking(generator); },
+									[&] { return testEntries(generator); },
+									[&] { return testBounds(generator); }});
+}
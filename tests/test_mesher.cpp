@@ -0,0 +1,466 @@
+// Binary greedy mesher checks.
+//
+// Every quad buildChunkMesh() emits is cut back into unit faces and compared
+// with the faces a voxel-by-voxel walk finds: each visible face must be
+// covered exactly once, by a quad of its own texture, facing outwards, and
+// biome-coloured quads must interpolate to the colour of every column corner
+// they cover, and no quad may reach into another section. Runs on generated
+// chunks and on random voxels with random shells (every transparent type next
+// to every other).
+//
+// Then solid sections, whose faces all hide when the voxels around them are
+// opaque and which the mesher then skips, with and without a gap around them.
+//
+// Then edits: after every voxel edit, re-meshing only the sections
+// sectionsTouchedBy() names must give the same meshes as meshing them all.
+//
+// Then water planes: each section's water quads are sorted by normal and
+// plane, and the runs sortWaterQuads() lists cover them exactly, in order.
+
+#include <Chunk/ChunkMesher.hpp>
+#include <Chunk/TerrainGenerator.hpp>
+#include <Renderer/TextureManager.hpp>
+#include "TestSuite.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr int GRID = 6; // GRID x GRID generated chunks
+	constexpr int RANDOM_CHUNKS = 24;
+	constexpr int EDITS = 400;
+
+	constexpr int PAD = CHUNK_SIZE + 2;
+	constexpr int SHELL_SIZE = PAD * (CHUNK_HEIGHT + 2) * PAD;
+
+	struct MeshStats
+	{
+		long faces = 0;
+		long quads = 0;
+		long errors = 0;
+	};
+
+	struct VoxelGrid
+	{
+		const std::vector<Voxel> &voxels;
+		const uint8_t *shell;
+
+		TextureType at(int x, int y, int z) const
+		{
+			if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < CHUNK_SIZE)
+				return static_cast<TextureType>(voxels[y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x].type);
+			if (!shell || y < -1 || y > CHUNK_HEIGHT)
+				return AIR;
+			return static_cast<TextureType>(shell[(y + 1) * PAD * PAD + (z + 1) * PAD + (x + 1)]);
+		}
+	};
+
+	const glm::ivec3 NORMALS[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+	uint32_t expectedTexture(TextureType type, int face)
+	{
+		if (type == GRASS_SIDE && face == 2)
+			return GRASS_TOP;
+		if (type == GRASS_SIDE && face == 3)
+			return DIRT;
+		if (type == OAK_LOG && (face == 2 || face == 3))
+			return OAK_LOG_TOP;
+		return type;
+	}
+
+	int channel(uint32_t rgba, int c)
+	{
+		return static_cast<int>((rgba >> (8 * c)) & 0xFF);
+	}
+
+	/// Corner `corner` of a quad, as the vertex shader expands it
+	glm::ivec3 cornerOf(const ChunkQuad &quad, int corner)
+	{
+		const int d = static_cast<int>(quad.normal()) / 2;
+		glm::ivec3 pos = quad.start();
+		if (corner == 1 || corner == 2)
+			pos[(d + 1) % 3] += quad.sizeU();
+		if (corner >= 2)
+			pos[(d + 2) % 3] += quad.sizeV();
+		return pos;
+	}
+
+	void report(MeshStats &stats, const char *what)
+	{
+		if (stats.errors++ < 10)
+			std::cerr << "[TEST] " << what << '\n';
+	}
+
+	/// Unit faces of the quads, checked against the grid; covered[] marks
+	/// which (voxel, direction) pairs they claim
+	void checkQuads(const VoxelGrid &grid, const BiomeColorField &colors, const std::vector<ChunkQuad> &quads,
+					bool water, std::vector<uint8_t> &covered, MeshStats &stats)
+	{
+		for (const ChunkQuad &quad : quads)
+		{
+			const int face = static_cast<int>(quad.normal());
+			const uint32_t texture = quad.textureIndex();
+			const int d = face / 2;
+			const int u = (d + 1) % 3;
+			const int v = (d + 2) % 3;
+			const glm::ivec3 normal = NORMALS[face];
+			++stats.quads;
+
+			// Front faces wind counter-clockwise seen from outside, through the
+			// shared index pattern and the shader's corner swap on negative faces
+			static constexpr int PATTERN[6] = {0, 1, 2, 0, 2, 3};
+			for (int t = 0; t < 2; ++t)
+			{
+				glm::vec3 p[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					int corner = PATTERN[t * 3 + k];
+					if ((face & 1) && (corner & 1))
+						corner ^= 2;
+					p[k] = glm::vec3(cornerOf(quad, corner));
+				}
+				if (glm::dot(glm::cross(p[1] - p[0], p[2] - p[0]), glm::vec3(normal)) <= 0.0f)
+					report(stats, "triangle faces inwards");
+			}
+
+			const glm::ivec3 start = quad.start();
+			const glm::ivec3 end = cornerOf(quad, 2);
+			const int width = end[u] - start[u];
+			const int height = end[v] - start[v];
+			int section = -1; // Of the first voxel the quad covers
+			if (width <= 0 || height <= 0 || end[d] != start[d])
+			{
+				report(stats, "degenerate quad");
+				continue;
+			}
+
+			for (int j = 0; j < height; ++j)
+			{
+				for (int i = 0; i < width; ++i)
+				{
+					glm::ivec3 voxel = start;
+					voxel[u] += i;
+					voxel[v] += j;
+					if (normal[d] > 0)
+						voxel[d] -= 1;
+
+					const TextureType type = grid.at(voxel.x, voxel.y, voxel.z);
+					const TextureType facing = grid.at(voxel.x + normal.x, voxel.y + normal.y, voxel.z + normal.z);
+					const bool visible = type != AIR && (facing == AIR || (TextureManager::isTransparent(facing) && facing != type));
+					if (voxel.x < 0 || voxel.x >= CHUNK_SIZE || voxel.y < 0 || voxel.y >= CHUNK_HEIGHT ||
+						voxel.z < 0 || voxel.z >= CHUNK_SIZE || !visible)
+					{
+						report(stats, "quad covers a hidden face");
+						continue;
+					}
+					if (texture != expectedTexture(type, face) || (type == WATER) != water)
+						report(stats, "quad has the wrong texture or buffer");
+					const bool tinted = type == GRASS_SIDE || type == GRASS_TOP || type == OAK_LEAVES || type == WATER;
+					if (quad.useBiomeColor() != tinted || (water && quad.color(0) != WATER_COLOR))
+						report(stats, "quad has the wrong tint");
+
+					if (section < 0)
+						section = voxel.y / SECTION_SIZE;
+					if (voxel.y / SECTION_SIZE != section)
+						report(stats, "quad crosses a section boundary");
+
+					uint8_t &mark = covered[(voxel.y * CHUNK_SIZE * CHUNK_SIZE + voxel.z * CHUNK_SIZE + voxel.x) * 6 + face];
+					if (mark)
+						report(stats, "face covered twice");
+					mark = 1;
+
+					if (type != GRASS_SIDE && type != GRASS_TOP && type != OAK_LEAVES)
+						continue;
+
+					// What the rasteriser makes of the quad's corner colours at each
+					// corner of this face, against the colour field
+					for (int corner = 0; corner < 4; ++corner)
+					{
+						const float s = static_cast<float>(i + (corner & 1)) / static_cast<float>(width);
+						const float r = static_cast<float>(j + (corner >> 1)) / static_cast<float>(height);
+						glm::ivec3 point = start;
+						point[u] += i + (corner & 1);
+						point[v] += j + (corner >> 1);
+						const uint32_t want = (type == OAK_LEAVES) ? colors.foliageAt(point.x, point.z) : colors.grassAt(point.x, point.z);
+						for (int c = 0; c < 3; ++c)
+						{
+							const float top = channel(BiomeColorField::toRGBA8(quad.color(0)), c) * (1.0f - s) +
+											  channel(BiomeColorField::toRGBA8(quad.color(1)), c) * s;
+							const float bottom = channel(BiomeColorField::toRGBA8(quad.color(3)), c) * (1.0f - s) +
+												 channel(BiomeColorField::toRGBA8(quad.color(2)), c) * s;
+							if (std::abs(top * (1.0f - r) + bottom * r - channel(want, c)) > 0.5f)
+							{
+								report(stats, "quad colour differs from the colour field");
+								c = 3;
+								corner = 4;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	MeshStats checkChunk(const std::vector<Voxel> &voxels, const uint8_t *shell, const BiomeColorField &colors)
+	{
+		std::vector<ChunkQuad> quads;
+		std::vector<ChunkQuad> waterQuads;
+		ChunkSections sections;
+		assignSections(sections, voxels.data());
+		ChunkMeshInput input{};
+		input.sections = &sections;
+		input.shell = shell;
+		input.colors = &colors;
+		buildChunkMesh(input, quads, waterQuads);
+
+		const VoxelGrid grid{voxels, shell};
+		MeshStats stats;
+		std::vector<uint8_t> covered(static_cast<size_t>(CHUNK_VOLUME) * 6, 0);
+		checkQuads(grid, colors, quads, false, covered, stats);
+		checkQuads(grid, colors, waterQuads, true, covered, stats);
+
+		for (int y = 0; y < CHUNK_HEIGHT; ++y)
+		{
+			for (int z = 0; z < CHUNK_SIZE; ++z)
+			{
+				for (int x = 0; x < CHUNK_SIZE; ++x)
+				{
+					const TextureType type = grid.at(x, y, z);
+					if (type == AIR)
+						continue;
+					for (int face = 0; face < 6; ++face)
+					{
+						const glm::ivec3 &n = NORMALS[face];
+						const TextureType facing = grid.at(x + n.x, y + n.y, z + n.z);
+						if (facing != AIR && !(TextureManager::isTransparent(facing) && facing != type))
+							continue;
+						++stats.faces;
+						if (!covered[(y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x) * 6 + face])
+							report(stats, "visible face missing from the mesh");
+					}
+				}
+			}
+		}
+		return stats;
+	}
+
+	bool testGenerated(TerrainGenerator &generator)
+	{
+		MeshStats total;
+		for (int cz = 0; cz < GRID; ++cz)
+		{
+			for (int cx = 0; cx < GRID; ++cx)
+			{
+				const ChunkData data = generator.generateChunk((cx - GRID / 2) * CHUNK_SIZE, (cz - GRID / 2) * CHUNK_SIZE);
+				const MeshStats stats = checkChunk(data.voxels, data.borderVoxels.data(), data.colors);
+				total.faces += stats.faces;
+				total.quads += stats.quads;
+				total.errors += stats.errors;
+			}
+		}
+
+		std::cout << "[TEST] Generated: " << total.faces << " visible faces in " << total.quads << " quads ("
+				  << static_cast<double>(total.faces) / static_cast<double>(total.quads) << " faces/quad), "
+				  << total.errors << " errors\n";
+		return expect(total.errors == 0, "the mesh of generated chunks is wrong");
+	}
+
+	bool testRandom()
+	{
+		// Few types, so that equal neighbours merge and every pair meets
+		const TextureType palette[] = {AIR, AIR, AIR, STONE, GRASS_SIDE, OAK_LOG, GLASS, OAK_LEAVES, WATER};
+		std::mt19937 rng(SEED);
+		std::uniform_int_distribution<int> pick(0, static_cast<int>(std::size(palette)) - 1);
+
+		MeshStats total;
+		for (int n = 0; n < RANDOM_CHUNKS; ++n)
+		{
+			// Random voxels over a band of layers, so that empty layers are skipped too
+			const int bottom = n * 7 % 64;
+			std::vector<Voxel> voxels(CHUNK_VOLUME, Voxel{static_cast<uint8_t>(AIR)});
+			for (int y = bottom; y < bottom + 24; ++y)
+				for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+					voxels[y * CHUNK_SIZE * CHUNK_SIZE + i].type = static_cast<uint8_t>(palette[pick(rng)]);
+
+			std::vector<uint8_t> shell(SHELL_SIZE);
+			for (uint8_t &type : shell)
+				type = static_cast<uint8_t>(palette[pick(rng)]);
+
+			// Colours in blocks of 4 columns: flat areas with steps between them
+			BiomeColorField colors;
+			for (int i = 0; i < BiomeColorField::SIZE * BiomeColorField::SIZE; ++i)
+			{
+				const int block = (i % BiomeColorField::SIZE) / 4 + (i / BiomeColorField::SIZE) / 4 * 5;
+				colors.grass[i] = static_cast<uint16_t>(rng() % 3 == 0 ? rng() : block * 977);
+				colors.foliage[i] = static_cast<uint16_t>(block * 1291);
+			}
+
+			const MeshStats stats = checkChunk(voxels, n % 2 ? shell.data() : nullptr, colors);
+			total.faces += stats.faces;
+			total.quads += stats.quads;
+			total.errors += stats.errors;
+		}
+
+		std::cout << "[TEST] Random: " << total.faces << " visible faces in " << total.quads << " quads, "
+				  << total.errors << " errors\n";
+		return expect(total.errors == 0, "the mesh of random chunks is wrong");
+	}
+
+	bool testSolid()
+	{
+		const BiomeColorField colors{};
+		std::mt19937 rng(SEED);
+
+		// Stone, or stone and dirt so that the sections are solid but not
+		// uniform, up to a random band; an opaque shell below the band, with
+		// a hole in one case so that a face shows through it
+		MeshStats total;
+		for (int n = 0; n < 4; ++n)
+		{
+			const int band = 96;
+			std::vector<Voxel> voxels(CHUNK_VOLUME, Voxel{static_cast<uint8_t>(AIR)});
+			for (int y = 0; y < band; ++y)
+				for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+					voxels[y * CHUNK_SIZE * CHUNK_SIZE + i].type = static_cast<uint8_t>(n % 2 && rng() % 4 == 0 ? DIRT : STONE);
+			for (int y = band; y < band + 8; ++y)
+				for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+					voxels[y * CHUNK_SIZE * CHUNK_SIZE + i].type = static_cast<uint8_t>(rng() % 2 ? AIR : GLASS);
+
+			std::vector<uint8_t> shell(SHELL_SIZE, static_cast<uint8_t>(AIR));
+			std::fill(shell.begin(), shell.begin() + (band + 1) * PAD * PAD, static_cast<uint8_t>(STONE));
+			if (n >= 2)
+				shell[(40 + 1) * PAD * PAD + 5 * PAD] = static_cast<uint8_t>(AIR);
+
+			const MeshStats stats = checkChunk(voxels, shell.data(), colors);
+			total.faces += stats.faces;
+			total.quads += stats.quads;
+			total.errors += stats.errors;
+		}
+
+		std::cout << "[TEST] Solid: " << total.faces << " visible faces in " << total.quads << " quads, "
+				  << total.errors << " errors\n";
+		return expect(total.errors == 0, "the mesh of chunks with solid sections is wrong");
+	}
+
+	bool testEdits(TerrainGenerator &generator)
+	{
+		const TextureType palette[] = {AIR, STONE, GRASS_SIDE, GLASS, OAK_LEAVES, WATER};
+		std::mt19937 rng(SEED);
+
+		ChunkData data = generator.generateChunk(0, 0);
+		ChunkSections sections;
+		assignSections(sections, data.voxels.data());
+		ChunkMeshInput input{};
+		input.sections = &sections;
+		input.shell = data.borderVoxels.data();
+		input.colors = &data.colors;
+
+		SectionMeshes incremental;
+		SectionMeshes full;
+		buildSectionMeshes(input, ALL_SECTIONS, incremental);
+
+		long errors = 0;
+		long remeshed = 0;
+		for (int n = 0; n < EDITS; ++n)
+		{
+			// Around the surface, and on section boundaries half of the time
+			const int x = static_cast<int>(rng() % CHUNK_SIZE);
+			const int z = static_cast<int>(rng() % CHUNK_SIZE);
+			int y = 40 + static_cast<int>(rng() % 120);
+			if (n % 2)
+				y = (y / SECTION_SIZE) * SECTION_SIZE + (n % 4 == 1 ? 0 : SECTION_SIZE - 1);
+			sections[y / SECTION_SIZE].set(x, y % SECTION_SIZE, z, static_cast<uint8_t>(palette[rng() % std::size(palette)]));
+
+			const uint32_t sections = sectionsTouchedBy(y);
+			remeshed += std::popcount(sections);
+			buildSectionMeshes(input, sections, incremental);
+			buildSectionMeshes(input, ALL_SECTIONS, full);
+			for (int s = 0; s < SECTION_COUNT; ++s)
+			{
+				if (incremental[s].quads != full[s].quads || incremental[s].waterQuads != full[s].waterQuads)
+				{
+					if (errors++ < 10)
+						std::cerr << "[TEST] section " << s << " is stale after an edit at y = " << y << '\n';
+				}
+			}
+		}
+
+		std::cout << "[TEST] Edits: " << EDITS << " edits re-meshed " << remeshed << " sections ("
+				  << static_cast<double>(remeshed) / EDITS << " per edit), " << errors << " errors\n";
+		return expect(errors == 0, "re-meshing the touched sections does not match a full mesh");
+	}
+
+	bool testWaterPlanes(TerrainGenerator &generator)
+	{
+		// Water over a band of layers crossing a section boundary, with air
+		// holes so that faces show along every axis
+		std::mt19937 rng(SEED);
+		std::vector<Voxel> voxels(CHUNK_VOLUME, Voxel{static_cast<uint8_t>(AIR)});
+		for (int y = 56; y < 72; ++y)
+			for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+				voxels[y * CHUNK_SIZE * CHUNK_SIZE + i].type = static_cast<uint8_t>(rng() % 3 ? WATER : AIR);
+		const ChunkData data = generator.generateChunk(0, 0);
+		const BiomeColorField colors{};
+
+		long runs = 0;
+		long quads = 0;
+		long errors = 0;
+		const std::vector<Voxel> *chunks[] = {&voxels, &data.voxels};
+		for (const std::vector<Voxel> *chunk : chunks)
+		{
+			ChunkSections sections;
+			assignSections(sections, chunk->data());
+			ChunkMeshInput input{};
+			input.sections = &sections;
+			input.shell = chunk == &voxels ? nullptr : data.borderVoxels.data();
+			input.colors = chunk == &voxels ? &colors : &data.colors;
+			SectionMeshes meshes;
+			buildSectionMeshes(input, ALL_SECTIONS, meshes);
+
+			for (const SectionMesh &mesh : meshes)
+			{
+				size_t next = 0;
+				int previousKey = -1;
+				for (const WaterPlane &plane : mesh.waterPlanes)
+				{
+					const int key = plane.normal * 512 + plane.plane;
+					if (plane.first != next || plane.count == 0 || key <= previousKey)
+						++errors;
+					for (size_t i = plane.first; i < plane.first + plane.count && i < mesh.waterQuads.size(); ++i)
+					{
+						const ChunkQuad &quad = mesh.waterQuads[i];
+						if (quad.normal() != plane.normal || quad.start()[static_cast<int>(plane.normal >> 1)] != plane.plane)
+							++errors;
+					}
+					next = plane.first + plane.count;
+					previousKey = key;
+				}
+				if (next != mesh.waterQuads.size())
+					++errors;
+				runs += static_cast<long>(mesh.waterPlanes.size());
+				quads += static_cast<long>(mesh.waterQuads.size());
+			}
+		}
+
+		std::cout << "[TEST] Water planes: " << quads << " water quads in " << runs << " plane runs, " << errors
+				  << " errors\n";
+		return expect(errors == 0, "water quads are not listed plane by plane");
+	}
+}
+
+int main()
+{
+	TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+
+	return runChecks("Mesher", {[&] { return testGenerated(generator); },
+								testRandom,
+								testSolid,
+								[&] { return testEdits(generator); },
+								[&] { return testWaterPlanes(generator); }});
+}
@@ -0,0 +1,161 @@
+// Checks that ore placement from precomputed cluster templates keeps the ore
+// statistics of the per-chunk random walk it replaced.
+//
+// Every ore voxel of a generated chunk was STONE before the ore pass, so the
+// pre-ore volume is recovered by turning ores back into stone. The reference
+// random walk (the old generateChunkBatch ore pass, verbatim) is run on that
+// volume and the ore counts of both are compared per ore type.
+
+#include <Chunk/TerrainGenerator.hpp>
+#include "TestSuite.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr int GRID = 24; // GRID x GRID chunks
+
+	// Allowed relative difference of the total count per ore. Rare ores get
+	// fewer samples, hence the looser bound.
+	constexpr double COMMON_TOLERANCE = 0.05;
+	constexpr double RARE_TOLERANCE = 0.12;
+	constexpr long RARE_BELOW = 20000; // Reference voxels under which an ore counts as rare
+
+	struct OreDef
+	{
+		TextureType type;
+		int minHeight;
+		int maxHeight;
+		int clusterSize;
+		int clustersPerChunk;
+		int seedOffset;
+	};
+
+	// TerrainGenerator::setupOres()
+	const OreDef ORES[] = {
+		{COAL_ORE, 0, 128, 17, 20, 10000},
+		{IRON_ORE, 0, 64, 9, 20, 11000},
+		{COPPER_ORE, 0, 96, 10, 16, 12000},
+		{GOLD_ORE, 0, 32, 9, 4, 13000},
+		{LAPIS_ORE, 0, 32, 7, 2, 14000},
+		{REDSTONE_ORE, 0, 16, 8, 8, 15000},
+		{DIAMOND_ORE, 1, 16, 8, 2, 16000},
+		{EMERALD_ORE, 4, 32, 3, 2, 17000},
+	};
+
+	uint32_t treeHash(int worldX, int worldZ, int seed)
+	{
+		uint32_t h = (static_cast<uint32_t>(worldX) * 374761393u +
+					  static_cast<uint32_t>(worldZ) * 668265263u) ^
+					 static_cast<uint32_t>(seed);
+		h ^= h >> 16;
+		h *= 0x45d9f3bu;
+		h ^= h >> 16;
+		return h;
+	}
+
+	int voxelIndex(int x, int y, int z)
+	{
+		return y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x;
+	}
+
+	void referenceOres(std::vector<Voxel> &voxels, int chunkX, int chunkZ, int seed)
+	{
+		for (const auto &ore : ORES)
+		{
+			int minY = std::max(0, ore.minHeight);
+			int maxY = std::min(CHUNK_HEIGHT, ore.maxHeight);
+			if (minY >= maxY)
+				continue;
+
+			for (int i = 0; i < ore.clustersPerChunk; ++i)
+			{
+				uint32_t h1 = treeHash(chunkX, chunkZ, seed + ore.seedOffset + i);
+				int x = h1 % CHUNK_SIZE;
+				int z = (h1 >> 8) % CHUNK_SIZE;
+				int y = minY + ((h1 >> 16) % (maxY - minY));
+				for (int step = 0; step < ore.clusterSize; ++step)
+				{
+					if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < CHUNK_SIZE)
+					{
+						int index = voxelIndex(x, y, z);
+						if (voxels[index].type == STONE)
+							voxels[index].type = ore.type;
+					}
+
+					uint32_t stepHash = treeHash(chunkX * CHUNK_SIZE + x, chunkZ * CHUNK_SIZE + z, seed + step * 7919 + y * 1337);
+					int dir = stepHash % 6;
+					if (dir == 0) x++;
+					else if (dir == 1) x--;
+					else if (dir == 2) y++;
+					else if (dir == 3) y--;
+					else if (dir == 4) z++;
+					else if (dir == 5) z--;
+				}
+			}
+		}
+	}
+
+	bool isOre(uint8_t type)
+	{
+		for (const auto &ore : ORES)
+			if (ore.type == type)
+				return true;
+		return false;
+	}
+}
+
+int main()
+{
+	TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+
+	// Voxel counts indexed by Voxel::type
+	std::array<long, 256> actual{};
+	std::array<long, 256> expected{};
+
+	for (int cz = 0; cz < GRID; ++cz)
+	{
+		for (int cx = 0; cx < GRID; ++cx)
+		{
+			const int chunkX = (cx - GRID / 2) * CHUNK_SIZE;
+			const int chunkZ = (cz - GRID / 2) * CHUNK_SIZE;
+			ChunkData data = generator.generateTerrain(chunkX, chunkZ);
+
+			std::vector<Voxel> reference = data.voxels;
+			for (Voxel &voxel : reference)
+			{
+				++actual[voxel.type];
+				if (isOre(voxel.type))
+					voxel.type = STONE;
+			}
+			referenceOres(reference, chunkX, chunkZ, SEED);
+			for (const Voxel &voxel : reference)
+				++expected[voxel.type];
+		}
+	}
+
+	bool ok = true;
+	for (const auto &ore : ORES)
+	{
+		const long want = expected[ore.type];
+		const long got = actual[ore.type];
+		const double tolerance = want < RARE_BELOW ? RARE_TOLERANCE : COMMON_TOLERANCE;
+		const double diff = want > 0 ? std::abs(static_cast<double>(got - want)) / static_cast<double>(want) : (got > 0 ? 1.0 : 0.0);
+		const bool pass = diff <= tolerance;
+		std::cout << "[TEST] " << textureTypeString.at(ore.type) << ": " << got << " voxels, random walk " << want
+				  << " (" << diff * 100.0 << "%, max " << tolerance * 100.0 << "%)" << (pass ? "" : "  FAILED") << '\n';
+		ok &= pass;
+	}
+
+	if (!ok)
+	{
+		std::cerr << "[TEST] Ore statistics differ from the random-walk reference\n";
+		return 1;
+	}
+	std::cout << "[TEST] Ore statistics match the random-walk reference\n";
+	return 0;
+}
@@ -0,0 +1,180 @@
+// Structure checks.
+//
+// 1. StructureTemplate: overlapping set() calls keep the last one, and the
+//    compiled spans hold every voxel exactly once.
+// 2. Placement grid: with a test kind of structure registered, every
+//    structure the grid finds is stamped in full, in each chunk it crosses,
+//    although no chunk sees the whole of it. The world itself has no grid
+//    kinds yet, so it places none.
+
+#include <Chunk/TerrainGenerator.hpp>
+#include "TestSuite.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	constexpr int CELL_RANGE = 8;		  // Cells [-CELL_RANGE, CELL_RANGE) on both axes
+	constexpr int CHECKED_STRUCTURES = 6; // Structures generated and compared voxel by voxel
+
+	bool testTemplate()
+	{
+		StructureTemplate shape;
+		std::map<std::tuple<int, int, int>, TextureType> expected;
+		auto set = [&](int x, int y, int z, TextureType type)
+		{
+			shape.set(x, y, z, type);
+			expected[{y, z, x}] = type;
+		};
+
+		for (int x = -3; x <= 3; ++x)
+			set(x, 0, 0, STONE);
+		set(0, 0, 0, AIR); // Splits the row
+		for (int y = -2; y < 5; ++y)
+			set(1, y, -1, OAK_LOG);
+		set(1, 2, -1, OAK_LEAVES);
+		shape.compile();
+
+		bool ok = shape.voxelCount() == expected.size();
+		ok &= shape.min() == glm::ivec3(-3, -2, -1) && shape.max() == glm::ivec3(3, 4, 0);
+		for (const StructureSpan &span : shape.spans())
+		{
+			for (int i = 0; i < span.length; ++i)
+			{
+				auto it = expected.find({span.y, span.z, span.x + i});
+				ok &= it != expected.end() && it->second == span.type;
+			}
+		}
+
+		std::cout << "[TEST] StructureTemplate: " << expected.size() << " voxels in " << shape.spans().size() << " spans\n";
+		return expect(ok, "compiled spans differ from the voxels set");
+	}
+
+	// Walls of stone bricks around a floor, `side` blocks wide
+	StructureTemplate makeHut(int side)
+	{
+		StructureTemplate shape;
+		for (int z = 0; z < side; ++z)
+		{
+			for (int x = 0; x < side; ++x)
+			{
+				shape.set(x, -1, z, STONE_BRICKS);
+				const bool wall = x == 0 || z == 0 || x == side - 1 || z == side - 1;
+				for (int y = 0; y < 3; ++y)
+					shape.set(x, y, z, wall ? STONE_BRICKS : AIR);
+			}
+		}
+		shape.compile();
+		return shape;
+	}
+
+	int floorDiv(int a, int b)
+	{
+		return a >= 0 ? a / b : -((-a + b - 1) / b);
+	}
+
+	// Voxels of the placement that do not hold the template's type in the
+	// chunks generated around it
+	int stampMismatches(TerrainGenerator &generator, const StructurePlacement &placement)
+	{
+		const glm::ivec3 lo = glm::ivec3(placement.x, placement.y, placement.z) + placement.shape->min();
+		const glm::ivec3 hi = glm::ivec3(placement.x, placement.y, placement.z) + placement.shape->max();
+
+		std::map<std::pair<int, int>, ChunkData> chunks;
+		for (int cz = floorDiv(lo.z, CHUNK_SIZE); cz <= floorDiv(hi.z, CHUNK_SIZE); ++cz)
+			for (int cx = floorDiv(lo.x, CHUNK_SIZE); cx <= floorDiv(hi.x, CHUNK_SIZE); ++cx)
+				chunks.emplace(std::make_pair(cx, cz), generator.generateChunk(cx * CHUNK_SIZE, cz * CHUNK_SIZE));
+
+		int mismatches = 0;
+		for (const StructureSpan &span : placement.shape->spans())
+		{
+			for (int i = 0; i < span.length; ++i)
+			{
+				const int x = placement.x + span.x + i;
+				const int y = placement.y + span.y;
+				const int z = placement.z + span.z;
+				if (y < 0 || y >= CHUNK_HEIGHT)
+					continue;
+				const ChunkData &data = chunks.at({floorDiv(x, CHUNK_SIZE), floorDiv(z, CHUNK_SIZE)});
+				const int localX = x - floorDiv(x, CHUNK_SIZE) * CHUNK_SIZE;
+				const int localZ = z - floorDiv(z, CHUNK_SIZE) * CHUNK_SIZE;
+				mismatches += data.voxels[y * CHUNK_SIZE * CHUNK_SIZE + localZ * CHUNK_SIZE + localX].type != span.type;
+			}
+		}
+		return mismatches;
+	}
+
+	bool testGrid()
+	{
+		std::vector<StructurePlacement> cell;
+		TerrainGenerator::getThreadLocal(SEED).findStructures(0, 0, cell);
+		bool ok = expect(cell.empty(), "the world places grid structures");
+
+		std::vector<TerrainGenerator::GridStructureKind> kinds(1);
+		kinds[0].variants.push_back(makeHut(5));
+		kinds[0].variants.push_back(makeHut(9));
+		kinds[0].chance = 0.5f;
+		kinds[0].maxSlope = 4;
+		kinds[0].allowed = [](BiomeType) { return true; };
+		TerrainGenerator generator(SEED);
+		generator.setGridStructures(kinds);
+
+		std::vector<StructurePlacement> found;
+		int crossing = 0;
+		for (int cellZ = -CELL_RANGE; cellZ < CELL_RANGE; ++cellZ)
+		{
+			for (int cellX = -CELL_RANGE; cellX < CELL_RANGE; ++cellX)
+			{
+				generator.findStructures(cellX, cellZ, cell);
+				for (const StructurePlacement &placement : cell)
+				{
+					const int x0 = placement.x + placement.shape->min().x;
+					const int z0 = placement.z + placement.shape->min().z;
+					const bool crosses = floorDiv(x0, CHUNK_SIZE) != floorDiv(placement.x + placement.shape->max().x, CHUNK_SIZE) ||
+										 floorDiv(z0, CHUNK_SIZE) != floorDiv(placement.z + placement.shape->max().z, CHUNK_SIZE);
+					crossing += crosses;
+					// Structures crossing chunk edges first: those are the ones that can break
+					if (crosses)
+						found.insert(found.begin(), placement);
+					else
+						found.push_back(placement);
+
+					// Never outside the cell
+					if (floorDiv(x0, TerrainGenerator::STRUCTURE_CELL) != cellX ||
+						floorDiv(z0, TerrainGenerator::STRUCTURE_CELL) != cellZ ||
+						floorDiv(placement.x + placement.shape->max().x, TerrainGenerator::STRUCTURE_CELL) != cellX ||
+						floorDiv(placement.z + placement.shape->max().z, TerrainGenerator::STRUCTURE_CELL) != cellZ)
+					{
+						std::cerr << "[TEST] FAILED: structure of cell " << cellX << ',' << cellZ << " leaves its cell\n";
+						return false;
+					}
+				}
+			}
+		}
+
+		std::cout << "[TEST] Placement grid: " << found.size() << " structures in " << 4 * CELL_RANGE * CELL_RANGE
+				  << " cells, " << crossing << " across chunk edges\n";
+		if (found.empty())
+		{
+			std::cerr << "[TEST] FAILED: no structure placed\n";
+			return false;
+		}
+
+		int mismatches = 0;
+		const size_t checked = std::min<size_t>(found.size(), CHECKED_STRUCTURES);
+		for (size_t i = 0; i < checked; ++i)
+			mismatches += stampMismatches(generator, found[i]);
+
+		std::cout << "[TEST] " << checked << " structures generated: " << mismatches << " voxels differ from their template\n";
+		return expect(mismatches == 0, "structures are not stamped in full") && ok;
+	}
+}
+
+int main()
+{
+	return runChecks("Structure", {testTemplate, testGrid});
+}
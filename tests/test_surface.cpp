@@ -0,0 +1,102 @@
+// Checks TerrainGenerator::generateSurface() against the voxels generateTerrain()
+// makes for the same chunks.
+//
+// Surface-only chunks are drawn with the LOD mesh, so each column top must be
+// the topmost non-air voxel of the undecorated chunk. The 3D noise (caves
+// breaking through, overhangs, mountain surface noise) is not sampled by
+// generateSurface(), so a small share of columns may differ; the rest must
+// match in height and block type. The time per chunk of both is reported too.
+
+#include <Chunk/TerrainGenerator.hpp>
+#include "TestSuite.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+	constexpr int GRID = 16;					  // GRID x GRID chunks
+	constexpr double MIN_MATCHING_COLUMNS = 0.95; // Share of columns that must match exactly
+
+	using Clock = std::chrono::steady_clock;
+
+	double elapsedMs(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+}
+
+int main()
+{
+	TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+
+	long columns = 0;
+	long matching = 0;
+	long colourMismatches = 0;
+	double terrainMs = 0.0;
+	double surfaceMs = 0.0;
+
+	for (int cz = 0; cz < GRID; ++cz)
+	{
+		for (int cx = 0; cx < GRID; ++cx)
+		{
+			const int chunkX = (cx - GRID / 2) * CHUNK_SIZE;
+			const int chunkZ = (cz - GRID / 2) * CHUNK_SIZE;
+
+			Clock::time_point start = Clock::now();
+			const ChunkData data = generator.generateTerrain(chunkX, chunkZ);
+			terrainMs += elapsedMs(start);
+
+			start = Clock::now();
+			const SurfaceData surface = generator.generateSurface(chunkX, chunkZ);
+			surfaceMs += elapsedMs(start);
+
+			colourMismatches += surface.colors != data.colors;
+
+			for (int z = 0; z < CHUNK_SIZE; ++z)
+			{
+				for (int x = 0; x < CHUNK_SIZE; ++x)
+				{
+					int topY = -1;
+					uint8_t topType = AIR;
+					for (int y = CHUNK_HEIGHT - 1; y >= 0; --y)
+					{
+						const uint8_t type = data.voxels[y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x].type;
+						if (type != AIR)
+						{
+							topY = y;
+							topType = type;
+							break;
+						}
+					}
+
+					const int column = z * CHUNK_SIZE + x;
+					++columns;
+					matching += surface.topY[column] == topY && surface.topType[column] == topType;
+				}
+			}
+		}
+	}
+
+	const double share = static_cast<double>(matching) / static_cast<double>(columns);
+	std::cout << "[TEST] Column tops: " << matching << '/' << columns << " match (" << share * 100.0
+			  << "%, min " << MIN_MATCHING_COLUMNS * 100.0 << "%)\n";
+	std::cout << "[TEST] generateTerrain " << terrainMs / (GRID * GRID) << " ms/chunk, generateSurface "
+			  << surfaceMs / (GRID * GRID) << " ms/chunk\n";
+
+	bool ok = true;
+	if (share < MIN_MATCHING_COLUMNS)
+	{
+		std::cerr << "[TEST] FAILED: surface tops differ from the generated voxels\n";
+		ok = false;
+	}
+	if (colourMismatches != 0)
+	{
+		std::cerr << "[TEST] FAILED: " << colourMismatches << " chunks with different biome colours\n";
+		ok = false;
+	}
+	if (!ok)
+		return 1;
+	std::cout << "[TEST] Surface checks passed\n";
+	return 0;
+}
@@ -0,0 +1,290 @@
+// Golden regression test for terrain output.
+//
+// Generates a fixed set of chunks for several seeds and compares them against
+// checked-in values: one FNV-1a hash per layer (voxels, borderVoxels, biomes,
+// heightMap) plus the voxel array run-length encoded, so a failure can point at
+// the first differing voxel instead of just a hash. The same chunks are also
+// produced through generateRegion(), which has to agree with generateChunk().
+//
+// Usage: test_terrain_golden <golden file>           compare (CTest)
+//        test_terrain_golden --record <golden file>  (re)write the golden file
+//
+// Exit codes: 0 match, 1 mismatch or golden file missing, so that the test
+// never stops guarding silently. Goldens depend on FastNoise2's output, so
+// record them with the pinned FastNoise2 version (the record_terrain_golden
+// target) and only re-record for intentional terrain changes.
+
+#include <Chunk/TerrainGenerator.hpp>
+#include <Chunk/ColumnNoiseCache.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Chunk coordinates (in chunks) generated for every seed. The first four
+	// form a 2x2 block so neighbours share edge noise through ColumnNoiseCache
+	// and can be regenerated as one region.
+	constexpr int SEEDS[] = {1337, 42, -7};
+	constexpr int CHUNKS[][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {37, -85}, {-600, 420}};
+	constexpr int REGION_CHUNKS = 2;
+
+	struct ChunkRecord
+	{
+		int seed = 0;
+		int chunkX = 0;
+		int chunkZ = 0;
+		uint64_t voxelsHash = 0;
+		uint64_t borderHash = 0;
+		uint64_t biomesHash = 0;
+		uint64_t heightHash = 0;
+		std::vector<std::pair<int, int>> voxelRuns; // (type, count) in voxel index order
+	};
+
+	template <typename Container, typename Get>
+	uint64_t fnv1a(const Container &values, Get get)
+	{
+		uint64_t hash = 1469598103934665603ull;
+		for (const auto &value : values)
+		{
+			uint32_t v = static_cast<uint32_t>(get(value));
+			for (int i = 0; i < 4; ++i)
+			{
+				hash ^= (v >> (8 * i)) & 0xFF;
+				hash *= 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+
+	ChunkRecord describe(int seed, int chunkX, int chunkZ, const ChunkData &data)
+	{
+		ChunkRecord record;
+		record.seed = seed;
+		record.chunkX = chunkX;
+		record.chunkZ = chunkZ;
+		record.voxelsHash = fnv1a(data.voxels, [](const Voxel &v)
+								  { return v.type; });
+		record.borderHash = fnv1a(data.borderVoxels, [](uint8_t v)
+								  { return v; });
+		record.biomesHash = fnv1a(data.biomes, [](BiomeType b)
+								  { return b; });
+		record.heightHash = fnv1a(data.heightMap, [](int h)
+								  { return h; });
+
+		for (const Voxel &voxel : data.voxels)
+		{
+			if (!record.voxelRuns.empty() && record.voxelRuns.back().first == voxel.type)
+				++record.voxelRuns.back().second;
+			else
+				record.voxelRuns.emplace_back(voxel.type, 1);
+		}
+		return record;
+	}
+
+	std::vector<ChunkRecord> generateAll()
+	{
+		std::vector<ChunkRecord> records;
+		for (int seed : SEEDS)
+		{
+			// Start cold so cache hits do not depend on what ran before
+			ColumnNoiseCache::instance().clear();
+			TerrainGenerator &generator = TerrainGenerator::getThreadLocal(seed);
+			for (const auto &chunk : CHUNKS)
+			{
+				ChunkData data = generator.generateChunk(chunk[0] * CHUNK_SIZE, chunk[1] * CHUNK_SIZE);
+				records.push_back(describe(seed, chunk[0], chunk[1], data));
+			}
+		}
+		return records;
+	}
+
+	bool writeGolden(const std::string &path, const std::vector<ChunkRecord> &records)
+	{
+		const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+		std::error_code error;
+		if (!parent.empty())
+			std::filesystem::create_directories(parent, error);
+		std::ofstream out(path);
+		if (!out)
+			return false;
+
+		out << "# seed chunkX chunkZ voxels border biomes heightMap, then the voxel runs (type:count)\n";
+		for (const ChunkRecord &r : records)
+		{
+			out << r.seed << ' ' << r.chunkX << ' ' << r.chunkZ << std::hex
+				<< ' ' << r.voxelsHash << ' ' << r.borderHash << ' ' << r.biomesHash << ' ' << r.heightHash
+				<< std::dec << '\n';
+			for (size_t i = 0; i < r.voxelRuns.size(); ++i)
+				out << (i ? " " : "") << r.voxelRuns[i].first << ':' << r.voxelRuns[i].second;
+			out << '\n';
+		}
+		return static_cast<bool>(out);
+	}
+
+	bool readGolden(const std::string &path, std::vector<ChunkRecord> &records)
+	{
+		std::ifstream in(path);
+		if (!in)
+			return false;
+
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			ChunkRecord r;
+			std::istringstream header(line);
+			header >> r.seed >> r.chunkX >> r.chunkZ >> std::hex >> r.voxelsHash >> r.borderHash >> r.biomesHash >> r.heightHash;
+
+			if (!std::getline(in, line))
+				return false;
+			std::istringstream runs(line);
+			std::string token;
+			while (runs >> token)
+			{
+				size_t colon = token.find(':');
+				r.voxelRuns.emplace_back(std::stoi(token.substr(0, colon)), std::stoi(token.substr(colon + 1)));
+			}
+			records.push_back(std::move(r));
+		}
+		return true;
+	}
+
+	// Voxel index layout is y * CHUNK_SIZE^2 + z * CHUNK_SIZE + x (TerrainGenerator::getVoxelIndex)
+	void printFirstVoxelDifference(const ChunkRecord &expected, const ChunkRecord &actual)
+	{
+		std::vector<int> want, got;
+		for (const auto &[type, count] : expected.voxelRuns)
+			want.insert(want.end(), count, type);
+		for (const auto &[type, count] : actual.voxelRuns)
+			got.insert(got.end(), count, type);
+
+		for (size_t i = 0; i < std::min(want.size(), got.size()); ++i)
+		{
+			if (want[i] == got[i])
+				continue;
+			int x = static_cast<int>(i) % CHUNK_SIZE;
+			int z = (static_cast<int>(i) / CHUNK_SIZE) % CHUNK_SIZE;
+			int y = static_cast<int>(i) / (CHUNK_SIZE * CHUNK_SIZE);
+			std::cerr << "         first differing voxel: local (" << x << ", " << y << ", " << z << "), world ("
+					  << expected.chunkX * CHUNK_SIZE + x << ", " << y << ", " << expected.chunkZ * CHUNK_SIZE + z
+					  << "): expected type " << want[i] << ", got " << got[i] << '\n';
+			return;
+		}
+		if (want.size() != got.size())
+			std::cerr << "         voxel count differs: expected " << want.size() << ", got " << got.size() << '\n';
+	}
+
+	bool compare(const ChunkRecord &expected, const ChunkRecord &actual, const char *path)
+	{
+		bool ok = true;
+		auto check = [&](const char *layer, uint64_t want, uint64_t got)
+		{
+			if (want == got)
+				return;
+			if (ok)
+				std::cerr << "[TEST] seed " << expected.seed << " chunk (" << expected.chunkX << ", " << expected.chunkZ
+						  << ") differs (" << path << "):\n";
+			ok = false;
+			std::cerr << "         " << layer << " hash " << std::hex << got << ", expected " << want << std::dec << '\n';
+		};
+		check("voxels", expected.voxelsHash, actual.voxelsHash);
+		check("borderVoxels", expected.borderHash, actual.borderHash);
+		check("biomes", expected.biomesHash, actual.biomesHash);
+		check("heightMap", expected.heightHash, actual.heightHash);
+
+		if (expected.voxelsHash != actual.voxelsHash)
+			printFirstVoxelDifference(expected, actual);
+		return ok;
+	}
+
+	// The 2x2 block generated in one generateRegion() call must match the goldens too
+	bool checkRegions(const std::vector<ChunkRecord> &golden)
+	{
+		bool ok = true;
+		for (int seed : SEEDS)
+		{
+			ColumnNoiseCache::instance().clear();
+			TerrainGenerator &generator = TerrainGenerator::getThreadLocal(seed);
+			std::vector<ChunkData> chunks = generator.generateRegion(0, 0, REGION_CHUNKS);
+			for (int cz = 0; cz < REGION_CHUNKS; ++cz)
+			{
+				for (int cx = 0; cx < REGION_CHUNKS; ++cx)
+				{
+					ChunkRecord actual = describe(seed, cx, cz, chunks[cz * REGION_CHUNKS + cx]);
+					for (const ChunkRecord &expected : golden)
+						if (expected.seed == seed && expected.chunkX == cx && expected.chunkZ == cz)
+							ok &= compare(expected, actual, "generateRegion");
+				}
+			}
+		}
+		return ok;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const bool record = argc == 3 && std::strcmp(argv[1], "--record") == 0;
+	if (argc != 2 && !record)
+	{
+		std::cerr << "Usage: " << argv[0] << " [--record] <golden file>\n";
+		return 1;
+	}
+	const std::string path = argv[argc - 1];
+
+	std::vector<ChunkRecord> actual = generateAll();
+
+	if (record)
+	{
+		if (!writeGolden(path, actual))
+		{
+			std::cerr << "[TEST] Cannot write " << path << '\n';
+			return 1;
+		}
+		std::cout << "[TEST] Recorded " << actual.size() << " chunks to " << path << '\n';
+		return 0;
+	}
+
+	std::vector<ChunkRecord> golden;
+	if (!readGolden(path, golden) || golden.empty())
+	{
+		std::cerr << "[TEST] FAILED: no golden data at " << path
+				  << ", record it with the pinned FastNoise2 (--record, or the record_terrain_golden target)\n";
+		return 1;
+	}
+	if (golden.size() != actual.size())
+	{
+		std::cerr << "[TEST] Golden file has " << golden.size() << " chunks, expected " << actual.size()
+				  << ". Re-record it after changing the chunk set.\n";
+		return 1;
+	}
+
+	bool ok = true;
+	for (size_t i = 0; i < actual.size(); ++i)
+	{
+		if (golden[i].seed != actual[i].seed || golden[i].chunkX != actual[i].chunkX || golden[i].chunkZ != actual[i].chunkZ)
+		{
+			std::cerr << "[TEST] Golden file lists a different chunk set. Re-record it after changing the chunk set.\n";
+			return 1;
+		}
+		ok &= compare(golden[i], actual[i], "generateChunk");
+	}
+	ok &= checkRegions(golden);
+
+	if (!ok)
+	{
+		std::cerr << "[TEST] Terrain output changed. If this is intended, re-record with --record.\n";
+		return 1;
+	}
+	std::cout << "[TEST] " << actual.size() << " chunks match the golden terrain hashes\n";
+	return 0;
+}
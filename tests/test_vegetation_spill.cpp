@@ -0,0 +1,170 @@
+// Vegetation stage checks.
+//
+// 1. VoxelEditQueue: several threads push batches while one thread keeps
+//    draining; every edit has to come out exactly once.
+// 2. Spill-over: the trees of a block of chunks are stitched into their
+//    neighbours with TerrainGenerator::spillReplaces() in two opposite orders.
+//    Both must give the same voxels, since the game applies spill-over in
+//    whatever order the vegetation tasks finish. generateRegion() must produce
+//    the same spill-over as generateChunk().
+
+#include <Chunk/TerrainGenerator.hpp>
+#include <Chunk/VoxelEditQueue.hpp>
+#include "TestSuite.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int PRODUCERS = 8;
+	constexpr int BATCHES_PER_PRODUCER = 2000;
+
+	constexpr int BLOCK_CHUNKS = 4; // generateRegion() accepts up to MAX_REGION_CHUNKS
+
+	bool testQueue()
+	{
+		VoxelEditQueue queue;
+		std::atomic<int> producersDone{0};
+		std::vector<VoxelEdit> drained;
+
+		std::thread consumer([&]
+							 {
+								 while (producersDone.load() < PRODUCERS)
+									 queue.take(drained);
+								 queue.take(drained); });
+
+		std::vector<std::thread> producers;
+		for (int p = 0; p < PRODUCERS; ++p)
+		{
+			producers.emplace_back([&queue, &producersDone, p]
+								   {
+									   for (int b = 0; b < BATCHES_PER_PRODUCER; ++b)
+									   {
+										   // Batch b of producer p holds (b % 7) + 1 edits tagged with p
+										   std::vector<VoxelEdit> batch;
+										   for (int i = 0; i <= b % 7; ++i)
+											   batch.push_back({static_cast<uint8_t>(i), static_cast<uint8_t>(b & 0xFF),
+																static_cast<uint8_t>(b >> 8), static_cast<uint8_t>(p)});
+										   queue.push(std::move(batch));
+									   }
+									   producersDone.fetch_add(1); });
+		}
+		for (std::thread &t : producers)
+			t.join();
+		consumer.join();
+
+		size_t expectedPerProducer = 0;
+		for (int b = 0; b < BATCHES_PER_PRODUCER; ++b)
+			expectedPerProducer += b % 7 + 1;
+
+		std::vector<size_t> perProducer(PRODUCERS, 0);
+		for (const VoxelEdit &edit : drained)
+			++perProducer[edit.type];
+
+		bool ok = queue.empty();
+		for (int p = 0; p < PRODUCERS; ++p)
+			ok &= perProducer[p] == expectedPerProducer;
+
+		std::cout << "[TEST] VoxelEditQueue: " << drained.size() << " edits from " << PRODUCERS << " producers\n";
+		return expect(ok, "edits lost or duplicated");
+	}
+
+	// Applies the spill-over of chunk `from` to chunk `to` (both indexes into
+	// the block), the way Chunk::applyQueuedEdits() does.
+	void stitch(std::vector<ChunkData> &chunks, int from, int to)
+	{
+		const int fromX = from % BLOCK_CHUNKS, fromZ = from / BLOCK_CHUNKS;
+		const int toX = to % BLOCK_CHUNKS, toZ = to / BLOCK_CHUNKS;
+		for (const SpillVoxel &voxel : chunks[from].spill)
+		{
+			const int x = voxel.x - (toX - fromX) * CHUNK_SIZE;
+			const int z = voxel.z - (toZ - fromZ) * CHUNK_SIZE;
+			if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE)
+				continue;
+			Voxel &target = chunks[to].voxels[voxel.y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x];
+			if (TerrainGenerator::spillReplaces(target.type, voxel.type))
+				target.type = voxel.type;
+		}
+	}
+
+	bool testSpill()
+	{
+		TerrainGenerator &generator = TerrainGenerator::getThreadLocal(SEED);
+
+		std::vector<ChunkData> chunks;
+		size_t spilled = 0;
+		bool ok = true;
+		for (int cz = 0; cz < BLOCK_CHUNKS; ++cz)
+		{
+			for (int cx = 0; cx < BLOCK_CHUNKS; ++cx)
+			{
+				chunks.push_back(generator.generateChunk(cx * CHUNK_SIZE, cz * CHUNK_SIZE));
+				for (const SpillVoxel &voxel : chunks.back().spill)
+				{
+					const bool inside = voxel.x >= 0 && voxel.x < CHUNK_SIZE && voxel.z >= 0 && voxel.z < CHUNK_SIZE;
+					const bool inNeighbour = voxel.x >= -CHUNK_SIZE && voxel.x < 2 * CHUNK_SIZE &&
+											 voxel.z >= -CHUNK_SIZE && voxel.z < 2 * CHUNK_SIZE;
+					if (inside || !inNeighbour)
+					{
+						std::cerr << "[TEST] FAILED: spill voxel at (" << int(voxel.x) << ", " << int(voxel.z)
+								  << ") is not in a neighbouring chunk\n";
+						return false;
+					}
+				}
+				spilled += chunks.back().spill.size();
+			}
+		}
+
+		std::vector<ChunkData> region = generator.generateRegion(0, 0, BLOCK_CHUNKS);
+		for (size_t i = 0; i < chunks.size(); ++i)
+		{
+			const std::vector<SpillVoxel> &a = chunks[i].spill;
+			const std::vector<SpillVoxel> &b = region[i].spill;
+			bool same = a.size() == b.size();
+			for (size_t j = 0; same && j < a.size(); ++j)
+				same = a[j].x == b[j].x && a[j].y == b[j].y && a[j].z == b[j].z && a[j].type == b[j].type;
+			if (!same)
+			{
+				std::cerr << "[TEST] FAILED: generateRegion() spill-over differs for chunk " << i << '\n';
+				ok = false;
+			}
+		}
+
+		const int count = BLOCK_CHUNKS * BLOCK_CHUNKS;
+		std::vector<ChunkData> forward = chunks;
+		std::vector<ChunkData> backward = chunks;
+		for (int from = 0; from < count; ++from)
+			for (int to = 0; to < count; ++to)
+				if (from != to)
+					stitch(forward, from, to);
+		for (int from = count - 1; from >= 0; --from)
+			for (int to = count - 1; to >= 0; --to)
+				if (from != to)
+					stitch(backward, from, to);
+
+		for (int i = 0; i < count; ++i)
+		{
+			for (size_t v = 0; v < forward[i].voxels.size(); ++v)
+			{
+				if (forward[i].voxels[v].type != backward[i].voxels[v].type)
+				{
+					std::cerr << "[TEST] FAILED: chunk " << i << " voxel " << v << " depends on the stitching order\n";
+					ok = false;
+					break;
+				}
+			}
+		}
+
+		std::cout << "[TEST] Spill-over: " << spilled << " voxels across " << count << " chunks\n";
+		return ok;
+	}
+}
+
+int main()
+{
+	return runChecks("Vegetation stage", {testQueue, testSpill});
+}